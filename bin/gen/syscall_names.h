@@ -0,0 +1,1516 @@
+/*! \file syscall_names.h
+    \brief Syscall numbers, names and argument counts of x86_64 and i386, generated by gensyscalls.awk. Do not edit
+*/
+
+#ifndef INC_SYSCALL_NAMES	//Lock to prevent recursive inclusions
+#define INC_SYSCALL_NAMES
+
+#ifdef __x86_64__
+	#define SYSCALL_NR_read	0
+	#define SYSCALL_NR_write	1
+	#define SYSCALL_NR_open	2
+	#define SYSCALL_NR_close	3
+	#define SYSCALL_NR_stat	4
+	#define SYSCALL_NR_fstat	5
+	#define SYSCALL_NR_lstat	6
+	#define SYSCALL_NR_poll	7
+	#define SYSCALL_NR_lseek	8
+	#define SYSCALL_NR_mmap	9
+	#define SYSCALL_NR_mprotect	10
+	#define SYSCALL_NR_munmap	11
+	#define SYSCALL_NR_brk	12
+	#define SYSCALL_NR_rt_sigaction	13
+	#define SYSCALL_NR_rt_sigprocmask	14
+	#define SYSCALL_NR_rt_sigreturn	15
+	#define SYSCALL_NR_ioctl	16
+	#define SYSCALL_NR_pread	17
+	#define SYSCALL_NR_pwrite	18
+	#define SYSCALL_NR_readv	19
+	#define SYSCALL_NR_writev	20
+	#define SYSCALL_NR_access	21
+	#define SYSCALL_NR_pipe	22
+	#define SYSCALL_NR_select	23
+	#define SYSCALL_NR_sched_yield	24
+	#define SYSCALL_NR_mremap	25
+	#define SYSCALL_NR_msync	26
+	#define SYSCALL_NR_mincore	27
+	#define SYSCALL_NR_madvise	28
+	#define SYSCALL_NR_shmget	29
+	#define SYSCALL_NR_shmat	30
+	#define SYSCALL_NR_shmctl	31
+	#define SYSCALL_NR_dup	32
+	#define SYSCALL_NR_dup2	33
+	#define SYSCALL_NR_pause	34
+	#define SYSCALL_NR_nanosleep	35
+	#define SYSCALL_NR_getitimer	36
+	#define SYSCALL_NR_alarm	37
+	#define SYSCALL_NR_setitimer	38
+	#define SYSCALL_NR_getpid	39
+	#define SYSCALL_NR_sendfile	40
+	#define SYSCALL_NR_socket	41
+	#define SYSCALL_NR_connect	42
+	#define SYSCALL_NR_accept	43
+	#define SYSCALL_NR_sendto	44
+	#define SYSCALL_NR_recvfrom	45
+	#define SYSCALL_NR_sendmsg	46
+	#define SYSCALL_NR_recvmsg	47
+	#define SYSCALL_NR_shutdown	48
+	#define SYSCALL_NR_bind	49
+	#define SYSCALL_NR_listen	50
+	#define SYSCALL_NR_getsockname	51
+	#define SYSCALL_NR_getpeername	52
+	#define SYSCALL_NR_socketpair	53
+	#define SYSCALL_NR_setsockopt	54
+	#define SYSCALL_NR_getsockopt	55
+	#define SYSCALL_NR_clone	56
+	#define SYSCALL_NR_fork	57
+	#define SYSCALL_NR_vfork	58
+	#define SYSCALL_NR_execve	59
+	#define SYSCALL_NR__exit	60
+	#define SYSCALL_NR_wait4	61
+	#define SYSCALL_NR_kill	62
+	#define SYSCALL_NR_uname	63
+	#define SYSCALL_NR_semget	64
+	#define SYSCALL_NR_semop	65
+	#define SYSCALL_NR_semctl	66
+	#define SYSCALL_NR_shmdt	67
+	#define SYSCALL_NR_msgget	68
+	#define SYSCALL_NR_msgsnd	69
+	#define SYSCALL_NR_msgrcv	70
+	#define SYSCALL_NR_msgctl	71
+	#define SYSCALL_NR_fcntl	72
+	#define SYSCALL_NR_flock	73
+	#define SYSCALL_NR_fsync	74
+	#define SYSCALL_NR_fdatasync	75
+	#define SYSCALL_NR_truncate	76
+	#define SYSCALL_NR_ftruncate	77
+	#define SYSCALL_NR_getdents	78
+	#define SYSCALL_NR_getcwd	79
+	#define SYSCALL_NR_chdir	80
+	#define SYSCALL_NR_fchdir	81
+	#define SYSCALL_NR_rename	82
+	#define SYSCALL_NR_mkdir	83
+	#define SYSCALL_NR_rmdir	84
+	#define SYSCALL_NR_creat	85
+	#define SYSCALL_NR_link	86
+	#define SYSCALL_NR_unlink	87
+	#define SYSCALL_NR_symlink	88
+	#define SYSCALL_NR_readlink	89
+	#define SYSCALL_NR_chmod	90
+	#define SYSCALL_NR_fchmod	91
+	#define SYSCALL_NR_chown	92
+	#define SYSCALL_NR_fchown	93
+	#define SYSCALL_NR_lchown	94
+	#define SYSCALL_NR_umask	95
+	#define SYSCALL_NR_gettimeofday	96
+	#define SYSCALL_NR_getrlimit	97
+	#define SYSCALL_NR_getrusage	98
+	#define SYSCALL_NR_sysinfo	99
+	#define SYSCALL_NR_times	100
+	#define SYSCALL_NR_ptrace	101
+	#define SYSCALL_NR_getuid	102
+	#define SYSCALL_NR_syslog	103
+	#define SYSCALL_NR_getgid	104
+	#define SYSCALL_NR_setuid	105
+	#define SYSCALL_NR_setgid	106
+	#define SYSCALL_NR_geteuid	107
+	#define SYSCALL_NR_getegid	108
+	#define SYSCALL_NR_setpgid	109
+	#define SYSCALL_NR_getppid	110
+	#define SYSCALL_NR_getpgrp	111
+	#define SYSCALL_NR_setsid	112
+	#define SYSCALL_NR_setreuid	113
+	#define SYSCALL_NR_setregid	114
+	#define SYSCALL_NR_getgroups	115
+	#define SYSCALL_NR_setgroups	116
+	#define SYSCALL_NR_setresuid	117
+	#define SYSCALL_NR_getresuid	118
+	#define SYSCALL_NR_setresgid	119
+	#define SYSCALL_NR_getresgid	120
+	#define SYSCALL_NR_getpgid	121
+	#define SYSCALL_NR_setfsuid	122
+	#define SYSCALL_NR_setfsgid	123
+	#define SYSCALL_NR_getsid	124
+	#define SYSCALL_NR_capget	125
+	#define SYSCALL_NR_capset	126
+	#define SYSCALL_NR_rt_sigpending	127
+	#define SYSCALL_NR_rt_sigtimedwait	128
+	#define SYSCALL_NR_rt_sigqueueinfo	129
+	#define SYSCALL_NR_rt_sigsuspend	130
+	#define SYSCALL_NR_sigaltstack	131
+	#define SYSCALL_NR_utime	132
+	#define SYSCALL_NR_mknod	133
+	#define SYSCALL_NR_uselib	134
+	#define SYSCALL_NR_personality	135
+	#define SYSCALL_NR_ustat	136
+	#define SYSCALL_NR_statfs	137
+	#define SYSCALL_NR_fstatfs	138
+	#define SYSCALL_NR_sysfs	139
+	#define SYSCALL_NR_getpriority	140
+	#define SYSCALL_NR_setpriority	141
+	#define SYSCALL_NR_sched_setparam	142
+	#define SYSCALL_NR_sched_getparam	143
+	#define SYSCALL_NR_sched_setscheduler	144
+	#define SYSCALL_NR_sched_getscheduler	145
+	#define SYSCALL_NR_sched_get_priority_max	146
+	#define SYSCALL_NR_sched_get_priority_min	147
+	#define SYSCALL_NR_sched_rr_get_interval	148
+	#define SYSCALL_NR_mlock	149
+	#define SYSCALL_NR_munlock	150
+	#define SYSCALL_NR_mlockall	151
+	#define SYSCALL_NR_munlockall	152
+	#define SYSCALL_NR_vhangup	153
+	#define SYSCALL_NR_modify_ldt	154
+	#define SYSCALL_NR_pivot_root	155
+	#define SYSCALL_NR__sysctl	156
+	#define SYSCALL_NR_prctl	157
+	#define SYSCALL_NR_arch_prctl	158
+	#define SYSCALL_NR_adjtimex	159
+	#define SYSCALL_NR_setrlimit	160
+	#define SYSCALL_NR_chroot	161
+	#define SYSCALL_NR_sync	162
+	#define SYSCALL_NR_acct	163
+	#define SYSCALL_NR_settimeofday	164
+	#define SYSCALL_NR_mount	165
+	#define SYSCALL_NR_umount2	166
+	#define SYSCALL_NR_swapon	167
+	#define SYSCALL_NR_swapoff	168
+	#define SYSCALL_NR_reboot	169
+	#define SYSCALL_NR_sethostname	170
+	#define SYSCALL_NR_setdomainname	171
+	#define SYSCALL_NR_iopl	172
+	#define SYSCALL_NR_ioperm	173
+	#define SYSCALL_NR_create_module	174
+	#define SYSCALL_NR_init_module	175
+	#define SYSCALL_NR_delete_module	176
+	#define SYSCALL_NR_get_kernel_syms	177
+	#define SYSCALL_NR_query_module	178
+	#define SYSCALL_NR_quotactl	179
+	#define SYSCALL_NR_nfsservctl	180
+	#define SYSCALL_NR_getpmsg	181
+	#define SYSCALL_NR_putpmsg	182
+	#define SYSCALL_NR_afs_syscall	183
+	#define SYSCALL_NR_tuxcall	184
+	#define SYSCALL_NR_security	185
+	#define SYSCALL_NR_gettid	186
+	#define SYSCALL_NR_readahead	187
+	#define SYSCALL_NR_setxattr	188
+	#define SYSCALL_NR_lsetxattr	189
+	#define SYSCALL_NR_fsetxattr	190
+	#define SYSCALL_NR_getxattr	191
+	#define SYSCALL_NR_lgetxattr	192
+	#define SYSCALL_NR_fgetxattr	193
+	#define SYSCALL_NR_listxattr	194
+	#define SYSCALL_NR_llistxattr	195
+	#define SYSCALL_NR_flistxattr	196
+	#define SYSCALL_NR_removexattr	197
+	#define SYSCALL_NR_lremovexattr	198
+	#define SYSCALL_NR_fremovexattr	199
+	#define SYSCALL_NR_tkill	200
+	#define SYSCALL_NR_time	201
+	#define SYSCALL_NR_futex	202
+	#define SYSCALL_NR_sched_setaffinity	203
+	#define SYSCALL_NR_sched_getaffinity	204
+	#define SYSCALL_NR_set_thread_area	205
+	#define SYSCALL_NR_io_setup	206
+	#define SYSCALL_NR_io_destroy	207
+	#define SYSCALL_NR_io_getevents	208
+	#define SYSCALL_NR_io_submit	209
+	#define SYSCALL_NR_io_cancel	210
+	#define SYSCALL_NR_get_thread_area	211
+	#define SYSCALL_NR_lookup_dcookie	212
+	#define SYSCALL_NR_epoll_create	213
+	#define SYSCALL_NR_epoll_ctl_old	214
+	#define SYSCALL_NR_epoll_wait_old	215
+	#define SYSCALL_NR_remap_file_pages	216
+	#define SYSCALL_NR_getdents64	217
+	#define SYSCALL_NR_set_tid_address	218
+	#define SYSCALL_NR_restart_syscall	219
+	#define SYSCALL_NR_semtimedop	220
+	#define SYSCALL_NR_fadvise64	221
+	#define SYSCALL_NR_timer_create	222
+	#define SYSCALL_NR_timer_settime	223
+	#define SYSCALL_NR_timer_gettime	224
+	#define SYSCALL_NR_timer_getoverrun	225
+	#define SYSCALL_NR_timer_delete	226
+	#define SYSCALL_NR_clock_settime	227
+	#define SYSCALL_NR_clock_gettime	228
+	#define SYSCALL_NR_clock_getres	229
+	#define SYSCALL_NR_clock_nanosleep	230
+	#define SYSCALL_NR_exit_group	231
+	#define SYSCALL_NR_epoll_wait	232
+	#define SYSCALL_NR_epoll_ctl	233
+	#define SYSCALL_NR_tgkill	234
+	#define SYSCALL_NR_utimes	235
+	#define SYSCALL_NR_vserver	236
+	#define SYSCALL_NR_mbind	237
+	#define SYSCALL_NR_set_mempolicy	238
+	#define SYSCALL_NR_get_mempolicy	239
+	#define SYSCALL_NR_mq_open	240
+	#define SYSCALL_NR_mq_unlink	241
+	#define SYSCALL_NR_mq_timedsend	242
+	#define SYSCALL_NR_mq_timedreceive	243
+	#define SYSCALL_NR_mq_notify	244
+	#define SYSCALL_NR_mq_getsetattr	245
+	#define SYSCALL_NR_kexec_load	246
+	#define SYSCALL_NR_waitid	247
+	#define SYSCALL_NR_add_key	248
+	#define SYSCALL_NR_request_key	249
+	#define SYSCALL_NR_keyctl	250
+	#define SYSCALL_NR_ioprio_set	251
+	#define SYSCALL_NR_ioprio_get	252
+	#define SYSCALL_NR_inotify_init	253
+	#define SYSCALL_NR_inotify_add_watch	254
+	#define SYSCALL_NR_inotify_rm_watch	255
+	#define SYSCALL_NR_migrate_pages	256
+	#define SYSCALL_NR_openat	257
+	#define SYSCALL_NR_mkdirat	258
+	#define SYSCALL_NR_mknodat	259
+	#define SYSCALL_NR_fchownat	260
+	#define SYSCALL_NR_futimesat	261
+	#define SYSCALL_NR_newfstatat	262
+	#define SYSCALL_NR_unlinkat	263
+	#define SYSCALL_NR_renameat	264
+	#define SYSCALL_NR_linkat	265
+	#define SYSCALL_NR_symlinkat	266
+	#define SYSCALL_NR_readlinkat	267
+	#define SYSCALL_NR_fchmodat	268
+	#define SYSCALL_NR_faccessat	269
+	#define SYSCALL_NR_pselect6	270
+	#define SYSCALL_NR_ppoll	271
+	#define SYSCALL_NR_unshare	272
+	#define SYSCALL_NR_set_robust_list	273
+	#define SYSCALL_NR_get_robust_list	274
+	#define SYSCALL_NR_splice	275
+	#define SYSCALL_NR_tee	276
+	#define SYSCALL_NR_sync_file_range	277
+	#define SYSCALL_NR_vmsplice	278
+	#define SYSCALL_NR_move_pages	279
+	#define SYSCALL_NR_utimensat	280
+	#define SYSCALL_NR_epoll_pwait	281
+	#define SYSCALL_NR_signalfd	282
+	#define SYSCALL_NR_timerfd_create	283
+	#define SYSCALL_NR_eventfd	284
+	#define SYSCALL_NR_fallocate	285
+	#define SYSCALL_NR_timerfd_settime	286
+	#define SYSCALL_NR_timerfd_gettime	287
+	#define SYSCALL_NR_accept4	288
+	#define SYSCALL_NR_signalfd4	289
+	#define SYSCALL_NR_eventfd2	290
+	#define SYSCALL_NR_epoll_create1	291
+	#define SYSCALL_NR_dup3	292
+	#define SYSCALL_NR_pipe2	293
+	#define SYSCALL_NR_inotify_init1	294
+	#define SYSCALL_NR_preadv	295
+	#define SYSCALL_NR_pwritev	296
+	#define SYSCALL_NR_rt_tgsigqueueinfo	297
+	#define SYSCALL_NR_perf_event_open	298
+	#define SYSCALL_NR_recvmmsg	299
+	#define SYSCALL_NR_fanotify_init	300
+	#define SYSCALL_NR_fanotify_mark	301
+	#define SYSCALL_NR_prlimit64	302
+	#define SYSCALL_NR_name_to_handle_at	303
+	#define SYSCALL_NR_open_by_handle_at	304
+	#define SYSCALL_NR_clock_adjtime	305
+	#define SYSCALL_NR_syncfs	306
+	#define SYSCALL_NR_sendmmsg	307
+	#define SYSCALL_NR_setns	308
+	#define SYSCALL_NR_getcpu	309
+	#define SYSCALL_NR_process_vm_readv	310
+	#define SYSCALL_NR_process_vm_writev	311
+	#define SYSCALL_NR_kcmp	312
+	#define SYSCALL_NR_finit_module	313
+	#define SYSCALL_NR_sched_setattr	314
+	#define SYSCALL_NR_sched_getattr	315
+	#define SYSCALL_NR_renameat2	316
+	#define SYSCALL_NR_seccomp	317
+	#define SYSCALL_NR_getrandom	318
+	#define SYSCALL_NR_memfd_create	319
+	#define SYSCALL_NR_kexec_file_load	320
+	#define SYSCALL_NR_bpf	321
+	#define SYSCALL_NR_execveat	322
+	#define SYSCALL_NR_userfaultfd	323
+	#define SYSCALL_NR_membarrier	324
+	#define SYSCALL_NR_mlock2	325
+	#define SYSCALL_NR_copy_file_range	326
+	#define SYSCALL_NR_preadv2	327
+	#define SYSCALL_NR_pwritev2	328
+	#define SYSCALL_NR_pkey_mprotect	329
+	#define SYSCALL_NR_pkey_alloc	330
+	#define SYSCALL_NR_pkey_free	331
+	#define SYSCALL_NR_statx	332
+	#define SYSCALL_NR_io_pgetevents	333
+	#define SYSCALL_NR_rseq	334
+	#define SYSCALL_NR_pidfd_send_signal	424
+	#define SYSCALL_NR_io_uring_setup	425
+	#define SYSCALL_NR_io_uring_enter	426
+	#define SYSCALL_NR_io_uring_register	427
+	#define SYSCALL_NR_open_tree	428
+	#define SYSCALL_NR_move_mount	429
+	#define SYSCALL_NR_fsopen	430
+	#define SYSCALL_NR_fsconfig	431
+	#define SYSCALL_NR_fsmount	432
+	#define SYSCALL_NR_fspick	433
+	#define SYSCALL_NR_pidfd_open	434
+	#define SYSCALL_NR_clone3	435
+	#define SYSCALL_NR_close_range	436
+	#define SYSCALL_NR_openat2	437
+	#define SYSCALL_NR_pidfd_getfd	438
+	#define SYSCALL_NR_faccessat2	439
+	#define SYSCALL_NR_process_madvise	440
+	#define SYSCALL_NR_epoll_pwait2	441
+	#define SYSCALL_NR_mount_setattr	442
+	#define SYSCALL_NR_quotactl_fd	443
+	#define SYSCALL_NR_landlock_create_ruleset	444
+	#define SYSCALL_NR_landlock_add_rule	445
+	#define SYSCALL_NR_landlock_restrict_self	446
+	#define SYSCALL_NR_memfd_secret	447
+	#define SYSCALL_NR_process_mrelease	448
+	#define SYSCALL_NR_futex_waitv	449
+	#define SYSCALL_NR_set_mempolicy_home_node	450
+	#define SYSCALL_NR_cachestat	451
+	#define SYSCALL_NR_fchmodat2	452
+	#define SYSCALL_NR_map_shadow_stack	453
+	#define SYSCALL_NR_futex_wake	454
+	#define SYSCALL_NR_futex_wait	455
+	#define SYSCALL_NR_futex_requeue	456
+	#define SYSCALL_NR_statmount	457
+	#define SYSCALL_NR_listmount	458
+	#define SYSCALL_NR_lsm_get_self_attr	459
+	#define SYSCALL_NR_lsm_set_self_attr	460
+	#define SYSCALL_NR_lsm_list_modules	461
+	#define SYSCALL_NR_mseal	462
+
+	/** Highest syscall number of the architecture, plus 1 */
+	#define SYSCALL_TABLE_LEN	463
+
+	/** Initializer of syscall_info[SYSCALL_TABLE_LEN], indexed by syscall number */
+	#define SYSCALL_TABLE_INIT \
+		[0] = {3, SYSCALL_TD, "read"}, \
+		[1] = {3, SYSCALL_TD, "write"}, \
+		[2] = {3, SYSCALL_TD|SYSCALL_TF, "open"}, \
+		[3] = {1, SYSCALL_TD, "close"}, \
+		[4] = {2, SYSCALL_TF, "stat"}, \
+		[5] = {2, SYSCALL_TD, "fstat"}, \
+		[6] = {2, SYSCALL_TF, "lstat"}, \
+		[7] = {3, SYSCALL_TD, "poll"}, \
+		[8] = {3, SYSCALL_TD, "lseek"}, \
+		[9] = {6, SYSCALL_TD|SYSCALL_TM|SYSCALL_SI, "mmap"}, \
+		[10] = {3, SYSCALL_TM|SYSCALL_SI, "mprotect"}, \
+		[11] = {2, SYSCALL_TM|SYSCALL_SI, "munmap"}, \
+		[12] = {1, SYSCALL_TM|SYSCALL_SI, "brk"}, \
+		[13] = {4, SYSCALL_TS, "rt_sigaction"}, \
+		[14] = {4, SYSCALL_TS, "rt_sigprocmask"}, \
+		[15] = {0, SYSCALL_TS, "rt_sigreturn"}, \
+		[16] = {3, SYSCALL_TD, "ioctl"}, \
+		[17] = {4, SYSCALL_TD, "pread"}, \
+		[18] = {4, SYSCALL_TD, "pwrite"}, \
+		[19] = {3, SYSCALL_TD, "readv"}, \
+		[20] = {3, SYSCALL_TD, "writev"}, \
+		[21] = {2, SYSCALL_TF, "access"}, \
+		[22] = {1, SYSCALL_TD, "pipe"}, \
+		[23] = {5, SYSCALL_TD, "select"}, \
+		[24] = {0, 0, "sched_yield"}, \
+		[25] = {5, SYSCALL_TM|SYSCALL_SI, "mremap"}, \
+		[26] = {3, SYSCALL_TM, "msync"}, \
+		[27] = {3, SYSCALL_TM, "mincore"}, \
+		[28] = {3, SYSCALL_TM, "madvise"}, \
+		[29] = {3, SYSCALL_TI, "shmget"}, \
+		[30] = {3, SYSCALL_TI|SYSCALL_TM|SYSCALL_SI, "shmat"}, \
+		[31] = {3, SYSCALL_TI, "shmctl"}, \
+		[32] = {1, SYSCALL_TD, "dup"}, \
+		[33] = {2, SYSCALL_TD, "dup2"}, \
+		[34] = {0, SYSCALL_TS, "pause"}, \
+		[35] = {2, 0, "nanosleep"}, \
+		[36] = {2, 0, "getitimer"}, \
+		[37] = {1, 0, "alarm"}, \
+		[38] = {3, 0, "setitimer"}, \
+		[39] = {0, 0, "getpid"}, \
+		[40] = {4, SYSCALL_TD|SYSCALL_TN, "sendfile"}, \
+		[41] = {3, SYSCALL_TN, "socket"}, \
+		[42] = {3, SYSCALL_TN, "connect"}, \
+		[43] = {3, SYSCALL_TN, "accept"}, \
+		[44] = {6, SYSCALL_TN, "sendto"}, \
+		[45] = {6, SYSCALL_TN, "recvfrom"}, \
+		[46] = {3, SYSCALL_TN, "sendmsg"}, \
+		[47] = {3, SYSCALL_TN, "recvmsg"}, \
+		[48] = {2, SYSCALL_TN, "shutdown"}, \
+		[49] = {3, SYSCALL_TN, "bind"}, \
+		[50] = {2, SYSCALL_TN, "listen"}, \
+		[51] = {3, SYSCALL_TN, "getsockname"}, \
+		[52] = {3, SYSCALL_TN, "getpeername"}, \
+		[53] = {4, SYSCALL_TN, "socketpair"}, \
+		[54] = {5, SYSCALL_TN, "setsockopt"}, \
+		[55] = {5, SYSCALL_TN, "getsockopt"}, \
+		[56] = {5, SYSCALL_TP, "clone"}, \
+		[57] = {0, SYSCALL_TP, "fork"}, \
+		[58] = {0, SYSCALL_TP, "vfork"}, \
+		[59] = {3, SYSCALL_TF|SYSCALL_TP|SYSCALL_SE|SYSCALL_SI, "execve"}, \
+		[60] = {1, SYSCALL_TP|SYSCALL_SE, "_exit"}, \
+		[61] = {4, SYSCALL_TP, "wait4"}, \
+		[62] = {2, SYSCALL_TS, "kill"}, \
+		[63] = {1, 0, "uname"}, \
+		[64] = {3, SYSCALL_TI, "semget"}, \
+		[65] = {3, SYSCALL_TI, "semop"}, \
+		[66] = {4, SYSCALL_TI, "semctl"}, \
+		[67] = {1, SYSCALL_TI|SYSCALL_TM|SYSCALL_SI, "shmdt"}, \
+		[68] = {2, SYSCALL_TI, "msgget"}, \
+		[69] = {4, SYSCALL_TI, "msgsnd"}, \
+		[70] = {5, SYSCALL_TI, "msgrcv"}, \
+		[71] = {3, SYSCALL_TI, "msgctl"}, \
+		[72] = {3, SYSCALL_TD, "fcntl"}, \
+		[73] = {2, SYSCALL_TD, "flock"}, \
+		[74] = {1, SYSCALL_TD, "fsync"}, \
+		[75] = {1, SYSCALL_TD, "fdatasync"}, \
+		[76] = {2, SYSCALL_TF, "truncate"}, \
+		[77] = {2, SYSCALL_TD, "ftruncate"}, \
+		[78] = {3, SYSCALL_TD, "getdents"}, \
+		[79] = {2, SYSCALL_TF, "getcwd"}, \
+		[80] = {1, SYSCALL_TF, "chdir"}, \
+		[81] = {1, SYSCALL_TD, "fchdir"}, \
+		[82] = {2, SYSCALL_TF, "rename"}, \
+		[83] = {2, SYSCALL_TF, "mkdir"}, \
+		[84] = {1, SYSCALL_TF, "rmdir"}, \
+		[85] = {2, SYSCALL_TD|SYSCALL_TF, "creat"}, \
+		[86] = {2, SYSCALL_TF, "link"}, \
+		[87] = {1, SYSCALL_TF, "unlink"}, \
+		[88] = {2, SYSCALL_TF, "symlink"}, \
+		[89] = {3, SYSCALL_TF, "readlink"}, \
+		[90] = {2, SYSCALL_TF, "chmod"}, \
+		[91] = {2, SYSCALL_TD, "fchmod"}, \
+		[92] = {3, SYSCALL_TF, "chown"}, \
+		[93] = {3, SYSCALL_TD, "fchown"}, \
+		[94] = {3, SYSCALL_TF, "lchown"}, \
+		[95] = {1, 0, "umask"}, \
+		[96] = {2, 0, "gettimeofday"}, \
+		[97] = {2, 0, "getrlimit"}, \
+		[98] = {2, 0, "getrusage"}, \
+		[99] = {1, 0, "sysinfo"}, \
+		[100] = {1, 0, "times"}, \
+		[101] = {4, 0, "ptrace"}, \
+		[102] = {0, SYSCALL_NF, "getuid"}, \
+		[103] = {3, 0, "syslog"}, \
+		[104] = {0, SYSCALL_NF, "getgid"}, \
+		[105] = {1, 0, "setuid"}, \
+		[106] = {1, 0, "setgid"}, \
+		[107] = {0, SYSCALL_NF, "geteuid"}, \
+		[108] = {0, SYSCALL_NF, "getegid"}, \
+		[109] = {2, 0, "setpgid"}, \
+		[110] = {0, 0, "getppid"}, \
+		[111] = {0, 0, "getpgrp"}, \
+		[112] = {0, 0, "setsid"}, \
+		[113] = {2, 0, "setreuid"}, \
+		[114] = {2, 0, "setregid"}, \
+		[115] = {2, 0, "getgroups"}, \
+		[116] = {2, 0, "setgroups"}, \
+		[117] = {3, 0, "setresuid"}, \
+		[118] = {3, 0, "getresuid"}, \
+		[119] = {3, 0, "setresgid"}, \
+		[120] = {3, 0, "getresgid"}, \
+		[121] = {1, 0, "getpgid"}, \
+		[122] = {1, SYSCALL_NF, "setfsuid"}, \
+		[123] = {1, SYSCALL_NF, "setfsgid"}, \
+		[124] = {1, 0, "getsid"}, \
+		[125] = {2, 0, "capget"}, \
+		[126] = {2, 0, "capset"}, \
+		[127] = {2, SYSCALL_TS, "rt_sigpending"}, \
+		[128] = {4, SYSCALL_TS, "rt_sigtimedwait"}, \
+		[129] = {3, SYSCALL_TS, "rt_sigqueueinfo"}, \
+		[130] = {2, SYSCALL_TS, "rt_sigsuspend"}, \
+		[131] = {2, SYSCALL_TS, "sigaltstack"}, \
+		[132] = {2, SYSCALL_TF, "utime"}, \
+		[133] = {3, SYSCALL_TF, "mknod"}, \
+		[134] = {1, SYSCALL_TF, "uselib"}, \
+		[135] = {1, 0, "personality"}, \
+		[136] = {2, 0, "ustat"}, \
+		[137] = {2, SYSCALL_TF, "statfs"}, \
+		[138] = {2, SYSCALL_TD, "fstatfs"}, \
+		[139] = {3, 0, "sysfs"}, \
+		[140] = {2, 0, "getpriority"}, \
+		[141] = {3, 0, "setpriority"}, \
+		[142] = {2, 0, "sched_setparam"}, \
+		[143] = {2, 0, "sched_getparam"}, \
+		[144] = {3, 0, "sched_setscheduler"}, \
+		[145] = {1, 0, "sched_getscheduler"}, \
+		[146] = {1, 0, "sched_get_priority_max"}, \
+		[147] = {1, 0, "sched_get_priority_min"}, \
+		[148] = {2, 0, "sched_rr_get_interval"}, \
+		[149] = {2, SYSCALL_TM, "mlock"}, \
+		[150] = {2, SYSCALL_TM, "munlock"}, \
+		[151] = {1, SYSCALL_TM, "mlockall"}, \
+		[152] = {0, SYSCALL_TM, "munlockall"}, \
+		[153] = {0, 0, "vhangup"}, \
+		[154] = {3, 0, "modify_ldt"}, \
+		[155] = {2, SYSCALL_TF, "pivot_root"}, \
+		[156] = {1, 0, "_sysctl"}, \
+		[157] = {5, 0, "prctl"}, \
+		[158] = {2, SYSCALL_TP, "arch_prctl"}, \
+		[159] = {1, 0, "adjtimex"}, \
+		[160] = {2, 0, "setrlimit"}, \
+		[161] = {1, SYSCALL_TF, "chroot"}, \
+		[162] = {0, 0, "sync"}, \
+		[163] = {1, SYSCALL_TF, "acct"}, \
+		[164] = {2, 0, "settimeofday"}, \
+		[165] = {5, SYSCALL_TF, "mount"}, \
+		[166] = {2, SYSCALL_TF, "umount2"}, \
+		[167] = {2, SYSCALL_TF, "swapon"}, \
+		[168] = {1, SYSCALL_TF, "swapoff"}, \
+		[169] = {4, 0, "reboot"}, \
+		[170] = {2, 0, "sethostname"}, \
+		[171] = {2, 0, "setdomainname"}, \
+		[172] = {1, 0, "iopl"}, \
+		[173] = {3, 0, "ioperm"}, \
+		[174] = {2, 0, "create_module"}, \
+		[175] = {3, 0, "init_module"}, \
+		[176] = {2, 0, "delete_module"}, \
+		[177] = {1, 0, "get_kernel_syms"}, \
+		[178] = {5, 0, "query_module"}, \
+		[179] = {4, SYSCALL_TF, "quotactl"}, \
+		[180] = {3, 0, "nfsservctl"}, \
+		[181] = {5, 0, "getpmsg"}, \
+		[182] = {5, 0, "putpmsg"}, \
+		[183] = {5, 0, "afs_syscall"}, \
+		[184] = {3, 0, "tuxcall"}, \
+		[185] = {3, 0, "security"}, \
+		[186] = {0, 0, "gettid"}, \
+		[187] = {3, SYSCALL_TD, "readahead"}, \
+		[188] = {5, SYSCALL_TF, "setxattr"}, \
+		[189] = {5, SYSCALL_TF, "lsetxattr"}, \
+		[190] = {5, SYSCALL_TD, "fsetxattr"}, \
+		[191] = {4, SYSCALL_TF, "getxattr"}, \
+		[192] = {4, SYSCALL_TF, "lgetxattr"}, \
+		[193] = {4, SYSCALL_TD, "fgetxattr"}, \
+		[194] = {3, SYSCALL_TF, "listxattr"}, \
+		[195] = {3, SYSCALL_TF, "llistxattr"}, \
+		[196] = {3, SYSCALL_TD, "flistxattr"}, \
+		[197] = {2, SYSCALL_TF, "removexattr"}, \
+		[198] = {2, SYSCALL_TF, "lremovexattr"}, \
+		[199] = {2, SYSCALL_TD, "fremovexattr"}, \
+		[200] = {2, SYSCALL_TS, "tkill"}, \
+		[201] = {1, 0, "time"}, \
+		[202] = {6, 0, "futex"}, \
+		[203] = {3, 0, "sched_setaffinity"}, \
+		[204] = {3, 0, "sched_getaffinity"}, \
+		[205] = {1, 0, "set_thread_area"}, \
+		[206] = {2, 0, "io_setup"}, \
+		[207] = {1, 0, "io_destroy"}, \
+		[208] = {5, 0, "io_getevents"}, \
+		[209] = {3, 0, "io_submit"}, \
+		[210] = {3, 0, "io_cancel"}, \
+		[211] = {1, 0, "get_thread_area"}, \
+		[212] = {3, 0, "lookup_dcookie"}, \
+		[213] = {1, SYSCALL_TD, "epoll_create"}, \
+		[214] = {4, 0, "epoll_ctl_old"}, \
+		[215] = {4, 0, "epoll_wait_old"}, \
+		[216] = {5, SYSCALL_TM|SYSCALL_SI, "remap_file_pages"}, \
+		[217] = {3, SYSCALL_TD, "getdents64"}, \
+		[218] = {1, 0, "set_tid_address"}, \
+		[219] = {0, 0, "restart_syscall"}, \
+		[220] = {4, SYSCALL_TI, "semtimedop"}, \
+		[221] = {4, SYSCALL_TD, "fadvise64"}, \
+		[222] = {3, 0, "timer_create"}, \
+		[223] = {4, 0, "timer_settime"}, \
+		[224] = {2, 0, "timer_gettime"}, \
+		[225] = {1, 0, "timer_getoverrun"}, \
+		[226] = {1, 0, "timer_delete"}, \
+		[227] = {2, 0, "clock_settime"}, \
+		[228] = {2, 0, "clock_gettime"}, \
+		[229] = {2, 0, "clock_getres"}, \
+		[230] = {4, 0, "clock_nanosleep"}, \
+		[231] = {1, SYSCALL_TP|SYSCALL_SE, "exit_group"}, \
+		[232] = {4, SYSCALL_TD, "epoll_wait"}, \
+		[233] = {4, SYSCALL_TD, "epoll_ctl"}, \
+		[234] = {3, SYSCALL_TS, "tgkill"}, \
+		[235] = {2, SYSCALL_TF, "utimes"}, \
+		[236] = {5, 0, "vserver"}, \
+		[237] = {6, SYSCALL_TM, "mbind"}, \
+		[238] = {3, SYSCALL_TM, "set_mempolicy"}, \
+		[239] = {5, SYSCALL_TM, "get_mempolicy"}, \
+		[240] = {4, 0, "mq_open"}, \
+		[241] = {1, 0, "mq_unlink"}, \
+		[242] = {5, 0, "mq_timedsend"}, \
+		[243] = {5, 0, "mq_timedreceive"}, \
+		[244] = {2, 0, "mq_notify"}, \
+		[245] = {3, 0, "mq_getsetattr"}, \
+		[246] = {4, 0, "kexec_load"}, \
+		[247] = {5, SYSCALL_TP, "waitid"}, \
+		[248] = {5, 0, "add_key"}, \
+		[249] = {4, 0, "request_key"}, \
+		[250] = {5, 0, "keyctl"}, \
+		[251] = {3, 0, "ioprio_set"}, \
+		[252] = {2, 0, "ioprio_get"}, \
+		[253] = {0, SYSCALL_TD, "inotify_init"}, \
+		[254] = {3, SYSCALL_TD, "inotify_add_watch"}, \
+		[255] = {2, SYSCALL_TD, "inotify_rm_watch"}, \
+		[256] = {4, SYSCALL_TM, "migrate_pages"}, \
+		[257] = {4, SYSCALL_TD|SYSCALL_TF, "openat"}, \
+		[258] = {3, SYSCALL_TD|SYSCALL_TF, "mkdirat"}, \
+		[259] = {4, SYSCALL_TD|SYSCALL_TF, "mknodat"}, \
+		[260] = {5, SYSCALL_TD|SYSCALL_TF, "fchownat"}, \
+		[261] = {3, SYSCALL_TD|SYSCALL_TF, "futimesat"}, \
+		[262] = {4, SYSCALL_TD|SYSCALL_TF, "newfstatat"}, \
+		[263] = {3, SYSCALL_TD|SYSCALL_TF, "unlinkat"}, \
+		[264] = {4, SYSCALL_TD|SYSCALL_TF, "renameat"}, \
+		[265] = {5, SYSCALL_TD|SYSCALL_TF, "linkat"}, \
+		[266] = {3, SYSCALL_TD|SYSCALL_TF, "symlinkat"}, \
+		[267] = {4, SYSCALL_TD|SYSCALL_TF, "readlinkat"}, \
+		[268] = {3, SYSCALL_TD|SYSCALL_TF, "fchmodat"}, \
+		[269] = {3, SYSCALL_TD|SYSCALL_TF, "faccessat"}, \
+		[270] = {6, SYSCALL_TD, "pselect6"}, \
+		[271] = {5, SYSCALL_TD, "ppoll"}, \
+		[272] = {1, SYSCALL_TP, "unshare"}, \
+		[273] = {2, 0, "set_robust_list"}, \
+		[274] = {3, 0, "get_robust_list"}, \
+		[275] = {6, SYSCALL_TD, "splice"}, \
+		[276] = {4, SYSCALL_TD, "tee"}, \
+		[277] = {4, SYSCALL_TD, "sync_file_range"}, \
+		[278] = {4, SYSCALL_TD, "vmsplice"}, \
+		[279] = {6, SYSCALL_TM, "move_pages"}, \
+		[280] = {4, SYSCALL_TD|SYSCALL_TF, "utimensat"}, \
+		[281] = {6, SYSCALL_TD, "epoll_pwait"}, \
+		[282] = {3, SYSCALL_TD|SYSCALL_TS, "signalfd"}, \
+		[283] = {2, SYSCALL_TD, "timerfd_create"}, \
+		[284] = {1, SYSCALL_TD, "eventfd"}, \
+		[285] = {4, SYSCALL_TD, "fallocate"}, \
+		[286] = {4, SYSCALL_TD, "timerfd_settime"}, \
+		[287] = {2, SYSCALL_TD, "timerfd_gettime"}, \
+		[288] = {4, SYSCALL_TN, "accept4"}, \
+		[289] = {4, SYSCALL_TD|SYSCALL_TS, "signalfd4"}, \
+		[290] = {2, SYSCALL_TD, "eventfd2"}, \
+		[291] = {1, SYSCALL_TD, "epoll_create1"}, \
+		[292] = {3, SYSCALL_TD, "dup3"}, \
+		[293] = {2, SYSCALL_TD, "pipe2"}, \
+		[294] = {1, SYSCALL_TD, "inotify_init1"}, \
+		[295] = {4, SYSCALL_TD, "preadv"}, \
+		[296] = {4, SYSCALL_TD, "pwritev"}, \
+		[297] = {4, SYSCALL_TP|SYSCALL_TS, "rt_tgsigqueueinfo"}, \
+		[298] = {5, SYSCALL_TD, "perf_event_open"}, \
+		[299] = {5, SYSCALL_TN, "recvmmsg"}, \
+		[300] = {2, SYSCALL_TD, "fanotify_init"}, \
+		[301] = {5, SYSCALL_TD|SYSCALL_TF, "fanotify_mark"}, \
+		[302] = {4, 0, "prlimit64"}, \
+		[303] = {5, SYSCALL_TD|SYSCALL_TF, "name_to_handle_at"}, \
+		[304] = {3, SYSCALL_TD, "open_by_handle_at"}, \
+		[305] = {2, 0, "clock_adjtime"}, \
+		[306] = {1, SYSCALL_TD, "syncfs"}, \
+		[307] = {4, SYSCALL_TN, "sendmmsg"}, \
+		[308] = {2, SYSCALL_TD, "setns"}, \
+		[309] = {3, 0, "getcpu"}, \
+		[310] = {6, 0, "process_vm_readv"}, \
+		[311] = {6, 0, "process_vm_writev"}, \
+		[312] = {5, 0, "kcmp"}, \
+		[313] = {3, SYSCALL_TD, "finit_module"}, \
+		[314] = {3, 0, "sched_setattr"}, \
+		[315] = {4, 0, "sched_getattr"}, \
+		[316] = {5, SYSCALL_TD|SYSCALL_TF, "renameat2"}, \
+		[317] = {3, 0, "seccomp"}, \
+		[318] = {3, 0, "getrandom"}, \
+		[319] = {2, SYSCALL_TD, "memfd_create"}, \
+		[320] = {5, SYSCALL_TD, "kexec_file_load"}, \
+		[321] = {3, SYSCALL_TD, "bpf"}, \
+		[322] = {5, SYSCALL_TD|SYSCALL_TF|SYSCALL_TP, "execveat"}, \
+		[323] = {1, SYSCALL_TD, "userfaultfd"}, \
+		[324] = {3, 0, "membarrier"}, \
+		[325] = {3, SYSCALL_TM, "mlock2"}, \
+		[326] = {6, SYSCALL_TD, "copy_file_range"}, \
+		[327] = {6, SYSCALL_TD, "preadv2"}, \
+		[328] = {6, SYSCALL_TD, "pwritev2"}, \
+		[329] = {4, SYSCALL_TM, "pkey_mprotect"}, \
+		[330] = {2, 0, "pkey_alloc"}, \
+		[331] = {1, 0, "pkey_free"}, \
+		[332] = {5, SYSCALL_TD|SYSCALL_TF, "statx"}, \
+		[333] = {6, 0, "io_pgetevents"}, \
+		[334] = {4, 0, "rseq"}, \
+		[424] = {4, SYSCALL_TD|SYSCALL_TS, "pidfd_send_signal"}, \
+		[425] = {2, SYSCALL_TD, "io_uring_setup"}, \
+		[426] = {6, SYSCALL_TD|SYSCALL_TS, "io_uring_enter"}, \
+		[427] = {4, SYSCALL_TD, "io_uring_register"}, \
+		[428] = {3, SYSCALL_TD|SYSCALL_TF, "open_tree"}, \
+		[429] = {5, SYSCALL_TD|SYSCALL_TF, "move_mount"}, \
+		[430] = {2, SYSCALL_TD, "fsopen"}, \
+		[431] = {5, SYSCALL_TD, "fsconfig"}, \
+		[432] = {3, SYSCALL_TD, "fsmount"}, \
+		[433] = {3, SYSCALL_TD|SYSCALL_TF, "fspick"}, \
+		[434] = {2, SYSCALL_TD, "pidfd_open"}, \
+		[435] = {2, SYSCALL_TP, "clone3"}, \
+		[436] = {3, SYSCALL_TD, "close_range"}, \
+		[437] = {4, SYSCALL_TD|SYSCALL_TF, "openat2"}, \
+		[438] = {3, SYSCALL_TD, "pidfd_getfd"}, \
+		[439] = {4, SYSCALL_TD|SYSCALL_TF, "faccessat2"}, \
+		[440] = {5, SYSCALL_TD, "process_madvise"}, \
+		[441] = {6, SYSCALL_TD, "epoll_pwait2"}, \
+		[442] = {5, SYSCALL_TD|SYSCALL_TF, "mount_setattr"}, \
+		[443] = {4, SYSCALL_TD, "quotactl_fd"}, \
+		[444] = {3, SYSCALL_TD, "landlock_create_ruleset"}, \
+		[445] = {4, SYSCALL_TD, "landlock_add_rule"}, \
+		[446] = {2, SYSCALL_TD, "landlock_restrict_self"}, \
+		[447] = {1, SYSCALL_TD, "memfd_secret"}, \
+		[448] = {2, SYSCALL_TD, "process_mrelease"}, \
+		[449] = {5, 0, "futex_waitv"}, \
+		[450] = {4, SYSCALL_TM, "set_mempolicy_home_node"}, \
+		[451] = {4, SYSCALL_TD, "cachestat"}, \
+		[452] = {4, SYSCALL_TD|SYSCALL_TF, "fchmodat2"}, \
+		[453] = {3, SYSCALL_TM, "map_shadow_stack"}, \
+		[454] = {4, 0, "futex_wake"}, \
+		[455] = {6, 0, "futex_wait"}, \
+		[456] = {4, 0, "futex_requeue"}, \
+		[457] = {4, 0, "statmount"}, \
+		[458] = {4, 0, "listmount"}, \
+		[459] = {4, 0, "lsm_get_self_attr"}, \
+		[460] = {4, 0, "lsm_set_self_attr"}, \
+		[461] = {3, 0, "lsm_list_modules"}, \
+		[462] = {3, SYSCALL_TM, "mseal"}
+#endif
+
+#ifdef __i386__
+	#define SYSCALL_NR_restart_syscall	0
+	#define SYSCALL_NR__exit	1
+	#define SYSCALL_NR_fork	2
+	#define SYSCALL_NR_read	3
+	#define SYSCALL_NR_write	4
+	#define SYSCALL_NR_open	5
+	#define SYSCALL_NR_close	6
+	#define SYSCALL_NR_waitpid	7
+	#define SYSCALL_NR_creat	8
+	#define SYSCALL_NR_link	9
+	#define SYSCALL_NR_unlink	10
+	#define SYSCALL_NR_execve	11
+	#define SYSCALL_NR_chdir	12
+	#define SYSCALL_NR_time	13
+	#define SYSCALL_NR_mknod	14
+	#define SYSCALL_NR_chmod	15
+	#define SYSCALL_NR_lchown	16
+	#define SYSCALL_NR_break	17
+	#define SYSCALL_NR_oldstat	18
+	#define SYSCALL_NR_lseek	19
+	#define SYSCALL_NR_getpid	20
+	#define SYSCALL_NR_mount	21
+	#define SYSCALL_NR_umount	22
+	#define SYSCALL_NR_setuid	23
+	#define SYSCALL_NR_getuid	24
+	#define SYSCALL_NR_stime	25
+	#define SYSCALL_NR_ptrace	26
+	#define SYSCALL_NR_alarm	27
+	#define SYSCALL_NR_oldfstat	28
+	#define SYSCALL_NR_pause	29
+	#define SYSCALL_NR_utime	30
+	#define SYSCALL_NR_stty	31
+	#define SYSCALL_NR_gtty	32
+	#define SYSCALL_NR_access	33
+	#define SYSCALL_NR_nice	34
+	#define SYSCALL_NR_ftime	35
+	#define SYSCALL_NR_sync	36
+	#define SYSCALL_NR_kill	37
+	#define SYSCALL_NR_rename	38
+	#define SYSCALL_NR_mkdir	39
+	#define SYSCALL_NR_rmdir	40
+	#define SYSCALL_NR_dup	41
+	#define SYSCALL_NR_pipe	42
+	#define SYSCALL_NR_times	43
+	#define SYSCALL_NR_prof	44
+	#define SYSCALL_NR_brk	45
+	#define SYSCALL_NR_setgid	46
+	#define SYSCALL_NR_getgid	47
+	#define SYSCALL_NR_signal	48
+	#define SYSCALL_NR_geteuid	49
+	#define SYSCALL_NR_getegid	50
+	#define SYSCALL_NR_acct	51
+	#define SYSCALL_NR_umount2	52
+	#define SYSCALL_NR_lock	53
+	#define SYSCALL_NR_ioctl	54
+	#define SYSCALL_NR_fcntl	55
+	#define SYSCALL_NR_mpx	56
+	#define SYSCALL_NR_setpgid	57
+	#define SYSCALL_NR_ulimit	58
+	#define SYSCALL_NR_oldolduname	59
+	#define SYSCALL_NR_umask	60
+	#define SYSCALL_NR_chroot	61
+	#define SYSCALL_NR_ustat	62
+	#define SYSCALL_NR_dup2	63
+	#define SYSCALL_NR_getppid	64
+	#define SYSCALL_NR_getpgrp	65
+	#define SYSCALL_NR_setsid	66
+	#define SYSCALL_NR_sigaction	67
+	#define SYSCALL_NR_sgetmask	68
+	#define SYSCALL_NR_ssetmask	69
+	#define SYSCALL_NR_setreuid	70
+	#define SYSCALL_NR_setregid	71
+	#define SYSCALL_NR_sigsuspend	72
+	#define SYSCALL_NR_sigpending	73
+	#define SYSCALL_NR_sethostname	74
+	#define SYSCALL_NR_setrlimit	75
+	#define SYSCALL_NR_getrlimit	76
+	#define SYSCALL_NR_getrusage	77
+	#define SYSCALL_NR_gettimeofday	78
+	#define SYSCALL_NR_settimeofday	79
+	#define SYSCALL_NR_getgroups	80
+	#define SYSCALL_NR_setgroups	81
+	#define SYSCALL_NR_oldselect	82
+	#define SYSCALL_NR_symlink	83
+	#define SYSCALL_NR_oldlstat	84
+	#define SYSCALL_NR_readlink	85
+	#define SYSCALL_NR_uselib	86
+	#define SYSCALL_NR_swapon	87
+	#define SYSCALL_NR_reboot	88
+	#define SYSCALL_NR_readdir	89
+	#define SYSCALL_NR_old_mmap	90
+	#define SYSCALL_NR_munmap	91
+	#define SYSCALL_NR_truncate	92
+	#define SYSCALL_NR_ftruncate	93
+	#define SYSCALL_NR_fchmod	94
+	#define SYSCALL_NR_fchown	95
+	#define SYSCALL_NR_getpriority	96
+	#define SYSCALL_NR_setpriority	97
+	#define SYSCALL_NR_profil	98
+	#define SYSCALL_NR_statfs	99
+	#define SYSCALL_NR_fstatfs	100
+	#define SYSCALL_NR_ioperm	101
+	#define SYSCALL_NR_socketcall	102
+	#define SYSCALL_NR_syslog	103
+	#define SYSCALL_NR_setitimer	104
+	#define SYSCALL_NR_getitimer	105
+	#define SYSCALL_NR_stat	106
+	#define SYSCALL_NR_lstat	107
+	#define SYSCALL_NR_fstat	108
+	#define SYSCALL_NR_olduname	109
+	#define SYSCALL_NR_iopl	110
+	#define SYSCALL_NR_vhangup	111
+	#define SYSCALL_NR_idle	112
+	#define SYSCALL_NR_vm86old	113
+	#define SYSCALL_NR_wait4	114
+	#define SYSCALL_NR_swapoff	115
+	#define SYSCALL_NR_sysinfo	116
+	#define SYSCALL_NR_ipc	117
+	#define SYSCALL_NR_fsync	118
+	#define SYSCALL_NR_sigreturn	119
+	#define SYSCALL_NR_clone	120
+	#define SYSCALL_NR_setdomainname	121
+	#define SYSCALL_NR_uname	122
+	#define SYSCALL_NR_modify_ldt	123
+	#define SYSCALL_NR_adjtimex	124
+	#define SYSCALL_NR_mprotect	125
+	#define SYSCALL_NR_sigprocmask	126
+	#define SYSCALL_NR_create_module	127
+	#define SYSCALL_NR_init_module	128
+	#define SYSCALL_NR_delete_module	129
+	#define SYSCALL_NR_get_kernel_syms	130
+	#define SYSCALL_NR_quotactl	131
+	#define SYSCALL_NR_getpgid	132
+	#define SYSCALL_NR_fchdir	133
+	#define SYSCALL_NR_bdflush	134
+	#define SYSCALL_NR_sysfs	135
+	#define SYSCALL_NR_personality	136
+	#define SYSCALL_NR_afs_syscall	137
+	#define SYSCALL_NR_setfsuid	138
+	#define SYSCALL_NR_setfsgid	139
+	#define SYSCALL_NR__llseek	140
+	#define SYSCALL_NR_getdents	141
+	#define SYSCALL_NR_select	142
+	#define SYSCALL_NR_flock	143
+	#define SYSCALL_NR_msync	144
+	#define SYSCALL_NR_readv	145
+	#define SYSCALL_NR_writev	146
+	#define SYSCALL_NR_getsid	147
+	#define SYSCALL_NR_fdatasync	148
+	#define SYSCALL_NR__sysctl	149
+	#define SYSCALL_NR_mlock	150
+	#define SYSCALL_NR_munlock	151
+	#define SYSCALL_NR_mlockall	152
+	#define SYSCALL_NR_munlockall	153
+	#define SYSCALL_NR_sched_setparam	154
+	#define SYSCALL_NR_sched_getparam	155
+	#define SYSCALL_NR_sched_setscheduler	156
+	#define SYSCALL_NR_sched_getscheduler	157
+	#define SYSCALL_NR_sched_yield	158
+	#define SYSCALL_NR_sched_get_priority_max	159
+	#define SYSCALL_NR_sched_get_priority_min	160
+	#define SYSCALL_NR_sched_rr_get_interval	161
+	#define SYSCALL_NR_nanosleep	162
+	#define SYSCALL_NR_mremap	163
+	#define SYSCALL_NR_setresuid	164
+	#define SYSCALL_NR_getresuid	165
+	#define SYSCALL_NR_vm86	166
+	#define SYSCALL_NR_query_module	167
+	#define SYSCALL_NR_poll	168
+	#define SYSCALL_NR_nfsservctl	169
+	#define SYSCALL_NR_setresgid	170
+	#define SYSCALL_NR_getresgid	171
+	#define SYSCALL_NR_prctl	172
+	#define SYSCALL_NR_rt_sigreturn	173
+	#define SYSCALL_NR_rt_sigaction	174
+	#define SYSCALL_NR_rt_sigprocmask	175
+	#define SYSCALL_NR_rt_sigpending	176
+	#define SYSCALL_NR_rt_sigtimedwait	177
+	#define SYSCALL_NR_rt_sigqueueinfo	178
+	#define SYSCALL_NR_rt_sigsuspend	179
+	#define SYSCALL_NR_pread64	180
+	#define SYSCALL_NR_pwrite64	181
+	#define SYSCALL_NR_chown	182
+	#define SYSCALL_NR_getcwd	183
+	#define SYSCALL_NR_capget	184
+	#define SYSCALL_NR_capset	185
+	#define SYSCALL_NR_sigaltstack	186
+	#define SYSCALL_NR_sendfile	187
+	#define SYSCALL_NR_getpmsg	188
+	#define SYSCALL_NR_putpmsg	189
+	#define SYSCALL_NR_vfork	190
+	#define SYSCALL_NR_ugetrlimit	191
+	#define SYSCALL_NR_mmap2	192
+	#define SYSCALL_NR_truncate64	193
+	#define SYSCALL_NR_ftruncate64	194
+	#define SYSCALL_NR_stat64	195
+	#define SYSCALL_NR_lstat64	196
+	#define SYSCALL_NR_fstat64	197
+	#define SYSCALL_NR_lchown32	198
+	#define SYSCALL_NR_getuid32	199
+	#define SYSCALL_NR_getgid32	200
+	#define SYSCALL_NR_geteuid32	201
+	#define SYSCALL_NR_getegid32	202
+	#define SYSCALL_NR_setreuid32	203
+	#define SYSCALL_NR_setregid32	204
+	#define SYSCALL_NR_getgroups32	205
+	#define SYSCALL_NR_setgroups32	206
+	#define SYSCALL_NR_fchown32	207
+	#define SYSCALL_NR_setresuid32	208
+	#define SYSCALL_NR_getresuid32	209
+	#define SYSCALL_NR_setresgid32	210
+	#define SYSCALL_NR_getresgid32	211
+	#define SYSCALL_NR_chown32	212
+	#define SYSCALL_NR_setuid32	213
+	#define SYSCALL_NR_setgid32	214
+	#define SYSCALL_NR_setfsuid32	215
+	#define SYSCALL_NR_setfsgid32	216
+	#define SYSCALL_NR_pivot_root	217
+	#define SYSCALL_NR_mincore	218
+	#define SYSCALL_NR_madvise	219
+	#define SYSCALL_NR_getdents64	220
+	#define SYSCALL_NR_fcntl64	221
+	#define SYSCALL_NR_security	223
+	#define SYSCALL_NR_gettid	224
+	#define SYSCALL_NR_readahead	225
+	#define SYSCALL_NR_setxattr	226
+	#define SYSCALL_NR_lsetxattr	227
+	#define SYSCALL_NR_fsetxattr	228
+	#define SYSCALL_NR_getxattr	229
+	#define SYSCALL_NR_lgetxattr	230
+	#define SYSCALL_NR_fgetxattr	231
+	#define SYSCALL_NR_listxattr	232
+	#define SYSCALL_NR_llistxattr	233
+	#define SYSCALL_NR_flistxattr	234
+	#define SYSCALL_NR_removexattr	235
+	#define SYSCALL_NR_lremovexattr	236
+	#define SYSCALL_NR_fremovexattr	237
+	#define SYSCALL_NR_tkill	238
+	#define SYSCALL_NR_sendfile64	239
+	#define SYSCALL_NR_futex	240
+	#define SYSCALL_NR_sched_setaffinity	241
+	#define SYSCALL_NR_sched_getaffinity	242
+	#define SYSCALL_NR_set_thread_area	243
+	#define SYSCALL_NR_get_thread_area	244
+	#define SYSCALL_NR_io_setup	245
+	#define SYSCALL_NR_io_destroy	246
+	#define SYSCALL_NR_io_getevents	247
+	#define SYSCALL_NR_io_submit	248
+	#define SYSCALL_NR_io_cancel	249
+	#define SYSCALL_NR_fadvise64	250
+	#define SYSCALL_NR_exit_group	252
+	#define SYSCALL_NR_lookup_dcookie	253
+	#define SYSCALL_NR_epoll_create	254
+	#define SYSCALL_NR_epoll_ctl	255
+	#define SYSCALL_NR_epoll_wait	256
+	#define SYSCALL_NR_remap_file_pages	257
+	#define SYSCALL_NR_set_tid_address	258
+	#define SYSCALL_NR_timer_create	259
+	#define SYSCALL_NR_timer_settime	260
+	#define SYSCALL_NR_timer_gettime	261
+	#define SYSCALL_NR_timer_getoverrun	262
+	#define SYSCALL_NR_timer_delete	263
+	#define SYSCALL_NR_clock_settime	264
+	#define SYSCALL_NR_clock_gettime	265
+	#define SYSCALL_NR_clock_getres	266
+	#define SYSCALL_NR_clock_nanosleep	267
+	#define SYSCALL_NR_statfs64	268
+	#define SYSCALL_NR_fstatfs64	269
+	#define SYSCALL_NR_tgkill	270
+	#define SYSCALL_NR_utimes	271
+	#define SYSCALL_NR_fadvise64_64	272
+	#define SYSCALL_NR_vserver	273
+	#define SYSCALL_NR_mbind	274
+	#define SYSCALL_NR_get_mempolicy	275
+	#define SYSCALL_NR_set_mempolicy	276
+	#define SYSCALL_NR_mq_open	277
+	#define SYSCALL_NR_mq_unlink	278
+	#define SYSCALL_NR_mq_timedsend	279
+	#define SYSCALL_NR_mq_timedreceive	280
+	#define SYSCALL_NR_mq_notify	281
+	#define SYSCALL_NR_mq_getsetattr	282
+	#define SYSCALL_NR_kexec_load	283
+	#define SYSCALL_NR_waitid	284
+	#define SYSCALL_NR_add_key	286
+	#define SYSCALL_NR_request_key	287
+	#define SYSCALL_NR_keyctl	288
+	#define SYSCALL_NR_ioprio_set	289
+	#define SYSCALL_NR_ioprio_get	290
+	#define SYSCALL_NR_inotify_init	291
+	#define SYSCALL_NR_inotify_add_watch	292
+	#define SYSCALL_NR_inotify_rm_watch	293
+	#define SYSCALL_NR_migrate_pages	294
+	#define SYSCALL_NR_openat	295
+	#define SYSCALL_NR_mkdirat	296
+	#define SYSCALL_NR_mknodat	297
+	#define SYSCALL_NR_fchownat	298
+	#define SYSCALL_NR_futimesat	299
+	#define SYSCALL_NR_fstatat64	300
+	#define SYSCALL_NR_unlinkat	301
+	#define SYSCALL_NR_renameat	302
+	#define SYSCALL_NR_linkat	303
+	#define SYSCALL_NR_symlinkat	304
+	#define SYSCALL_NR_readlinkat	305
+	#define SYSCALL_NR_fchmodat	306
+	#define SYSCALL_NR_faccessat	307
+	#define SYSCALL_NR_pselect6	308
+	#define SYSCALL_NR_ppoll	309
+	#define SYSCALL_NR_unshare	310
+	#define SYSCALL_NR_set_robust_list	311
+	#define SYSCALL_NR_get_robust_list	312
+	#define SYSCALL_NR_splice	313
+	#define SYSCALL_NR_sync_file_range	314
+	#define SYSCALL_NR_tee	315
+	#define SYSCALL_NR_vmsplice	316
+	#define SYSCALL_NR_move_pages	317
+	#define SYSCALL_NR_getcpu	318
+	#define SYSCALL_NR_epoll_pwait	319
+	#define SYSCALL_NR_utimensat	320
+	#define SYSCALL_NR_signalfd	321
+	#define SYSCALL_NR_timerfd_create	322
+	#define SYSCALL_NR_eventfd	323
+	#define SYSCALL_NR_fallocate	324
+	#define SYSCALL_NR_timerfd_settime	325
+	#define SYSCALL_NR_timerfd_gettime	326
+	#define SYSCALL_NR_signalfd4	327
+	#define SYSCALL_NR_eventfd2	328
+	#define SYSCALL_NR_epoll_create1	329
+	#define SYSCALL_NR_dup3	330
+	#define SYSCALL_NR_pipe2	331
+	#define SYSCALL_NR_inotify_init1	332
+	#define SYSCALL_NR_preadv	333
+	#define SYSCALL_NR_pwritev	334
+	#define SYSCALL_NR_rt_tgsigqueueinfo	335
+	#define SYSCALL_NR_perf_event_open	336
+	#define SYSCALL_NR_recvmmsg	337
+	#define SYSCALL_NR_fanotify_init	338
+	#define SYSCALL_NR_fanotify_mark	339
+	#define SYSCALL_NR_prlimit64	340
+	#define SYSCALL_NR_name_to_handle_at	341
+	#define SYSCALL_NR_open_by_handle_at	342
+	#define SYSCALL_NR_clock_adjtime	343
+	#define SYSCALL_NR_syncfs	344
+	#define SYSCALL_NR_sendmmsg	345
+	#define SYSCALL_NR_setns	346
+	#define SYSCALL_NR_process_vm_readv	347
+	#define SYSCALL_NR_process_vm_writev	348
+	#define SYSCALL_NR_kcmp	349
+	#define SYSCALL_NR_finit_module	350
+	#define SYSCALL_NR_sched_setattr	351
+	#define SYSCALL_NR_sched_getattr	352
+	#define SYSCALL_NR_renameat2	353
+	#define SYSCALL_NR_seccomp	354
+	#define SYSCALL_NR_getrandom	355
+	#define SYSCALL_NR_memfd_create	356
+	#define SYSCALL_NR_bpf	357
+	#define SYSCALL_NR_execveat	358
+	#define SYSCALL_NR_socket	359
+	#define SYSCALL_NR_socketpair	360
+	#define SYSCALL_NR_bind	361
+	#define SYSCALL_NR_connect	362
+	#define SYSCALL_NR_listen	363
+	#define SYSCALL_NR_accept4	364
+	#define SYSCALL_NR_getsockopt	365
+	#define SYSCALL_NR_setsockopt	366
+	#define SYSCALL_NR_getsockname	367
+	#define SYSCALL_NR_getpeername	368
+	#define SYSCALL_NR_sendto	369
+	#define SYSCALL_NR_sendmsg	370
+	#define SYSCALL_NR_recvfrom	371
+	#define SYSCALL_NR_recvmsg	372
+	#define SYSCALL_NR_shutdown	373
+
+	/** Highest syscall number of the architecture, plus 1 */
+	#define SYSCALL_TABLE_LEN	374
+
+	/** Initializer of syscall_info[SYSCALL_TABLE_LEN], indexed by syscall number */
+	#define SYSCALL_TABLE_INIT \
+		[0] = {0, 0, "restart_syscall"}, \
+		[1] = {1, SYSCALL_TP|SYSCALL_SE, "_exit"}, \
+		[2] = {0, SYSCALL_TP, "fork"}, \
+		[3] = {3, SYSCALL_TD, "read"}, \
+		[4] = {3, SYSCALL_TD, "write"}, \
+		[5] = {3, SYSCALL_TD|SYSCALL_TF, "open"}, \
+		[6] = {1, SYSCALL_TD, "close"}, \
+		[7] = {3, SYSCALL_TP, "waitpid"}, \
+		[8] = {2, SYSCALL_TD|SYSCALL_TF, "creat"}, \
+		[9] = {2, SYSCALL_TF, "link"}, \
+		[10] = {1, SYSCALL_TF, "unlink"}, \
+		[11] = {3, SYSCALL_TF|SYSCALL_TP|SYSCALL_SE|SYSCALL_SI, "execve"}, \
+		[12] = {1, SYSCALL_TF, "chdir"}, \
+		[13] = {1, 0, "time"}, \
+		[14] = {3, SYSCALL_TF, "mknod"}, \
+		[15] = {2, SYSCALL_TF, "chmod"}, \
+		[16] = {3, SYSCALL_TF, "lchown"}, \
+		[17] = {0, SYSCALL_TM, "break"}, \
+		[18] = {2, SYSCALL_TF, "oldstat"}, \
+		[19] = {3, SYSCALL_TD, "lseek"}, \
+		[20] = {0, 0, "getpid"}, \
+		[21] = {5, SYSCALL_TF, "mount"}, \
+		[22] = {1, SYSCALL_TF, "umount"}, \
+		[23] = {1, 0, "setuid"}, \
+		[24] = {0, SYSCALL_NF, "getuid"}, \
+		[25] = {1, 0, "stime"}, \
+		[26] = {4, 0, "ptrace"}, \
+		[27] = {1, 0, "alarm"}, \
+		[28] = {2, SYSCALL_TD, "oldfstat"}, \
+		[29] = {0, SYSCALL_TS, "pause"}, \
+		[30] = {2, SYSCALL_TF, "utime"}, \
+		[31] = {2, 0, "stty"}, \
+		[32] = {2, 0, "gtty"}, \
+		[33] = {2, SYSCALL_TF, "access"}, \
+		[34] = {1, 0, "nice"}, \
+		[35] = {0, 0, "ftime"}, \
+		[36] = {0, 0, "sync"}, \
+		[37] = {2, SYSCALL_TS, "kill"}, \
+		[38] = {2, SYSCALL_TF, "rename"}, \
+		[39] = {2, SYSCALL_TF, "mkdir"}, \
+		[40] = {1, SYSCALL_TF, "rmdir"}, \
+		[41] = {1, SYSCALL_TD, "dup"}, \
+		[42] = {1, SYSCALL_TD, "pipe"}, \
+		[43] = {1, 0, "times"}, \
+		[44] = {0, 0, "prof"}, \
+		[45] = {1, SYSCALL_TM|SYSCALL_SI, "brk"}, \
+		[46] = {1, 0, "setgid"}, \
+		[47] = {0, SYSCALL_NF, "getgid"}, \
+		[48] = {3, SYSCALL_TS, "signal"}, \
+		[49] = {0, SYSCALL_NF, "geteuid"}, \
+		[50] = {0, SYSCALL_NF, "getegid"}, \
+		[51] = {1, SYSCALL_TF, "acct"}, \
+		[52] = {2, SYSCALL_TF, "umount2"}, \
+		[53] = {0, 0, "lock"}, \
+		[54] = {3, SYSCALL_TD, "ioctl"}, \
+		[55] = {3, SYSCALL_TD, "fcntl"}, \
+		[56] = {0, 0, "mpx"}, \
+		[57] = {2, 0, "setpgid"}, \
+		[58] = {2, 0, "ulimit"}, \
+		[59] = {1, 0, "oldolduname"}, \
+		[60] = {1, 0, "umask"}, \
+		[61] = {1, SYSCALL_TF, "chroot"}, \
+		[62] = {2, 0, "ustat"}, \
+		[63] = {2, SYSCALL_TD, "dup2"}, \
+		[64] = {0, 0, "getppid"}, \
+		[65] = {0, 0, "getpgrp"}, \
+		[66] = {0, 0, "setsid"}, \
+		[67] = {3, SYSCALL_TS, "sigaction"}, \
+		[68] = {0, SYSCALL_TS, "sgetmask"}, \
+		[69] = {1, SYSCALL_TS, "ssetmask"}, \
+		[70] = {2, 0, "setreuid"}, \
+		[71] = {2, 0, "setregid"}, \
+		[72] = {3, SYSCALL_TS, "sigsuspend"}, \
+		[73] = {1, SYSCALL_TS, "sigpending"}, \
+		[74] = {2, 0, "sethostname"}, \
+		[75] = {2, 0, "setrlimit"}, \
+		[76] = {2, 0, "getrlimit"}, \
+		[77] = {2, 0, "getrusage"}, \
+		[78] = {2, 0, "gettimeofday"}, \
+		[79] = {2, 0, "settimeofday"}, \
+		[80] = {2, 0, "getgroups"}, \
+		[81] = {2, 0, "setgroups"}, \
+		[82] = {1, SYSCALL_TD, "oldselect"}, \
+		[83] = {2, SYSCALL_TF, "symlink"}, \
+		[84] = {2, SYSCALL_TF, "oldlstat"}, \
+		[85] = {3, SYSCALL_TF, "readlink"}, \
+		[86] = {1, SYSCALL_TF, "uselib"}, \
+		[87] = {2, SYSCALL_TF, "swapon"}, \
+		[88] = {4, 0, "reboot"}, \
+		[89] = {3, SYSCALL_TD, "readdir"}, \
+		[90] = {6, SYSCALL_TD|SYSCALL_TM|SYSCALL_SI, "old_mmap"}, \
+		[91] = {2, SYSCALL_TM|SYSCALL_SI, "munmap"}, \
+		[92] = {2, SYSCALL_TF, "truncate"}, \
+		[93] = {2, SYSCALL_TD, "ftruncate"}, \
+		[94] = {2, SYSCALL_TD, "fchmod"}, \
+		[95] = {3, SYSCALL_TD, "fchown"}, \
+		[96] = {2, 0, "getpriority"}, \
+		[97] = {3, 0, "setpriority"}, \
+		[98] = {4, 0, "profil"}, \
+		[99] = {2, SYSCALL_TF, "statfs"}, \
+		[100] = {2, SYSCALL_TD, "fstatfs"}, \
+		[101] = {3, 0, "ioperm"}, \
+		[102] = {2, SYSCALL_TD, "socketcall"}, \
+		[103] = {3, 0, "syslog"}, \
+		[104] = {3, 0, "setitimer"}, \
+		[105] = {2, 0, "getitimer"}, \
+		[106] = {2, SYSCALL_TF, "stat"}, \
+		[107] = {2, SYSCALL_TF, "lstat"}, \
+		[108] = {2, SYSCALL_TD, "fstat"}, \
+		[109] = {1, 0, "olduname"}, \
+		[110] = {1, 0, "iopl"}, \
+		[111] = {0, 0, "vhangup"}, \
+		[112] = {0, 0, "idle"}, \
+		[113] = {1, 0, "vm86old"}, \
+		[114] = {4, SYSCALL_TP, "wait4"}, \
+		[115] = {1, SYSCALL_TF, "swapoff"}, \
+		[116] = {1, 0, "sysinfo"}, \
+		[117] = {6, SYSCALL_TI, "ipc"}, \
+		[118] = {1, SYSCALL_TD, "fsync"}, \
+		[119] = {0, SYSCALL_TS, "sigreturn"}, \
+		[120] = {5, SYSCALL_TP, "clone"}, \
+		[121] = {2, 0, "setdomainname"}, \
+		[122] = {1, 0, "uname"}, \
+		[123] = {3, 0, "modify_ldt"}, \
+		[124] = {1, 0, "adjtimex"}, \
+		[125] = {3, SYSCALL_TM|SYSCALL_SI, "mprotect"}, \
+		[126] = {3, SYSCALL_TS, "sigprocmask"}, \
+		[127] = {2, 0, "create_module"}, \
+		[128] = {3, 0, "init_module"}, \
+		[129] = {2, 0, "delete_module"}, \
+		[130] = {1, 0, "get_kernel_syms"}, \
+		[131] = {4, SYSCALL_TF, "quotactl"}, \
+		[132] = {1, 0, "getpgid"}, \
+		[133] = {1, SYSCALL_TD, "fchdir"}, \
+		[134] = {0, 0, "bdflush"}, \
+		[135] = {3, 0, "sysfs"}, \
+		[136] = {1, 0, "personality"}, \
+		[137] = {5, 0, "afs_syscall"}, \
+		[138] = {1, SYSCALL_NF, "setfsuid"}, \
+		[139] = {1, SYSCALL_NF, "setfsgid"}, \
+		[140] = {5, SYSCALL_TD, "_llseek"}, \
+		[141] = {3, SYSCALL_TD, "getdents"}, \
+		[142] = {5, SYSCALL_TD, "select"}, \
+		[143] = {2, SYSCALL_TD, "flock"}, \
+		[144] = {3, SYSCALL_TM, "msync"}, \
+		[145] = {3, SYSCALL_TD, "readv"}, \
+		[146] = {3, SYSCALL_TD, "writev"}, \
+		[147] = {1, 0, "getsid"}, \
+		[148] = {1, SYSCALL_TD, "fdatasync"}, \
+		[149] = {1, 0, "_sysctl"}, \
+		[150] = {2, SYSCALL_TM, "mlock"}, \
+		[151] = {2, SYSCALL_TM, "munlock"}, \
+		[152] = {1, SYSCALL_TM, "mlockall"}, \
+		[153] = {0, SYSCALL_TM, "munlockall"}, \
+		[154] = {2, 0, "sched_setparam"}, \
+		[155] = {2, 0, "sched_getparam"}, \
+		[156] = {3, 0, "sched_setscheduler"}, \
+		[157] = {1, 0, "sched_getscheduler"}, \
+		[158] = {0, 0, "sched_yield"}, \
+		[159] = {1, 0, "sched_get_priority_max"}, \
+		[160] = {1, 0, "sched_get_priority_min"}, \
+		[161] = {2, 0, "sched_rr_get_interval"}, \
+		[162] = {2, 0, "nanosleep"}, \
+		[163] = {5, SYSCALL_TM|SYSCALL_SI, "mremap"}, \
+		[164] = {3, 0, "setresuid"}, \
+		[165] = {3, 0, "getresuid"}, \
+		[166] = {5, 0, "vm86"}, \
+		[167] = {5, 0, "query_module"}, \
+		[168] = {3, SYSCALL_TD, "poll"}, \
+		[169] = {3, 0, "nfsservctl"}, \
+		[170] = {3, 0, "setresgid"}, \
+		[171] = {3, 0, "getresgid"}, \
+		[172] = {5, 0, "prctl"}, \
+		[173] = {0, SYSCALL_TS, "rt_sigreturn"}, \
+		[174] = {4, SYSCALL_TS, "rt_sigaction"}, \
+		[175] = {4, SYSCALL_TS, "rt_sigprocmask"}, \
+		[176] = {2, SYSCALL_TS, "rt_sigpending"}, \
+		[177] = {4, SYSCALL_TS, "rt_sigtimedwait"}, \
+		[178] = {3, SYSCALL_TS, "rt_sigqueueinfo"}, \
+		[179] = {2, SYSCALL_TS, "rt_sigsuspend"}, \
+		[180] = {5, SYSCALL_TD, "pread64"}, \
+		[181] = {5, SYSCALL_TD, "pwrite64"}, \
+		[182] = {3, SYSCALL_TF, "chown"}, \
+		[183] = {2, SYSCALL_TF, "getcwd"}, \
+		[184] = {2, 0, "capget"}, \
+		[185] = {2, 0, "capset"}, \
+		[186] = {2, SYSCALL_TS, "sigaltstack"}, \
+		[187] = {4, SYSCALL_TD|SYSCALL_TN, "sendfile"}, \
+		[188] = {5, 0, "getpmsg"}, \
+		[189] = {5, 0, "putpmsg"}, \
+		[190] = {0, SYSCALL_TP, "vfork"}, \
+		[191] = {2, 0, "ugetrlimit"}, \
+		[192] = {6, SYSCALL_TD|SYSCALL_TM|SYSCALL_SI, "mmap2"}, \
+		[193] = {3, SYSCALL_TF, "truncate64"}, \
+		[194] = {3, SYSCALL_TD, "ftruncate64"}, \
+		[195] = {2, SYSCALL_TF, "stat64"}, \
+		[196] = {2, SYSCALL_TF, "lstat64"}, \
+		[197] = {2, SYSCALL_TD, "fstat64"}, \
+		[198] = {3, SYSCALL_TF, "lchown32"}, \
+		[199] = {0, SYSCALL_NF, "getuid32"}, \
+		[200] = {0, SYSCALL_NF, "getgid32"}, \
+		[201] = {0, SYSCALL_NF, "geteuid32"}, \
+		[202] = {0, SYSCALL_NF, "getegid32"}, \
+		[203] = {2, 0, "setreuid32"}, \
+		[204] = {2, 0, "setregid32"}, \
+		[205] = {2, 0, "getgroups32"}, \
+		[206] = {2, 0, "setgroups32"}, \
+		[207] = {3, SYSCALL_TD, "fchown32"}, \
+		[208] = {3, 0, "setresuid32"}, \
+		[209] = {3, 0, "getresuid32"}, \
+		[210] = {3, 0, "setresgid32"}, \
+		[211] = {3, 0, "getresgid32"}, \
+		[212] = {3, SYSCALL_TF, "chown32"}, \
+		[213] = {1, 0, "setuid32"}, \
+		[214] = {1, 0, "setgid32"}, \
+		[215] = {1, SYSCALL_NF, "setfsuid32"}, \
+		[216] = {1, SYSCALL_NF, "setfsgid32"}, \
+		[217] = {2, SYSCALL_TF, "pivot_root"}, \
+		[218] = {3, SYSCALL_TM, "mincore"}, \
+		[219] = {3, SYSCALL_TM, "madvise"}, \
+		[220] = {3, SYSCALL_TD, "getdents64"}, \
+		[221] = {3, SYSCALL_TD, "fcntl64"}, \
+		[223] = {5, 0, "security"}, \
+		[224] = {0, 0, "gettid"}, \
+		[225] = {4, SYSCALL_TD, "readahead"}, \
+		[226] = {5, SYSCALL_TF, "setxattr"}, \
+		[227] = {5, SYSCALL_TF, "lsetxattr"}, \
+		[228] = {5, SYSCALL_TD, "fsetxattr"}, \
+		[229] = {4, SYSCALL_TF, "getxattr"}, \
+		[230] = {4, SYSCALL_TF, "lgetxattr"}, \
+		[231] = {4, SYSCALL_TD, "fgetxattr"}, \
+		[232] = {3, SYSCALL_TF, "listxattr"}, \
+		[233] = {3, SYSCALL_TF, "llistxattr"}, \
+		[234] = {3, SYSCALL_TD, "flistxattr"}, \
+		[235] = {2, SYSCALL_TF, "removexattr"}, \
+		[236] = {2, SYSCALL_TF, "lremovexattr"}, \
+		[237] = {2, SYSCALL_TD, "fremovexattr"}, \
+		[238] = {2, SYSCALL_TS, "tkill"}, \
+		[239] = {4, SYSCALL_TD|SYSCALL_TN, "sendfile64"}, \
+		[240] = {6, 0, "futex"}, \
+		[241] = {3, 0, "sched_setaffinity"}, \
+		[242] = {3, 0, "sched_getaffinity"}, \
+		[243] = {1, 0, "set_thread_area"}, \
+		[244] = {1, 0, "get_thread_area"}, \
+		[245] = {2, 0, "io_setup"}, \
+		[246] = {1, 0, "io_destroy"}, \
+		[247] = {5, 0, "io_getevents"}, \
+		[248] = {3, 0, "io_submit"}, \
+		[249] = {3, 0, "io_cancel"}, \
+		[250] = {5, SYSCALL_TD, "fadvise64"}, \
+		[252] = {1, SYSCALL_TP|SYSCALL_SE, "exit_group"}, \
+		[253] = {4, 0, "lookup_dcookie"}, \
+		[254] = {1, SYSCALL_TD, "epoll_create"}, \
+		[255] = {4, SYSCALL_TD, "epoll_ctl"}, \
+		[256] = {4, SYSCALL_TD, "epoll_wait"}, \
+		[257] = {5, SYSCALL_TM|SYSCALL_SI, "remap_file_pages"}, \
+		[258] = {1, 0, "set_tid_address"}, \
+		[259] = {3, 0, "timer_create"}, \
+		[260] = {4, 0, "timer_settime"}, \
+		[261] = {2, 0, "timer_gettime"}, \
+		[262] = {1, 0, "timer_getoverrun"}, \
+		[263] = {1, 0, "timer_delete"}, \
+		[264] = {2, 0, "clock_settime"}, \
+		[265] = {2, 0, "clock_gettime"}, \
+		[266] = {2, 0, "clock_getres"}, \
+		[267] = {4, 0, "clock_nanosleep"}, \
+		[268] = {3, SYSCALL_TF, "statfs64"}, \
+		[269] = {3, SYSCALL_TD, "fstatfs64"}, \
+		[270] = {3, SYSCALL_TS, "tgkill"}, \
+		[271] = {2, SYSCALL_TF, "utimes"}, \
+		[272] = {6, SYSCALL_TD, "fadvise64_64"}, \
+		[273] = {5, 0, "vserver"}, \
+		[274] = {6, SYSCALL_TM, "mbind"}, \
+		[275] = {5, SYSCALL_TM, "get_mempolicy"}, \
+		[276] = {3, SYSCALL_TM, "set_mempolicy"}, \
+		[277] = {4, 0, "mq_open"}, \
+		[278] = {1, 0, "mq_unlink"}, \
+		[279] = {5, 0, "mq_timedsend"}, \
+		[280] = {5, 0, "mq_timedreceive"}, \
+		[281] = {2, 0, "mq_notify"}, \
+		[282] = {3, 0, "mq_getsetattr"}, \
+		[283] = {4, 0, "kexec_load"}, \
+		[284] = {5, SYSCALL_TP, "waitid"}, \
+		[286] = {5, 0, "add_key"}, \
+		[287] = {4, 0, "request_key"}, \
+		[288] = {5, 0, "keyctl"}, \
+		[289] = {3, 0, "ioprio_set"}, \
+		[290] = {2, 0, "ioprio_get"}, \
+		[291] = {0, SYSCALL_TD, "inotify_init"}, \
+		[292] = {3, SYSCALL_TD, "inotify_add_watch"}, \
+		[293] = {2, SYSCALL_TD, "inotify_rm_watch"}, \
+		[294] = {4, SYSCALL_TM, "migrate_pages"}, \
+		[295] = {4, SYSCALL_TD|SYSCALL_TF, "openat"}, \
+		[296] = {3, SYSCALL_TD|SYSCALL_TF, "mkdirat"}, \
+		[297] = {4, SYSCALL_TD|SYSCALL_TF, "mknodat"}, \
+		[298] = {5, SYSCALL_TD|SYSCALL_TF, "fchownat"}, \
+		[299] = {3, SYSCALL_TD|SYSCALL_TF, "futimesat"}, \
+		[300] = {4, SYSCALL_TD|SYSCALL_TF, "fstatat64"}, \
+		[301] = {3, SYSCALL_TD|SYSCALL_TF, "unlinkat"}, \
+		[302] = {4, SYSCALL_TD|SYSCALL_TF, "renameat"}, \
+		[303] = {5, SYSCALL_TD|SYSCALL_TF, "linkat"}, \
+		[304] = {3, SYSCALL_TD|SYSCALL_TF, "symlinkat"}, \
+		[305] = {4, SYSCALL_TD|SYSCALL_TF, "readlinkat"}, \
+		[306] = {3, SYSCALL_TD|SYSCALL_TF, "fchmodat"}, \
+		[307] = {3, SYSCALL_TD|SYSCALL_TF, "faccessat"}, \
+		[308] = {6, SYSCALL_TD, "pselect6"}, \
+		[309] = {5, SYSCALL_TD, "ppoll"}, \
+		[310] = {1, SYSCALL_TP, "unshare"}, \
+		[311] = {2, 0, "set_robust_list"}, \
+		[312] = {3, 0, "get_robust_list"}, \
+		[313] = {6, SYSCALL_TD, "splice"}, \
+		[314] = {6, SYSCALL_TD, "sync_file_range"}, \
+		[315] = {4, SYSCALL_TD, "tee"}, \
+		[316] = {4, SYSCALL_TD, "vmsplice"}, \
+		[317] = {6, SYSCALL_TM, "move_pages"}, \
+		[318] = {3, 0, "getcpu"}, \
+		[319] = {6, SYSCALL_TD, "epoll_pwait"}, \
+		[320] = {4, SYSCALL_TD|SYSCALL_TF, "utimensat"}, \
+		[321] = {3, SYSCALL_TD|SYSCALL_TS, "signalfd"}, \
+		[322] = {2, SYSCALL_TD, "timerfd_create"}, \
+		[323] = {1, SYSCALL_TD, "eventfd"}, \
+		[324] = {6, SYSCALL_TD, "fallocate"}, \
+		[325] = {4, SYSCALL_TD, "timerfd_settime"}, \
+		[326] = {2, SYSCALL_TD, "timerfd_gettime"}, \
+		[327] = {4, SYSCALL_TD|SYSCALL_TS, "signalfd4"}, \
+		[328] = {2, SYSCALL_TD, "eventfd2"}, \
+		[329] = {1, SYSCALL_TD, "epoll_create1"}, \
+		[330] = {3, SYSCALL_TD, "dup3"}, \
+		[331] = {2, SYSCALL_TD, "pipe2"}, \
+		[332] = {1, SYSCALL_TD, "inotify_init1"}, \
+		[333] = {5, SYSCALL_TD, "preadv"}, \
+		[334] = {5, SYSCALL_TD, "pwritev"}, \
+		[335] = {4, SYSCALL_TP|SYSCALL_TS, "rt_tgsigqueueinfo"}, \
+		[336] = {5, SYSCALL_TD, "perf_event_open"}, \
+		[337] = {5, SYSCALL_TN, "recvmmsg"}, \
+		[338] = {2, SYSCALL_TD, "fanotify_init"}, \
+		[339] = {6, SYSCALL_TD|SYSCALL_TF, "fanotify_mark"}, \
+		[340] = {4, 0, "prlimit64"}, \
+		[341] = {5, SYSCALL_TD|SYSCALL_TF, "name_to_handle_at"}, \
+		[342] = {3, SYSCALL_TD, "open_by_handle_at"}, \
+		[343] = {2, 0, "clock_adjtime"}, \
+		[344] = {1, SYSCALL_TD, "syncfs"}, \
+		[345] = {4, SYSCALL_TN, "sendmmsg"}, \
+		[346] = {2, SYSCALL_TD, "setns"}, \
+		[347] = {6, 0, "process_vm_readv"}, \
+		[348] = {6, 0, "process_vm_writev"}, \
+		[349] = {5, 0, "kcmp"}, \
+		[350] = {3, SYSCALL_TD, "finit_module"}, \
+		[351] = {3, 0, "sched_setattr"}, \
+		[352] = {4, 0, "sched_getattr"}, \
+		[353] = {5, SYSCALL_TD|SYSCALL_TF, "renameat2"}, \
+		[354] = {3, 0, "seccomp"}, \
+		[355] = {3, 0, "getrandom"}, \
+		[356] = {2, SYSCALL_TD, "memfd_create"}, \
+		[357] = {3, SYSCALL_TD, "bpf"}, \
+		[358] = {5, SYSCALL_TD|SYSCALL_TF|SYSCALL_TP|SYSCALL_SE|SYSCALL_SI, "execveat"}, \
+		[359] = {3, SYSCALL_TN, "socket"}, \
+		[360] = {4, SYSCALL_TN, "socketpair"}, \
+		[361] = {3, SYSCALL_TN, "bind"}, \
+		[362] = {3, SYSCALL_TN, "connect"}, \
+		[363] = {2, SYSCALL_TN, "listen"}, \
+		[364] = {4, SYSCALL_TN, "accept4"}, \
+		[365] = {5, SYSCALL_TN, "getsockopt"}, \
+		[366] = {5, SYSCALL_TN, "setsockopt"}, \
+		[367] = {3, SYSCALL_TN, "getsockname"}, \
+		[368] = {3, SYSCALL_TN, "getpeername"}, \
+		[369] = {6, SYSCALL_TN, "sendto"}, \
+		[370] = {3, SYSCALL_TN, "sendmsg"}, \
+		[371] = {6, SYSCALL_TN, "recvfrom"}, \
+		[372] = {3, SYSCALL_TN, "recvmsg"}, \
+		[373] = {2, SYSCALL_TN, "shutdown"}
+#endif
+
+#endif
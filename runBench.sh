@@ -0,0 +1,73 @@
+#!/bin/bash
+
+# Benchmarks of the Sandbox overhead, per configuration
+#
+# Authors: Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+# Date: October 2026
+# Version: 1.5
+#
+# Call as './runBench.sh [scale]' after 'make all benchmarks', or as 'make bench'
+#	scale	Multiplies the default amount of operations of each benchmark, 1 by default. Use 0.1 for a quick run
+#
+# Prints CSV in STDOUT, one line per benchmark and configuration:
+#	bench,config,operations,syscalls,elapsed_ns,ns_per_syscall,syscalls_per_s
+# The overhead of a configuration is its ns_per_syscall minus the one of the "native" line of the same benchmark.
+# A failed run prints its line with the elapsed_ns empty.
+
+SANDBOX_BIN=$(dirname "$0")/bin/sandbox
+BENCH_DIR=$(dirname "$0")/bin/bench
+LIBS="-L $(dirname "$0")/bin/libs -L $BENCH_DIR"
+SCALE=${1:-1}
+
+# Benchmark and its default amount of operations, as in src/bench/*.c
+BENCHMARKS="benchGetpid:1000000 benchWrite:1000000 benchRead:2000 benchFork:1000 benchThread:1000 benchEcho:50000"
+
+# Configuration name and the options of the Sandbox. "native" runs without Sandbox
+CONFIGS=(
+	"native|"
+	"nolib|"
+	"libpid|-l pid"
+	"libio|-l io"
+	"libtcp|-l tcp"
+	"libtime|-l time"
+	"children|-p"
+	"children-libpid|-p -l pid"
+	"supervisor-libpid|-u -l pid"
+	"inprocess-libpid|-d -l pid"
+	"chain1|-l chain1"
+	"chain2|-l chain1 -l chain2"
+	"chain4|-l chain1 -l chain2 -l chain3 -l chain4"
+	"chain8|-l chain1 -l chain2 -l chain3 -l chain4 -l chain5 -l chain6 -l chain7 -l chain8"
+)
+
+if ! [ -x "$SANDBOX_BIN" ] || ! [ -x "$BENCH_DIR/benchGetpid" ]
+then
+	echo "Build first: make all benchmarks" >&2
+	exit 1
+fi
+
+# Runs one benchmark in one configuration, prints its CSV line
+#	run_bench <config name> "<sandbox options>" <benchmark> <operations>
+function run_bench {
+	if [ "$1" == "native" ]
+	then
+		LINE=$("$BENCH_DIR/$3" $4 2>/dev/null | grep "^BENCH ")
+	else
+		LINE=$("$SANDBOX_BIN" $LIBS $2 "$BENCH_DIR/$3" $4 2>/dev/null | grep "^BENCH ")
+	fi
+	echo "$LINE" | awk -v bench="$3" -v config="$1" -v ops="$4" '
+		/^BENCH / { printf "%s,%s,%d,%d,%d,%.1f,%.0f\n", bench, config, $3, $4, $5, $5/$4, $4*1e9/$5; found=1 }
+		END { if (!found) printf "%s,%s,%d,,,,\n", bench, config, ops }'
+}
+
+echo "bench,config,operations,syscalls,elapsed_ns,ns_per_syscall,syscalls_per_s"
+for BENCH in $BENCHMARKS
+do
+	NAME=${BENCH%%:*}
+	OPERATIONS=$(awk -v n="${BENCH##*:}" -v s="$SCALE" 'BEGIN { n = int(n*s); print (n < 1) ? 1 : n }')
+	for CONFIG in "${CONFIGS[@]}"
+	do
+		run_bench "${CONFIG%%|*}" "${CONFIG#*|}" "$NAME" "$OPERATIONS"
+		rm -f /tmp/Sandbox.read /tmp/Sandbox.write		# Sniffed by libio, grows with the read benchmark
+	done
+done
@@ -16,6 +16,54 @@ then
 fi
 }
 
+# Call as:
+#	call_sandbox_expect "<arguments for sandbox>" "<executable>" "<text>" ["<text>" ...]
+#
+# Calls the sandbox locally, the script quits if it returns an error or if any <text> is not in its output
+function call_sandbox_expect {
+echo ----!!!---- Run: sandbox $1 $2  ----!!!----
+$SANDBOX_BIN $1 $2 > $EXAMPLE_OUT 2>&1
+ERR_CODE=$?
+cat $EXAMPLE_OUT
+if ! [ $ERR_CODE -eq 0 ]
+then
+	echo ----!!!---- ERROR  ----!!!----
+    exit $ERR_CODE
+fi
+for EXPECTED in "${@:3}"
+do
+	if ! grep -q -F -e "$EXPECTED" $EXAMPLE_OUT
+	then
+		echo ----!!!---- ERROR, missing in the output: $EXPECTED  ----!!!----
+	    exit 1
+	fi
+done
+}
+
+# Call as:
+#	call_tool_expect "<command line>" "<text>" ["<text>" ...]
+#
+# Runs an offline tool of bin/ on the files of a previous run, the script quits if it fails or if any <text> is not in its output
+function call_tool_expect {
+echo ----!!!---- Run: $1  ----!!!----
+$1 > $EXAMPLE_OUT 2>&1
+ERR_CODE=$?
+cat $EXAMPLE_OUT
+if ! [ $ERR_CODE -eq 0 ]
+then
+	echo ----!!!---- ERROR  ----!!!----
+    exit $ERR_CODE
+fi
+for EXPECTED in "${@:2}"
+do
+	if ! grep -q -F -e "$EXPECTED" $EXAMPLE_OUT
+	then
+		echo ----!!!---- ERROR, missing in the output: $EXPECTED  ----!!!----
+	    exit 1
+	fi
+done
+}
+
 
 # Test for ./sandbox with example parameters
 #
@@ -27,6 +75,7 @@ fi
 # Press any key to move through the sequence of examples
 
 SANDBOX_BIN=$(dirname "$0")/bin/sandbox
+EXAMPLE_OUT=/tmp/runExample.out
 #export LD_LIBRARY_PATH=$LD_LIBRARY_PATH:$(pwd)
 
 $SANDBOX_BIN -h
@@ -82,10 +131,174 @@ echo ------------------------- PID Syscalls of parent and child processes, libra
  call_sandbox_exit_iferror "-v -p -L bin/libs -l pid " "bin/tests/testFork"
 
 echo
-echo ------------------------- Running STRACE on the same commands, to compare-----------
+echo ------------------------- Syscall statistics of the same commands, per syscall and per TID -----------
+
+ call_sandbox_expect "-c -L bin/libs -l pid " "bin/tests/testLibPID" "kernel p50/p99/p999 (us)" "   39 getpid                   1         0" "| getpid" "    tid     calls    errors  kernel(us)"
+ call_sandbox_expect "-c -L bin/libs -l io " "bin/tests/testLibIO /tmp/localfile.txt" "    1 write                    1         0" "| myread" "| mywrite"
+
+echo
+echo ------------------------- Observe queue of 2 slots: the calls dropped are counted, the ones queued are all written at exit -----------
+
+rm -f /tmp/Sandbox.read /tmp/Sandbox.write
+ call_sandbox_expect "-c -q 1 -L bin/libs -l io " "bin/tests/testObserve /tmp/observefile.txt" "Wrote 3000 lines of 32 bytes" "Observe queue:" "of 2 slots"
+OBSERVED=$(sed -n 's/.*Observe queue: \([0-9]*\) calls, \([0-9]*\) dropped.*/\1 \2/p' $EXAMPLE_OUT)
+OBSERVED_CALLS=${OBSERVED% *}
+OBSERVED_DROPPED=${OBSERVED#* }
+OBSERVED_STOPS=$(awk '($2 == "read") || ($2 == "write") { stops += $3 } END { print stops }' $EXAMPLE_OUT)
+OBSERVED_RECORDS=$(cat /tmp/Sandbox.read /tmp/Sandbox.write | grep -a -c -E '^[RW] [0-9]+ [0-9]+ -?[0-9]+ [0-9]+: ')
+echo Observed $OBSERVED_CALLS calls, $OBSERVED_DROPPED dropped, $OBSERVED_STOPS stops, $OBSERVED_RECORDS records
+if ! [ "$OBSERVED_RECORDS" -eq "$OBSERVED_CALLS" ] || ! [ $(($OBSERVED_CALLS + $OBSERVED_DROPPED)) -eq "$OBSERVED_STOPS" ]
+then
+	echo ----!!!---- ERROR, the observed calls, the dropped ones and the records do not match  ----!!!----
+    exit 1
+fi
+
+echo
+echo ------------------------- Records of libio longer than its append buffer, with 8 bytes of each write, traced with a queue for all of them and in-process -----------
+
+export SANDBOX_IO_CAPTURE=8
+for MODE in "-q 4096 " "-d "
+do
+	rm -f /tmp/Sandbox.read /tmp/Sandbox.write
+	 call_sandbox_expect "$MODE-L bin/libs -l io " "bin/tests/testObserve /tmp/observefile.txt" "Wrote 3000 lines of 32 bytes"
+	RECORDS=$(grep -a -c -x -E 'W [0-9]+ [0-9]+ 32 8: Observed' /tmp/Sandbox.write)
+	echo $RECORDS records of 8 bytes in /tmp/Sandbox.write
+	if ! [ "$RECORDS" -eq 3000 ]
+	then
+		echo ----!!!---- ERROR, /tmp/Sandbox.write does not hold the 3000 writes cut to 8 bytes  ----!!!----
+	    exit 1
+	fi
+done
+unset SANDBOX_IO_CAPTURE
+ call_sandbox_expect "-c -p -L bin/libs -l pid " "bin/tests/testFork" "   39 getpid                   4         0" "  110 getppid                  4         0"
+
+echo
+echo ------------------------- Threads of parent and child shared among 2 tracer threads, library returns Static PIDs -----------
+
+ call_sandbox_expect "-p -j 2 -L bin/libs -l pid " "bin/tests/testThread" "My father is  PID 999"
+
+echo
+echo ------------------------- Supervisor mode on seccomp user notifications, library returns Static PIDs -----------
+
+ call_sandbox_expect "-u -L bin/libs -l pid " "bin/tests/testLibPID" "My PID is 666"
+
+echo
+echo ------------------------- In-process mode on Syscall User Dispatch, library returns Static PIDs -----------
+
+ call_sandbox_expect "-d -L bin/libs -l pid " "bin/tests/testLibPID" "My PID is 666"
+
+echo
+echo ------------------------- Binary event log of the syscalls, decoded offline -----------
+
+rm -f /tmp/runExample.log
+ call_sandbox_expect "-o /tmp/runExample.log -L bin/libs -l pid " "bin/tests/testLibPID" "My PID is 666"
+ call_tool_expect "bin/sandboxlog /tmp/runExample.log" "getpid() = 666 (emulated) by libpid"
+ call_tool_expect "bin/sandboxlog -f csv /tmp/runExample.log" "seq,ts_ns,tid,nr"
+
+echo
+echo ------------------------- Record of a session of the forking ECHO server, replayed without the client -----------
+
+rm -f /tmp/runExample.rec
+echo ----!!!---- Run: sandbox -p -R /tmp/runExample.rec bin/tests/ECHOserver 5592  ----!!!----
+timeout 20 $SANDBOX_BIN -p -R /tmp/runExample.rec bin/tests/ECHOserver 5592 > $EXAMPLE_OUT 2>&1 &
+SERVER_PID=$!
+sleep 1
+exec 3<>/dev/tcp/127.0.0.1/5592
+read -t 5 LINE <&3 && echo $LINE
+read -t 5 LINE <&3 && echo $LINE
+echo "sandbox" >&3
+read -t 5 LINE <&3 && echo $LINE
+echo "q" >&3
+exec 3<&-
+wait $SERVER_PID
+ERR_CODE=$?
+cat $EXAMPLE_OUT
+if ! [ $ERR_CODE -eq 0 ]
+then
+	echo ----!!!---- ERROR  ----!!!----
+    exit $ERR_CODE
+fi
+ call_sandbox_expect "-p -P /tmp/runExample.rec " "bin/tests/ECHOserver 5592" "Client said: sandbox"
+
+echo
+echo ------------------------- Library in the sparse format, only the syscalls it implements are listed -----------
+
+ call_sandbox_expect "-v -L bin/libs -l time " "bin/tests/testLibTime" "compiled custom library libtime, 4 custom syscalls"
+
+echo
+echo ------------------------- Memory arguments written back only where the tracee can write, traced and in-process -----------
+
+ call_sandbox_expect "-L bin/libs -l time " "bin/tests/testBuffers" "Stack timespec after nanosleep: 0 s 0 ns" "Read-only timespec after nanosleep: 0 s 1000 ns"
+ call_sandbox_expect "-d -L bin/libs -l time " "bin/tests/testBuffers" "Stack timespec after nanosleep: 0 s 0 ns" "Read-only timespec after nanosleep: 0 s 1000 ns"
+
+echo
+echo ------------------------- State of the custom syscalls kept per thread, traced and in-process -----------
+
+ call_sandbox_expect "-p -j 2 -L bin/libs -l time " "bin/tests/testThreadState" "Thread 1: ahead then behind" "Thread 2: ahead then behind"
+ call_sandbox_expect "-d -p -L bin/libs -l time " "bin/tests/testThreadState" "Thread 1: ahead then behind" "Thread 2: ahead then behind"
+
+echo
+echo ------------------------- Full payload capture of the I/O, read back in streams per descriptor -----------
+
+rm -rf /tmp/runExample.capture*
+mkdir /tmp/runExample.capture.streams
+export SANDBOX_CAPTURE=/tmp/runExample.capture
+ call_sandbox_expect "-L bin/libs -l capture " "bin/tests/testLibIO /tmp/localfile.txt" "Tracee terminated with return value 0"
+unset SANDBOX_CAPTURE
+ call_tool_expect "bin/sandboxcapture /tmp/runExample.capture.0" "open          18 /tmp/localfile.txt"
+ call_tool_expect "bin/sandboxcapture -s /tmp/runExample.capture.streams /tmp/runExample.capture.0" "in 1 segments"
+STREAM_FOUND=0
+for STREAM in /tmp/runExample.capture.streams/*.in
+do
+	cmp -s $STREAM /tmp/localfile.txt && STREAM_FOUND=1
+done
+if ! [ $STREAM_FOUND -eq 1 ]
+then
+	echo ----!!!---- ERROR, no stream holds the bytes read from /tmp/localfile.txt  ----!!!----
+    exit 1
+fi
+ls -l /tmp/runExample.capture.streams
+
+echo
+echo ------------------------- Capture from pages moved by mremap and mapped after munmap, the memory maps are read again -----------
+
+rm -rf /tmp/runExample.maps*
+mkdir /tmp/runExample.maps.streams
+export SANDBOX_CAPTURE=/tmp/runExample.maps
+ call_sandbox_expect "-L bin/libs -l capture " "bin/tests/testMaps /tmp/mapsfile.txt" "Wrote from 3 pages to /tmp/mapsfile.txt"
+unset SANDBOX_CAPTURE
+ call_tool_expect "bin/sandboxcapture /tmp/runExample.maps.0" "write      out           35"
+if grep -q -F -e "unreadable" $EXAMPLE_OUT
+then
+	echo ----!!!---- ERROR, a write from a new page was not read  ----!!!----
+    exit 1
+fi
+ call_tool_expect "bin/sandboxcapture -s /tmp/runExample.maps.streams /tmp/runExample.maps.0" "in 1 segments"
+STREAM_FOUND=0
+for STREAM in /tmp/runExample.maps.streams/*.out
+do
+	cmp -s $STREAM /tmp/mapsfile.txt && STREAM_FOUND=1
+done
+if ! [ $STREAM_FOUND -eq 1 ]
+then
+	echo ----!!!---- ERROR, no stream holds the bytes written to /tmp/mapsfile.txt  ----!!!----
+    exit 1
+fi
+
+echo
+echo ------------------------- Unit test of the PID/TID hash table -----------
+
+bin/tests/testHash
+ERR_CODE=$?
+if ! [ $ERR_CODE -eq 0 ]
+then
+	echo ----!!!---- ERROR  ----!!!----
+    exit $ERR_CODE
+fi
+
+echo
+echo ------------------------- Unit test of the memory helpers, on their own process -----------
 
-strace -c bin/tests/testLibPID
-strace -c bin/tests/testLibIO
-strace -c -f bin/tests/testFork
+ call_tool_expect "bin/tests/testHelper" "read_string boundaries done, 0 errors" "write_writable_regions over a read-only page returns 48" "memory regions done, 0 errors"
 
 exit 0
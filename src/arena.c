@@ -0,0 +1,378 @@
+/*! \file arena.c
+    \brief Scratch arena holding the memory arguments of the custom syscalls
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see arena.h
+
+	\internal
+
+	* There is one slot per argument of the syscall. A slot takes the largest length declared for it by the functions of the chain,
+	* and the OR of their directions. Its bytes live twice in arena_memory: the copy passed to the functions, and the bytes as read from the \b tracee.
+	* The chains run one at a time (library_lock, or dispatch_lock with option -d), so a single arena is shared by all the tracer threads.
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include "messages.h"
+#include "dynlib.h"
+#include "arena.h"
+
+/** Changed ranges closer than this amount of bytes are written back as a single one */
+#define ARENA_MERGE_GAP		32
+/** Mask of all the slots */
+#define ARENA_ALL_SLOTS		((1 << ARENA_ARGUMENTS) - 1)
+/** Ranges written back in a single call */
+#define ARENA_MAX_REGIONS	32
+
+/** The argument is not in the arena */
+#define SLOT_EMPTY		0
+/** The buffer was read from the tracee */
+#define SLOT_FETCHED	1
+/** The buffer must be read again, a function may have changed the tracee memory */
+#define SLOT_STALE		2
+/** The buffer could not be read, the functions receive NULL */
+#define SLOT_FAILED		3
+
+/*! \brief A memory argument in the arena */
+typedef struct {
+	long int addr;		//!< Address in the \b tracee
+	char* local;		//!< Copy passed to the functions
+	char* shadow;		//!< Bytes as read from the \b tracee, to find the changed ones
+	int length;			//!< Amount of bytes
+	char direction;		//!< OR of the directions declared by the functions
+	char state;			//!< SLOT_EMPTY, SLOT_FETCHED, SLOT_STALE or SLOT_FAILED
+	}
+arena_slot;
+
+char arena_in_process = FALSE;
+
+arena_slot arena_slots[ARENA_ARGUMENTS];	//!< Buffers of the chain being executed, by argument
+char* arena_memory = NULL;					//!< Storage of the slots, grown when needed
+size_t arena_capacity = 0;					//!< Bytes allocated in arena_memory
+pid_t arena_pid = 0;						//!< Tracee the arena was read from
+long int* arena_args = NULL;				//!< Arguments of the chain the arena was read for
+char arena_reusable = FALSE;				//!< TRUE once a BEFORE chain ended, the AFTER chain of the same stop may reuse the arena
+
+//-------------------------------------------------------------------------------------------------//
+
+/*! Computes the length of a declared buffer for this syscall.
+ \param buffer is the declared buffer
+ \param args are the arguments of the syscall
+ \param after TRUE(1) in the AFTER chain
+ \return the amount of bytes to copy, 0 if none
+*/
+long int buffer_length(buffer_descriptor* buffer, long int* args, int after)
+{
+	long int length;
+	long int max = (buffer->length > 0) ? buffer->length : BUFFER_DEFAULT_MAX_LENGTH;
+
+	switch (buffer->length_kind)
+	{
+	case LENGTH_FIXED:
+		return (buffer->length > 0) ? buffer->length : 0;
+	case LENGTH_ARG:
+		if ((buffer->length_arg < 0) || (buffer->length_arg >= ARENA_ARGUMENTS))
+			return 0;
+		length = args[(int)buffer->length_arg];
+		break;
+	case LENGTH_RETURN:
+		if (! after)
+			return 0;
+		// An emulated syscall returns the result of the chain instead of the kernel one
+		length = tracee.kernel_executed ? tracee.kernel_return_value : tracee.return_value;
+		break;
+	default:
+		return 0;
+	}
+	if (length < 0)
+		return 0;
+	return (length > max) ? max : length;
+}
+
+/*! Reads some stale slots from the tracee, all together.
+ * If any of them cannot be read, they are read one by one to know which.
+ \param mask has the bit i set for the slot of argument i
+*/
+void arena_fetch(int mask)
+{
+	memory_region regions[ARENA_ARGUMENTS];
+	int i, n = 0;
+
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+	{
+		if ((! (mask & (1 << i))) || (arena_slots[i].state != SLOT_STALE))
+			continue;
+		regions[n].addr = (void*)arena_slots[i].addr;
+		regions[n].buf = arena_slots[i].local;
+		regions[n].n = arena_slots[i].length;
+		n++;
+	}
+	if (n == 0)
+		return;
+
+	n = (read_memory_regions(arena_pid, regions, n) != RETURN_ERR);
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+	{
+		if ((! (mask & (1 << i))) || (arena_slots[i].state != SLOT_STALE))
+			continue;
+		if ((n) || (read_memory_byte(arena_pid, (void*)arena_slots[i].addr, arena_slots[i].local, arena_slots[i].length) == arena_slots[i].length))
+		{
+			memcpy(arena_slots[i].shadow, arena_slots[i].local, arena_slots[i].length);
+			arena_slots[i].state = SLOT_FETCHED;
+		}
+		else
+		{
+			vprintf(BUFFER_NOT_READ_D, i);
+			arena_slots[i].state = SLOT_FAILED;
+		}
+	}
+}
+
+/*! Writes back the ranges changed in some slots, and takes them as the new content read.
+ \param mask has the bit i set for the slot of argument i
+*/
+void arena_write_back(int mask)
+{
+	memory_region regions[ARENA_MAX_REGIONS];
+	arena_slot* slot;
+	int i, j, start, last, n = 0, bytes = 0;
+
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+	{
+		slot = &(arena_slots[i]);
+		if ((! (mask & (1 << i))) || (slot->state != SLOT_FETCHED) || (! (slot->direction & BUFFER_OUT)))
+			continue;
+		if (memcmp(slot->local, slot->shadow, slot->length) == 0)
+			continue;
+
+		j = 0;
+		while (j < slot->length)
+		{
+			if (slot->local[j] == slot->shadow[j])
+			{
+				j++;
+				continue;
+			}
+			// A range ends after ARENA_MERGE_GAP equal bytes
+			start = j;
+			last = j;
+			for(j=start+1;(j < slot->length) && (j - last <= ARENA_MERGE_GAP);j++)
+				if (slot->local[j] != slot->shadow[j])
+					last = j;
+			if (n == ARENA_MAX_REGIONS)
+			{
+				if (write_writable_regions(arena_pid, regions, n) != bytes)
+					vprintf(BUFFER_NOT_WRITTEN);
+				n = 0;
+				bytes = 0;
+			}
+			regions[n].addr = (void*)(slot->addr + start);
+			regions[n].buf = slot->local + start;
+			regions[n].n = last + 1 - start;
+			bytes += regions[n].n;
+			n++;
+			memcpy(slot->shadow + start, slot->local + start, last + 1 - start);
+			j = last + 1;
+		}
+	}
+	if ((n > 0) && (write_writable_regions(arena_pid, regions, n) != bytes))
+		vprintf(BUFFER_NOT_WRITTEN);
+}
+
+void arena_begin(syscall_dispatch_entry* entry, long int* args, int after)
+{
+	custom_syscall_link* chain = after ? entry->after_chain : entry->before_chain;
+	int chain_len = after ? entry->after_chain_len : entry->before_chain_len;
+	arena_slot wanted[ARENA_ARGUMENTS];
+	buffer_descriptor* buffer;
+	long int length;
+	size_t total = 0;
+	char* memory;
+	int i, j, reuse;
+
+	memset(wanted, 0, sizeof(wanted));
+	for(i=0;i<chain_len;i++)
+		for(j=0;(j<MAX_BUFFER_ARGUMENTS) && (chain[i].buffers != NULL);j++)
+		{
+			buffer = &(chain[i].buffers[j]);
+			if ((buffer->direction == 0) || (buffer->arg < 0) || (buffer->arg >= ARENA_ARGUMENTS) || (args[(int)buffer->arg] == 0))
+				continue;
+			length = buffer_length(buffer, args, after);
+			if (length == 0)
+				continue;
+			wanted[(int)buffer->arg].addr = args[(int)buffer->arg];
+			if (length > wanted[(int)buffer->arg].length)
+				wanted[(int)buffer->arg].length = length;
+			wanted[(int)buffer->arg].direction |= buffer->direction;
+		}
+
+	// Nothing ran between the chains of an emulated syscall, the arena is still the tracee memory
+	reuse = (after && arena_reusable && (! tracee.kernel_executed) && (arena_pid == tracee.trace_PID) && (arena_args == args));
+	for(i=0;(reuse) && (i<ARENA_ARGUMENTS);i++)
+		if ((wanted[i].length > 0) && ((arena_slots[i].state != SLOT_FETCHED) || (arena_slots[i].addr != wanted[i].addr) || (arena_slots[i].length < wanted[i].length)))
+			reuse = FALSE;
+	arena_reusable = FALSE;
+	if (reuse)
+	{
+		for(i=0;i<ARENA_ARGUMENTS;i++)
+		{
+			arena_slots[i].direction = wanted[i].direction;
+			if (wanted[i].length == 0)
+				arena_slots[i].state = SLOT_EMPTY;
+		}
+		return;
+	}
+
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+		total += 2 * wanted[i].length;
+	if ((total > arena_capacity) && (! arena_in_process))		// A signal handler cannot allocate, see arena_reserve()
+	{
+		memory = (char*)realloc(arena_memory, total);
+		if (memory != NULL)
+		{
+			arena_memory = memory;
+			arena_capacity = total;
+		}
+	}
+
+	total = 0;
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+	{
+		arena_slots[i] = wanted[i];
+		if (wanted[i].length == 0)
+			continue;
+		if (2 * wanted[i].length + total > arena_capacity)
+		{
+			arena_slots[i].state = SLOT_FAILED;		// No memory for it, the functions get NULL
+			continue;
+		}
+		arena_slots[i].local = arena_memory + total;
+		arena_slots[i].shadow = arena_memory + total + wanted[i].length;
+		arena_slots[i].state = SLOT_STALE;
+		total += 2 * wanted[i].length;
+	}
+	arena_pid = tracee.trace_PID;
+	arena_args = args;
+	arena_fetch(ARENA_ALL_SLOTS);
+}
+
+int arena_reserve(void)
+{
+	syscall_dispatch_entry* entry;
+	custom_syscall_link* chain;
+	buffer_descriptor* buffer;
+	long int longest[ARENA_ARGUMENTS];
+	long int length;
+	size_t total, needed = 0;
+	int i, j, k, after, chain_len;
+
+	for(i=0;i<dispatch_table_len;i++)
+	{
+		entry = get_dispatch_entry(i);
+		if ((entry == NULL) || (! entry->has_buffers))
+			continue;
+		for(after=0;after<2;after++)
+		{
+			chain = after ? entry->after_chain : entry->before_chain;
+			chain_len = after ? entry->after_chain_len : entry->before_chain_len;
+			memset(longest, 0, sizeof(longest));
+			for(j=0;j<chain_len;j++)
+				for(k=0;(k<MAX_BUFFER_ARGUMENTS) && (chain[j].buffers != NULL);k++)
+				{
+					buffer = &(chain[j].buffers[k]);
+					if ((buffer->direction == 0) || (buffer->arg < 0) || (buffer->arg >= ARENA_ARGUMENTS))
+						continue;
+					// The longest copy buffer_length() can give
+					length = (buffer->length > 0) ? buffer->length : ((buffer->length_kind == LENGTH_FIXED) ? 0 : BUFFER_DEFAULT_MAX_LENGTH);
+					if (length > longest[(int)buffer->arg])
+						longest[(int)buffer->arg] = length;
+				}
+			total = 0;
+			for(k=0;k<ARENA_ARGUMENTS;k++)
+				total += 2 * longest[k];
+			if (total > needed)
+				needed = total;
+		}
+	}
+	if (needed <= arena_capacity)
+		return RETURN_OK;
+	arena_memory = (char*)realloc(arena_memory, needed);
+	if (arena_memory == NULL)
+	{
+		arena_capacity = 0;
+		return RETURN_ERR;
+	}
+	arena_capacity = needed;
+	return RETURN_OK;
+}
+
+int arena_buffer_length(int arg)
+{
+	if ((arg < 0) || (arg >= ARENA_ARGUMENTS) || (arena_slots[arg].state != SLOT_FETCHED))
+		return 0;
+	return arena_slots[arg].length;
+}
+
+void arena_function_args(buffer_descriptor* buffers, long int* args, long int* function_args)
+{
+	buffer_descriptor* buffer;
+	int declared = 0;
+	int stale = 0;
+	int i;
+
+	for(i=0;(i<MAX_BUFFER_ARGUMENTS) && (buffers != NULL);i++)
+	{
+		buffer = &(buffers[i]);
+		if ((buffer->direction != 0) && (buffer->arg >= 0) && (buffer->arg < ARENA_ARGUMENTS))
+			declared |= (1 << buffer->arg);
+	}
+
+	// The function reads the tracee memory itself: it must see the changes of the previous ones, and it may change it
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+		if ((arena_slots[i].state != SLOT_EMPTY) && (! (declared & (1 << i))))
+			stale |= (1 << i);
+	if (stale)
+	{
+		arena_write_back(stale);
+		for(i=0;i<ARENA_ARGUMENTS;i++)
+			if ((stale & (1 << i)) && (arena_slots[i].state == SLOT_FETCHED))
+				arena_slots[i].state = SLOT_STALE;
+	}
+	arena_fetch(declared);		// Slots left stale by a previous function
+
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+	{
+		function_args[i] = args[i];
+		if (! (declared & (1 << i)))
+			continue;
+		function_args[i] = (arena_slots[i].state == SLOT_FETCHED) ? (long int)arena_slots[i].local : 0;
+	}
+}
+
+void arena_end(int after)
+{
+	arena_write_back(ARENA_ALL_SLOTS);
+	arena_reusable = ! after;
+}
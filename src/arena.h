@@ -0,0 +1,87 @@
+/*! \file arena.h
+    \brief Scratch arena holding the memory arguments of the custom syscalls, copied once per stop from the tracee
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * The custom syscalls declare their buffers in custom_syscall_entry.buffers, of the sparse library format (see buffer_descriptor).
+	 * Before a chain runs, the union of the buffers declared by its functions is read from the \b tracee into the arena, in a single process_vm_readv().
+	 * Each function receives, in the arguments it declared, a pointer into the arena. The arena keeps a copy of the bytes as read,
+	 * and when the chain ends only the ranges that differ from it are written back, the whole chain costing at most one read and one write.
+	 *
+	 * A function that does not declare a buffer in the arena gets the \b tracee address. The changes of the previous functions are written back before it runs,
+	 * and the buffer is read again for the next function declaring it.
+	 *
+	 * An emulated syscall runs both chains in the same stop: the AFTER chain reuses the buffers of the BEFORE chain without reading them again.
+	 * Only the pages the \b tracee can write are written back, as the kernel does with the output of a syscall: a buffer in read-only memory is left as it was.
+	 *
+	 * With option -d the functions run inside the \b tracee, in its SIGSYS handler, and get copies all the same: writing into the buffers never faults in the handler,
+	 * and both modes behave the same. arena_in_process is set, the arena is allocated once by arena_reserve() as a signal handler cannot allocate.
+	 *
+	\see arena.c dynlib.c sandbox_customsyscall_descriptor.h
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_ARENA	//Lock to prevent recursive inclusions
+#define INC_ARENA
+
+#include "dynlib.h"
+
+/** Amount of arguments of a syscall */
+#define ARENA_ARGUMENTS		6
+
+/** TRUE if the functions run in the address space of the \b tracee (option -d), in a signal handler: the arena never grows, see arena_reserve() */
+extern char arena_in_process;
+
+/*! Allocates the arena for the longest buffers the functions of the dispatch table may declare, once the table is built.
+ * Used with option -d, the arena is not grown in the signal handler.
+ * \return RETURN_OK, RETURN_ERR if memory could not be allocated
+*/
+int arena_reserve(void);
+
+/*! Reads into the arena the buffers declared by the functions of a chain, for the \b tracee in tracee.trace_PID.
+ * \param entry is the execution plan of the syscall, entry->has_buffers is TRUE
+ * \param args are the 6 arguments of the syscall, as the \b tracee passed them
+ * \param after TRUE(1) for the AFTER chain, where LENGTH_RETURN buffers are known, FALSE(0) for the BEFORE chain
+*/
+void arena_begin(syscall_dispatch_entry* entry, long int* args, int after);
+
+/*! Builds the arguments of a function of the chain.
+ * The buffers it declares point into the arena, or are NULL if they could not be read. The others are the \b tracee arguments,
+ * and the changes made in them by the previous functions are written back first.
+ * \param buffers are the memory arguments of the custom syscall about to be called, NULL if it declares none
+ * \param args are the 6 arguments of the syscall, as the \b tracee passed them
+ * \param function_args receives the 6 arguments for the function
+*/
+void arena_function_args(buffer_descriptor* buffers, long int* args, long int* function_args);
+
+/*! Gets the amount of bytes of a memory argument in the arena, for the functions of the chain being executed
+ * \param arg is the argument, from 0 to 5
+ * \return the length of the copy, 0 if the argument is not in the arena or could not be read
+*/
+int arena_buffer_length(int arg);
+
+/*! Writes back to the \b tracee the bytes of the BUFFER_OUT buffers changed by the chain, in a single process_vm_writev() when possible.
+ * The ranges in pages that the \b tracee cannot write are skipped.
+ * \param after TRUE(1) at the end of the AFTER chain, FALSE(0) at the end of the BEFORE chain
+*/
+void arena_end(int after);
+
+#endif
@@ -0,0 +1,50 @@
+/*! \file bench.h
+    \brief Common helpers of the benchmark tracees
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+	Each benchmark runs a loop of operations, timed with CLOCK_MONOTONIC (vDSO, no syscall), and prints one line:
+	\code
+	BENCH <name> <operations> <syscalls> <elapsed ns>
+	\endcode
+	runBench.sh turns the lines into CSV, with the ns per syscall and the throughput.
+
+ 	\see runBench.sh
+
+*/
+
+#ifndef INC_BENCH	//Lock to prevent recursive inclusions
+#define INC_BENCH
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/** Operations when no amount is given as first argument */
+#define BENCH_DEFAULT_OPERATIONS	100000
+
+/** \return the CLOCK_MONOTONIC time in ns */
+static inline unsigned long long bench_now(void)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return (unsigned long long)t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+
+/** \return the amount of operations given as first argument, or the default one */
+static inline long bench_operations(int argc, char* argv[], long default_operations)
+{
+	long n = (argc > 1) ? atol(argv[1]) : 0;
+	return (n > 0) ? n : default_operations;
+}
+
+/** Prints the result line, flushing it before the tracee ends */
+static inline void bench_report(const char* name, long operations, long syscalls, unsigned long long start)
+{
+	unsigned long long elapsed = bench_now() - start;
+	printf("BENCH %s %ld %ld %llu\n", name, operations, syscalls, elapsed);
+	fflush(stdout);
+}
+
+#endif
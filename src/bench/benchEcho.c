@@ -0,0 +1,59 @@
+/*! \file benchEcho.c
+    \brief Benchmark: echo round-trips of 64 bytes between two processes, on a socketpair
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+	An operation is a write() and a read() in each process: 4 syscalls. Run with -p to trace the echoing child too.
+
+    \code
+	./benchEcho [operations]
+    \endcode
+
+ 	\see bench.h ECHOserver.c
+
+*/
+
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "bench.h"
+
+/** Bytes per message */
+#define MESSAGE_SIZE	64
+
+int main(int argc, char* argv[])
+{
+	long i, n = bench_operations(argc, argv, BENCH_DEFAULT_OPERATIONS / 2);
+	char buffer[MESSAGE_SIZE] = "ping";
+	unsigned long long start;
+	int sv[2];
+	pid_t pid;
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0)
+		return 9;
+	pid = fork();
+	if (pid == 0)		// Echoes until the parent closes its end
+	{
+		close(sv[0]);
+		while (read(sv[1], buffer, MESSAGE_SIZE) == MESSAGE_SIZE)
+			write(sv[1], buffer, MESSAGE_SIZE);
+		_exit(0);
+	}
+	if (pid < 0)
+		return 19;
+	close(sv[1]);
+
+	start = bench_now();
+	for(i=0;i<n;i++)
+	{
+		if (write(sv[0], buffer, MESSAGE_SIZE) != MESSAGE_SIZE)
+			return 29;
+		if (read(sv[0], buffer, MESSAGE_SIZE) != MESSAGE_SIZE)		// Messages this small are not split
+			return 39;
+	}
+	bench_report("echo64", n, 4*n, start);
+	close(sv[0]);
+	waitpid(pid, NULL, 0);
+	return 0;
+}
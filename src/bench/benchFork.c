@@ -0,0 +1,38 @@
+/*! \file benchFork.c
+    \brief Benchmark: fork storm, each child exits at once and is waited for
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+	An operation is fork(), _exit() in the child and wait4() in the parent: 3 syscalls.
+
+    \code
+	./benchFork [operations]
+    \endcode
+
+ 	\see bench.h
+
+*/
+
+#include <unistd.h>
+#include <sys/wait.h>
+#include "bench.h"
+
+int main(int argc, char* argv[])
+{
+	long i, n = bench_operations(argc, argv, BENCH_DEFAULT_OPERATIONS / 100);
+	unsigned long long start = bench_now();
+	pid_t pid;
+
+	for(i=0;i<n;i++)
+	{
+		pid = fork();
+		if (pid == 0)
+			_exit(0);
+		if (pid < 0)
+			return 9;
+		waitpid(pid, NULL, 0);
+	}
+	bench_report("fork", n, 3*n, start);
+	return 0;
+}
@@ -0,0 +1,28 @@
+/*! \file benchGetpid.c
+    \brief Benchmark: tight loop of getpid(), the cheapest syscall, to measure the cost of a stop
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+    \code
+	./benchGetpid [operations]
+    \endcode
+
+ 	\see bench.h libpid.c
+
+*/
+
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "bench.h"
+
+int main(int argc, char* argv[])
+{
+	long i, n = bench_operations(argc, argv, 10 * BENCH_DEFAULT_OPERATIONS);
+	unsigned long long start = bench_now();
+
+	for(i=0;i<n;i++)
+		syscall(SYS_getpid);		// Not cached by the libc
+	bench_report("getpid", n, n, start);
+	return 0;
+}
@@ -0,0 +1,39 @@
+/*! \file benchRead.c
+    \brief Benchmark: large read() calls from /dev/zero, where the copy of the kernel dominates
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+    \code
+	./benchRead [operations]
+    \endcode
+
+ 	\see bench.h libio.c
+
+*/
+
+#include <unistd.h>
+#include <fcntl.h>
+#include "bench.h"
+
+/** Bytes per read */
+#define READ_SIZE	(64*1024)
+
+int main(int argc, char* argv[])
+{
+	long i, n = bench_operations(argc, argv, BENCH_DEFAULT_OPERATIONS / 50);
+	char* buffer = (char*)malloc(READ_SIZE);
+	unsigned long long start;
+	int fd = open("/dev/zero", O_RDONLY);
+
+	if ((fd < 0) || (buffer == NULL))
+		return 9;
+	start = bench_now();
+	for(i=0;i<n;i++)
+		if (read(fd, buffer, READ_SIZE) != READ_SIZE)
+			return 19;
+	bench_report("read64k", n, n, start);
+	close(fd);
+	free(buffer);
+	return 0;
+}
@@ -0,0 +1,43 @@
+/*! \file benchThread.c
+    \brief Benchmark: thread storm, each thread ends at once and is joined
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+	An operation is pthread_create() and pthread_join(). Counted as 3 syscalls: clone, exit and the futex wait, the stacks being cached by the libc.
+
+    \code
+	./benchThread [operations]
+    \endcode
+
+ 	\see bench.h
+
+*/
+
+#include <pthread.h>
+#include "bench.h"
+
+/*! Body of the threads, does nothing
+ \param arg unused
+ \return NULL
+*/
+void* thread_body(void* arg)
+{
+	return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+	long i, n = bench_operations(argc, argv, BENCH_DEFAULT_OPERATIONS / 100);
+	unsigned long long start = bench_now();
+	pthread_t thread;
+
+	for(i=0;i<n;i++)
+	{
+		if (pthread_create(&thread, NULL, thread_body, NULL) != 0)
+			return 9;
+		pthread_join(thread, NULL);
+	}
+	bench_report("thread", n, 3*n, start);
+	return 0;
+}
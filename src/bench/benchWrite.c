@@ -0,0 +1,38 @@
+/*! \file benchWrite.c
+    \brief Benchmark: small write() calls to /dev/null
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+    \code
+	./benchWrite [operations]
+    \endcode
+
+ 	\see bench.h libio.c
+
+*/
+
+#include <unistd.h>
+#include <fcntl.h>
+#include "bench.h"
+
+/** Bytes per write */
+#define WRITE_SIZE	16
+
+int main(int argc, char* argv[])
+{
+	long i, n = bench_operations(argc, argv, 10 * BENCH_DEFAULT_OPERATIONS);
+	char buffer[WRITE_SIZE] = "0123456789abcde";
+	unsigned long long start;
+	int fd = open("/dev/null", O_WRONLY);
+
+	if (fd < 0)
+		return 9;
+	start = bench_now();
+	for(i=0;i<n;i++)
+		if (write(fd, buffer, WRITE_SIZE) != WRITE_SIZE)
+			return 19;
+	bench_report("write16", n, n, start);
+	close(fd);
+	return 0;
+}
@@ -0,0 +1,60 @@
+/*! \file libchain.c
+    \brief Pass-through library of the benchmarks, to measure chains of N libraries
+	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+	A BEFORE function on getpid, read and write that does nothing, keeping the result of the kernel.
+	make benchmarks copies it as libchain1.so ... libchain8.so, each copy being loaded separately, so that -l chain1 -l chain2 ... builds a chain.
+
+	\see runBench.sh sandbox_customsyscall_descriptor.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <sys/types.h>
+#include <stdlib.h>
+#include "sandbox_customsyscall_descriptor.h"		//Cumpolsory to interact with sandbox
+#include "syscall_names.h"					//Numbers of the syscalls, by name
+
+/*! Tracee Descriptor*/
+tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = NULL;
+
+/*! Async-signal-safe, the pass-through functions call nothing*/
+const int CUSTOM_LIBRARY_SIGNAL_SAFE = 1;
+
+/** Does nothing, the kernel runs the syscall */
+long int pass(void)
+{
+	return 0;
+}
+
+
+
+/*! Array of Structures, one per custom syscall*/
+custom_syscall_descriptor custom_syscalls_array_chain[] = {
+[SYSCALL_NR_read] = {(long int (*)())pass, NULL, "read", FLAG_KEEP_PREVIOUS_RETURN},
+[SYSCALL_NR_write] = {(long int (*)())pass, NULL, "write", FLAG_KEEP_PREVIOUS_RETURN},
+[SYSCALL_NR_getpid] = {(long int (*)())pass, NULL, "getpid", FLAG_KEEP_PREVIOUS_RETURN}
+};
+
+/*! Library Descriptor*/
+custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
+	NULL,NULL,custom_syscalls_array_chain, sizeof(custom_syscalls_array_chain)/sizeof(custom_syscall_descriptor),"libchain"
+	};
@@ -0,0 +1,100 @@
+/*! \file capture.h
+    \brief Format of the segment files written by libcapture.so, with the full payloads of the I/O syscalls
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * A segment is a capture_header, a fixed amount of capture_index slots, and then the payload area.
+	 * It is created at its full size and mapped with mmap(), the payloads are read from the \b tracee straight into the mapping.
+	 * Each index slot gives the time, TID, process, fd and syscall of a payload, and where it lies in the payload area.
+	 * The descriptors created and closed have a slot too, CAPTURE_OPEN or CAPTURE_CLOSE, so that a reused fd number is told apart.
+	 * When the index or the payload area is full, the library closes the segment and starts the next one, PREFIX.0, PREFIX.1, ...
+	 *
+	 * The segments are read offline by the sandboxcapture tool, which lists the index or rebuilds the stream of every descriptor.
+	 *
+	 * \code
+	 SANDBOX_CAPTURE=/tmp/incident sandbox -p -L bin/libs -l capture <tracee>
+	 sandboxcapture -s /tmp/streams /tmp/incident.*
+	 \endcode
+	 *
+	\see libcapture.c sandboxcapture.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_CAPTURE	//Lock to prevent recursive inclusions
+#define INC_CAPTURE
+
+#include <stdint.h>
+
+/** First bytes of a segment */
+#define CAPTURE_MAGIC				"SBXCAP1"
+/** Version of the format, changes with capture_index */
+#define CAPTURE_VERSION				2
+/** Path prefix of the segments, if SANDBOX_CAPTURE is not set */
+#define CAPTURE_DEFAULT_PREFIX		"/tmp/Sandbox.capture"
+/** Index slots of a segment */
+#define CAPTURE_INDEX_SLOTS			65536
+/** Bytes of the payload area of a segment, if SANDBOX_CAPTURE_SEGMENT is not set */
+#define CAPTURE_DEFAULT_PAYLOAD		(64 << 20)
+
+/** capture_index.direction: bytes read by the tracee */
+#define CAPTURE_IN					1
+/** capture_index.direction: bytes written by the tracee */
+#define CAPTURE_OUT					2
+/** capture_index.direction: the fd was created, by open, socket, accept, dup, pipe... The payload is the path for open, openat and creat */
+#define CAPTURE_OPEN				3
+/** capture_index.direction: the fd was closed. For close_range, the fds up to file_offset */
+#define CAPTURE_CLOSE				4
+
+/** capture_index.flags: the syscall moved more bytes than a whole payload area, only the first ones are kept */
+#define CAPTURE_TRUNCATED			1
+/** capture_index.flags: the memory of the tracee could not be read, the payload is empty */
+#define CAPTURE_UNREADABLE			2
+
+/*! \brief One syscall and where its payload is. Fixed size, 48 bytes */
+typedef struct {
+	uint64_t timestamp_ns;		//!< CLOCK_REALTIME when the syscall ended
+	int32_t tid;				//!< TID of the tracee
+	int32_t tgid;				//!< Process of the TID, the fds are numbered per process
+	int32_t fd;					//!< File descriptor of the syscall
+	uint32_t length;			//!< Bytes of payload
+	uint64_t offset;			//!< Start of the payload, from the start of the payload area
+	int64_t file_offset;		//!< Offset argument of pread64() and pwrite64(), last fd of close_range(), -1 for the others
+	uint16_t nr;				//!< Syscall number
+	uint8_t direction;			//!< CAPTURE_IN, CAPTURE_OUT, CAPTURE_OPEN or CAPTURE_CLOSE
+	uint8_t flags;				//!< CAPTURE_ flags
+	uint32_t reserved;			//!< Padding, 0
+	}
+capture_index;
+
+/*! \brief Start of a segment */
+typedef struct {
+	char magic[8];				//!< CAPTURE_MAGIC
+	uint32_t version;			//!< CAPTURE_VERSION
+	uint32_t index_size;		//!< sizeof(capture_index)
+	uint32_t segment;			//!< Number of the segment, from 0
+	uint32_t index_capacity;	//!< Amount of index slots after the header
+	uint64_t payload_capacity;	//!< Bytes of the payload area, after the index slots
+	uint64_t index_used;		//!< Index slots written
+	uint64_t payload_used;		//!< Bytes of the payload area written
+	}
+capture_header;
+
+#endif
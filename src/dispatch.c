@@ -0,0 +1,111 @@
+/*! \file dispatch.c
+    \brief Launching the tracee with the in-process runtime (option -d)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see dispatch.h libSandboxDispatch.c
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>			// For PATH_MAX
+#include <sys/wait.h>
+
+#include "list.h"
+#include "messages.h"
+#include "dynlib.h"
+#include "dispatch.h"
+
+void warn_signal_unsafe_libraries(void)
+{
+	seek(custom_libs_signal_unsafe, 0);
+	while (has_next(custom_libs_signal_unsafe))
+		eprintf(WARNING_DISPATCH_SIGNAL_UNSAFE_S, (char*)get_next(custom_libs_signal_unsafe));
+}
+
+int prepare_dispatch_environment(void)
+{
+	char runtime_path[PATH_MAX];
+	char pid_value[16];
+	char* libs_value;
+	char* lib_path;
+	char* slash;
+	int len;
+
+	// The runtime is next to the sandbox executable
+	len = readlink("/proc/self/exe", runtime_path, PATH_MAX - sizeof(DISPATCH_RUNTIME_FILE) - 1);
+	if (len < 0)
+		return 9;
+	runtime_path[len] = '\0';
+	slash = strrchr(runtime_path, '/');
+	if (slash == NULL)
+		return 9;
+	strcpy(slash + 1, DISPATCH_RUNTIME_FILE);
+	if (access(runtime_path, R_OK) != 0)
+	{
+		eprintf(ERROR_DISPATCH_RUNTIME_S, runtime_path);
+		return 19;
+	}
+
+	libs_value = (char*)calloc(custom_libs_files->counter, PATH_MAX + 1);
+	if (libs_value == NULL)
+		return 29;
+	seek(custom_libs_files, 0);
+	while (has_next(custom_libs_files))
+	{
+		lib_path = (char*)get_next(custom_libs_files);
+		if (libs_value[0] != '\0')
+			strcat(libs_value, ":");
+		strcat(libs_value, lib_path);
+	}
+
+	sprintf(pid_value, "%d", getpid());		// The PID is kept by execv()
+	if ((setenv("LD_PRELOAD", runtime_path, 1) != 0) || (setenv(DISPATCH_ENV_LIBS, libs_value, 1) != 0) || (setenv(DISPATCH_ENV_PID, pid_value, 1) != 0))
+		return 39;
+	if (childProcessFlag)
+		setenv(DISPATCH_ENV_CHILDREN, "1", 1);
+	free(libs_value);
+	return RETURN_OK;
+}
+
+int wait_dispatched_PID(pid_t pid)
+{
+	int status;
+
+	vprintf(DISPATCH_STARTED_D, pid);
+	while (waitpid(pid, &status, 0) != -1)
+	{
+		if (WIFEXITED(status))
+		{
+			vprintf(TRACEE_EXIT);
+			return WEXITSTATUS(status);
+		}
+		if (WIFSIGNALED(status))
+		{
+			vprintf(TRACEE_EXIT_BY_SIGNAL_D,WTERMSIG(status));
+			return -1;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,68 @@
+/*! \file dispatch.h
+    \brief In-process mode, the custom syscalls run inside the tracee on Syscall User Dispatch
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * With option -d the \b tracee is neither traced nor filtered. The runtime libSandboxDispatch.so is preloaded into it with LD_PRELOAD,
+	 * loads the same custom libraries, and enables PR_SET_SYSCALL_USER_DISPATCH on its threads.
+	 * Every syscall of the \b tracee then raises SIGSYS, and the runtime runs the BEFORE and AFTER chains from the signal handler,
+	 * issuing the real syscall from its own code, the region the kernel lets through. There is no context switch to the Sandbox.
+	 *
+	 * The chains are run by the functions of dynlib.c, with the same flags and return value dragging as trace.c.
+	 * The runtime learns the libraries and options from the environment variables below, set by the Sandbox in the child before execv().
+	 *
+	 * \note Requires Linux 5.11 and a dynamically linked \b tracee
+	 * \note The custom functions run inside a signal handler of the \b tracee, they should not rely on the state of its stdio or heap
+	 * \note clone(), vfork() and fork() are not dispatched, the runtime steps over them to arm the new thread or process
+	 *
+	\see dispatch.c libSandboxDispatch.c dynlib.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_DISPATCH	//Lock to prevent recursive inclusions
+#define INC_DISPATCH
+
+/** File name of the runtime, next to the sandbox executable */
+#define DISPATCH_RUNTIME_FILE	"libSandboxDispatch.so"
+
+/** Environment variable with the full paths of the custom libraries, separated by ':' */
+#define DISPATCH_ENV_LIBS		"SANDBOX_DISPATCH_LIBS"
+/** Environment variable with the PID of the main \b tracee */
+#define DISPATCH_ENV_PID		"SANDBOX_DISPATCH_PID"
+/** Environment variable present if the children and threads of the \b tracee are monitored (option -p) */
+#define DISPATCH_ENV_CHILDREN	"SANDBOX_DISPATCH_CHILDREN"
+
+/*! Warns about the custom libraries not declared async-signal-safe, whose functions may deadlock in the SIGSYS handler of the \b tracee
+*/
+void warn_signal_unsafe_libraries(void);
+
+/*! Prepares the environment of the \b tracee for the runtime. Called by the child, before execv().
+ * \return RETURN_OK if the environment is set, <>RETURN_OK otherwise
+*/
+int prepare_dispatch_environment(void);
+
+/*! Waits for the end of the \b tracee, which runs its custom syscalls itself.
+ * \param pid The PID of the child
+ * \return the exit value of the Tracee, or -1 if terminated by signals
+*/
+int wait_dispatched_PID(pid_t pid);
+
+#endif
@@ -30,18 +30,13 @@ SOFTWARE.
 #include <stdlib.h>
 #include <unistd.h>
 #include <dlfcn.h>					// For Dynamic loading of libraries
+#include <pthread.h>
 #include "list.h"
+#include "hash.h"
 #include "messages.h"
 #include "dynlib.h"					//To have MACROS for these functions
-
-#ifdef __x86_64__
-	#define MAX_SYSCALLS 		316
-	/** Maximum amount of syscalls supported in the architecture*/
-#endif
-#ifdef __i386__
-	#define MAX_SYSCALLS 		358
-	/** Maximum amount of syscalls supported in the architecture*/
-#endif
+#include "arena.h"
+#include "observe.h"
 
 
 
@@ -54,15 +49,50 @@ SOFTWARE.
  */
 list * custom_libs_list;
 
+/** Full paths of the loaded libraries, in loading order. The runtime of option -d loads them again inside the \b tracee. \see dispatch.c */
+list * custom_libs_files;
+
+/** Names of the loaded libraries not declaring CUSTOM_LIBRARY_SIGNAL_SAFE, warned about with option -d. \see dispatch.c */
+list * custom_libs_signal_unsafe;
+
 /*! Structure containting the tracee information. All loaded libraries are linked to this structure so that they can access information about the \b tracee, */
 tracee_descriptor tracee;
 
+/** Execution plan of every syscall number, allocated by build_dispatch_table().
+ * Browsing all the libraries for every syscall stop is avoided, dispatching a syscall costs one array index.
+ */
+syscall_dispatch_entry* dispatch_table = NULL;
+
+int dispatch_table_len = 0;
+
+__thread unsigned int chain_fired_libraries = 0;
+
+char libraries_observe = FALSE;
+
+/** library_states of every thread of the \b tracee that ran a function with FLAG_CONTEXT_HANDLER, by TID */
+hash_table* library_states_table = NULL;
+
+/** library_buffers of every library, in the order of custom_libs_list */
+library_buffers* custom_libs_buffers = NULL;
+
+pthread_mutex_t library_states_lock = PTHREAD_MUTEX_INITIALIZER;	//!< Protects library_states_table, the chains without shared state run concurrently
+
 //-------------------------------------------------------------------------------------------------//
 
 void unload_libraries()
 {
 	custom_library_descriptor* custom_library;
-	
+	int i;
+
+	for(i=0;i<dispatch_table_len;i++)
+	{
+		free(dispatch_table[i].before_chain);
+		free(dispatch_table[i].after_chain);
+	}
+	free(dispatch_table);
+	dispatch_table = NULL;
+	dispatch_table_len = 0;
+
 	seek(custom_libs_list,0);
 	while (has_next(custom_libs_list))
 	{
@@ -75,10 +105,86 @@ void unload_libraries()
 		}
 }
 
+custom_library_descriptor* compile_custom_library_v2(custom_library_v2_descriptor* library_v2, library_buffers* buffers)
+{
+	custom_library_descriptor* custom_library;
+	custom_syscall_entry* entry;
+	int i, j, len = 0;
+
+	if ((library_v2->version != CUSTOM_LIBRARY_VERSION) || (library_v2->syscalls_len < 0) || ((library_v2->syscalls == NULL) && (library_v2->syscalls_len > 0)))
+	{
+		eprintf(ERROR_CUSTOM_LIBRARY_VERSION_S_D_D,library_v2->name,library_v2->version,CUSTOM_LIBRARY_VERSION);
+		return NULL;
+	}
+
+	for(i=0;i<library_v2->syscalls_len;i++)
+	{
+		entry = &(library_v2->syscalls[i]);
+		if ((entry->syscall_number < 0) || (entry->syscall_number >= MAX_SYSCALL_NUMBER))
+		{
+			eprintf(ERROR_CUSTOM_SYSCALL_NUMBER_S_D,entry->handler.name,entry->syscall_number);
+			return NULL;
+		}
+		if (entry->syscall_number >= len)
+			len = entry->syscall_number + 1;
+	}
+
+	// The array keeps the library's custom syscalls reachable by index, as in the first format. It lives as long as the Sandbox
+	custom_library = (custom_library_descriptor*)malloc(sizeof(custom_library_descriptor));
+	if (custom_library == NULL)
+	{
+		eprintf(ERROR_LOADING_CUSTOM_SYSCALL_MALLOC);
+		return NULL;
+	}
+	custom_library->syscall_descriptor_array = (custom_syscall_descriptor*)calloc((len > 0) ? len : 1, sizeof(custom_syscall_descriptor));
+	if (custom_library->syscall_descriptor_array == NULL)
+	{
+		eprintf(ERROR_LOADING_CUSTOM_SYSCALL_MALLOC);
+		free(custom_library);
+		return NULL;
+	}
+	// Pointers to the entries of the library, init() may still set the lengths
+	buffers->by_syscall = (buffer_descriptor**)calloc((len > 0) ? len : 1, sizeof(buffer_descriptor*));
+	if (buffers->by_syscall == NULL)
+	{
+		eprintf(ERROR_LOADING_CUSTOM_SYSCALL_MALLOC);
+		free(custom_library->syscall_descriptor_array);
+		free(custom_library);
+		return NULL;
+	}
+	buffers->len = len;
+	custom_library->syscall_descriptor_array_len = len;
+	custom_library->initialize = library_v2->initialize;
+	custom_library->terminate = library_v2->terminate;
+	snprintf(custom_library->name,NAME_LENGTH,"%s",library_v2->name);
+
+	for(i=0;i<library_v2->syscalls_len;i++)
+	{
+		entry = &(library_v2->syscalls[i]);
+		if (is_valid_custom_syscall(&(custom_library->syscall_descriptor_array[entry->syscall_number])) == RETURN_OK)
+		{
+			eprintf(ERROR_CUSTOM_SYSCALL_NUMBER_S_D,entry->handler.name,entry->syscall_number);
+			free(buffers->by_syscall);
+			free(custom_library->syscall_descriptor_array);
+			free(custom_library);
+			return NULL;
+		}
+		custom_library->syscall_descriptor_array[entry->syscall_number] = entry->handler;
+		for(j=0;j<MAX_BUFFER_ARGUMENTS;j++)
+			if (entry->buffers[j].direction != 0)
+				buffers->by_syscall[entry->syscall_number] = entry->buffers;
+	}
+	vprintf(CUSTOM_LIBRARY_V2_S_D_D,custom_library->name,library_v2->syscalls_len,len);
+	return custom_library;
+}
+
 int add_custom_library(char * filename)
 {
 	custom_library_descriptor* custom_library;
+	custom_library_v2_descriptor* custom_library_v2;
+	library_buffers* buffers;
 	tracee_descriptor** tracee_info;
+	int* signal_safe;
 	void* handle;
 	void *(funtion)(void);
 
@@ -93,12 +199,38 @@ int add_custom_library(char * filename)
 
 		dlerror();		//Clearing any previous error
 
-		custom_library = (custom_library_descriptor*) dlsym(handle, CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL);
-		if (custom_library == NULL)
+		buffers = (library_buffers*)realloc(custom_libs_buffers, (custom_libs_list->counter + 1) * sizeof(library_buffers));
+		if (buffers == NULL)
 		{
-			eprintf(ERROR_LOADING_CUSTOM_SYMBOL_S,CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL);
-			eprintf(ERROR_S,dlerror());
-			return 29;
+			eprintf(ERROR_LOADING_CUSTOM_SYSCALL_MALLOC);
+			return 37;
+		}
+		custom_libs_buffers = buffers;
+		buffers = &(custom_libs_buffers[custom_libs_list->counter]);
+		buffers->by_syscall = NULL;
+		buffers->len = 0;
+
+		// The sparse format is preferred, its list of custom syscalls is compiled into an array owned by the Sandbox
+		custom_library_v2 = (custom_library_v2_descriptor*) dlsym(handle, CUSTOM_LIBRARY_V2_DESCRIPTOR_SYMBOL);
+		if (custom_library_v2 != NULL)
+		{
+			custom_library = compile_custom_library_v2(custom_library_v2, buffers);
+			if (custom_library == NULL)
+			{
+				eprintf(ERROR_LOADING_CUSTOM_LIBRARY_S,filename);
+				return 38;
+			}
+		}
+		else
+		{
+			dlerror();
+			custom_library = (custom_library_descriptor*) dlsym(handle, CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL);
+			if (custom_library == NULL)
+			{
+				eprintf(ERROR_LOADING_CUSTOM_SYMBOL_S,CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL);
+				eprintf(ERROR_S,dlerror());
+				return 29;
+			}
 		}
 		dlerror();
 		tracee_info = (tracee_descriptor**) dlsym(handle, CUSTOM_TRACEE_DESCRIPTOR_SYMBOL);
@@ -120,10 +252,15 @@ int add_custom_library(char * filename)
 			// Library descriptor ok, adding to array
 
 			append_item(custom_libs_list,(custom_library_descriptor*)custom_library);
+			append_item(custom_libs_files,realpath(filename,NULL));
 
 			//Linking the Library's internal Tracee_Info to the Sandbox Tracee structure
 			*(tracee_info) = (tracee_descriptor*) &tracee;
 
+			signal_safe = (int*) dlsym(handle, CUSTOM_LIBRARY_SIGNAL_SAFE_SYMBOL);
+			if ((signal_safe == NULL) || (*signal_safe == 0))
+				append_item(custom_libs_signal_unsafe, custom_library->name);
+
 
 			if ((custom_library->initialize) != NULL)
 				{
@@ -138,8 +275,421 @@ int add_custom_library(char * filename)
 void init_custom_libraries()
 {
 	custom_libs_list = new_list();
+	custom_libs_files = new_list();
+	custom_libs_signal_unsafe = new_list();
+	library_states_table = new_hash_table(16);
 } //End of funtion
 
+/*! Reads the thread group of a thread, from /proc/<tid>/status
+ \param tid The thread
+ \return the TGID, or tid itself if it could not be read
+*/
+pid_t read_tgid(pid_t tid)
+{
+	char path[32];
+	char line[64];
+	FILE* status;
+	pid_t tgid = tid;
+
+	snprintf(path, sizeof(path), "/proc/%d/status", tid);
+	status = fopen(path, "r");
+	if (status == NULL)
+		return tid;
+	while (fgets(line, sizeof(line), status) != NULL)
+		if (sscanf(line, "Tgid: %d", &tgid) == 1)
+			break;
+	fclose(status);
+	return tgid;
+}
+
+library_states* get_library_states(pid_t tid)
+{
+	library_states* states;
+
+	pthread_mutex_lock(&library_states_lock);
+	states = (library_states*)hash_find(library_states_table, tid);
+	if (states == NULL)
+	{
+		states = (library_states*)calloc(1, sizeof(library_states) + custom_libs_list->counter * sizeof(void*));
+		if (states != NULL)
+		{
+			states->tgid = read_tgid(tid);
+			if (hash_insert(library_states_table, tid, states) != 0)
+			{
+				free(states);
+				states = NULL;
+			}
+		}
+	}
+	pthread_mutex_unlock(&library_states_lock);
+	return states;
+}
+
+void release_library_states(pid_t tid)
+{
+	library_states* states;
+
+	pthread_mutex_lock(&library_states_lock);
+	states = (library_states*)hash_find(library_states_table, tid);
+	if (states != NULL)
+	{
+		hash_delete(library_states_table, tid);
+		free(states);
+	}
+	pthread_mutex_unlock(&library_states_lock);
+}
+
+int build_dispatch_table()
+{
+	custom_library_descriptor* custom_library;
+	custom_syscall_descriptor* custom_syscall;
+	syscall_dispatch_entry* entry;
+	int i, k, l;
+
+	// The table covers the generated syscall table, and the highest syscall hooked by any library
+	dispatch_table_len = MAX_SYSCALLS;
+	goto_first(custom_libs_list);
+	while(has_next(custom_libs_list))
+	{
+		custom_library = get_next(custom_libs_list);
+		if (custom_library->syscall_descriptor_array_len > dispatch_table_len)
+			dispatch_table_len = custom_library->syscall_descriptor_array_len;
+	}
+	dispatch_table = (syscall_dispatch_entry*)calloc(dispatch_table_len, sizeof(syscall_dispatch_entry));
+	if (dispatch_table == NULL)
+	{
+		dispatch_table_len = 0;
+		eprintf(ERROR_DISPATCH_MALLOC);
+		return 9;
+	}
+
+	for(i=0;i<dispatch_table_len;i++)
+	{
+		entry = &(dispatch_table[i]);
+		entry->before_chain_len = 0;
+		entry->after_chain_len = 0;
+		entry->flags = 0;
+		entry->needs_exit_stop = FALSE;
+		entry->resolved_at_entry = FALSE;
+		entry->constant_result = FALSE;
+		entry->has_buffers = FALSE;
+
+		// First pass counts the custom syscalls, to allocate the chains at once
+
+		goto_first(custom_libs_list);
+		while(has_next(custom_libs_list))
+		{
+			custom_syscall = get_valid_custom_syscall(get_next(custom_libs_list),i);
+			if (custom_syscall != NULL)
+			{
+				entry->before_chain_len++;
+				if ((custom_syscall->custom_syscall_after) != NULL)
+					entry->after_chain_len++;
+			}
+		}
+		if (entry->before_chain_len == 0)
+			continue;
+
+		entry->before_chain = (custom_syscall_link*)malloc(entry->before_chain_len * sizeof(custom_syscall_link));
+		entry->after_chain = (custom_syscall_link*)malloc(entry->after_chain_len * sizeof(custom_syscall_link));
+		if ((entry->before_chain == NULL) || ((entry->after_chain == NULL) && (entry->after_chain_len > 0)))
+		{
+			eprintf(ERROR_DISPATCH_MALLOC);
+			return 9;
+		}
+
+		// Second pass fills the BEFORE chain in order and the AFTER chain reversed
+
+		k = 0;
+		l = 0;
+		goto_first(custom_libs_list);
+		while(has_next(custom_libs_list))
+		{
+			custom_library = get_next(custom_libs_list);
+			custom_syscall = get_valid_custom_syscall(custom_library,i);
+			if (custom_syscall != NULL)
+			{
+				entry->before_chain[k].library = custom_library;
+				entry->before_chain[k].syscall = custom_syscall;
+				entry->before_chain[k].library_index = l;
+				entry->before_chain[k].buffers = ((i < custom_libs_buffers[l].len) ? custom_libs_buffers[l].by_syscall[i] : NULL);
+				if (entry->before_chain[k].buffers != NULL)
+					entry->has_buffers = TRUE;
+				k++;
+				entry->flags |= custom_syscall->flags;
+				if ((custom_syscall->flags) & FLAG_OBSERVE_ONLY)
+					libraries_observe = TRUE;
+			}
+			l++;
+		}
+		k = 0;
+		l = custom_libs_list->counter;
+		goto_last(custom_libs_list);
+		while(has_next(custom_libs_list))
+		{
+			custom_library = get_previous(custom_libs_list);
+			custom_syscall = get_valid_custom_syscall(custom_library,i);
+			l--;
+			if ((custom_syscall != NULL) && ((custom_syscall->custom_syscall_after) != NULL))
+			{
+				entry->after_chain[k].library = custom_library;
+				entry->after_chain[k].syscall = custom_syscall;
+				entry->after_chain[k].library_index = l;
+				entry->after_chain[k].buffers = ((i < custom_libs_buffers[l].len) ? custom_libs_buffers[l].by_syscall[i] : NULL);
+				k++;
+			}
+		}
+
+		// The arena and the tracee_descriptor are single, a chain using them runs under the lock of the caller
+		entry->shared_state = entry->has_buffers;
+		for(k=0;k<entry->before_chain_len;k++)
+			if (! ((entry->before_chain[k].syscall->flags) & (FLAG_CONTEXT_HANDLER | FLAG_OBSERVE_ONLY)))
+				entry->shared_state = TRUE;
+
+		// Without AFTER functions the kernel return reaches the tracee untouched. A skipped kernel is completed at the entry stop
+		entry->needs_exit_stop = (entry->after_chain_len > 0);
+
+		// The kernel is always skipped if a FLAG_DONT_CALL_KERNEL is reached before any function that may quit the chain
+		entry->resolved_at_entry = ! entry->needs_exit_stop;
+		for(k=0;k<entry->before_chain_len;k++)
+		{
+			custom_syscall = entry->before_chain[k].syscall;
+			if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && ((custom_syscall->custom_syscall_before) != NULL))
+				break;
+			if ((custom_syscall->flags) & FLAG_DONT_CALL_KERNEL)
+			{
+				entry->resolved_at_entry = TRUE;
+				break;
+			}
+		}
+
+		resolve_constant_result(entry);
+	}
+	return RETURN_OK;
+}
+
+int resolve_constant_result(syscall_dispatch_entry* entry)
+{
+	custom_syscall_descriptor* custom_syscall;
+	long int custom_result;
+	long int no_args[ARENA_ARGUMENTS] = {0};
+	syscall_context context = {0};
+	long int value = 0;
+	int known = FALSE;		// The first value dragged along comes from the previous syscall, it is not constant
+	int no_kernel = FALSE;
+	int i;
+
+	entry->constant_result = FALSE;
+	context.args = no_args;
+
+	for(i=0;i<entry->before_chain_len;i++)
+		if (! ((entry->before_chain[i].syscall->flags) & FLAG_CONSTANT_RESULT))
+			return FALSE;
+
+	for(i=0;i<entry->before_chain_len;i++)
+	{
+		custom_syscall = entry->before_chain[i].syscall;
+		if ((custom_syscall->custom_syscall_before) != NULL)
+		{
+			custom_result = (((custom_syscall->flags) & (FLAG_CONTEXT_HANDLER | FLAG_OBSERVE_ONLY)) ? (custom_syscall->custom_syscall_before)(&context) : (custom_syscall->custom_syscall_before)(0,0,0,0,0,0));
+			if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && (custom_result <0) )
+				break;
+			if (! ((custom_syscall->flags) & (FLAG_KEEP_PREVIOUS_RETURN | FLAG_OBSERVE_ONLY)) )
+			{
+				value = custom_result;
+				known = TRUE;
+			}
+		}
+		if (((custom_syscall->flags) & FLAG_DONT_CALL_KERNEL))
+			no_kernel = TRUE;
+	}
+	if (! no_kernel)
+		return FALSE;
+
+	for(i=0;i<entry->after_chain_len;i++)
+	{
+		custom_syscall = entry->after_chain[i].syscall;
+		custom_result = (((custom_syscall->flags) & (FLAG_CONTEXT_HANDLER | FLAG_OBSERVE_ONLY)) ? (custom_syscall->custom_syscall_after)(&context) : (custom_syscall->custom_syscall_after)(0,0,0,0,0,0));
+		if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && (custom_result <0) )
+			break;
+		if (! ((custom_syscall->flags) & (FLAG_KEEP_PREVIOUS_RETURN | FLAG_OBSERVE_ONLY)) )
+		{
+			value = custom_result;
+			known = TRUE;
+		}
+	}
+
+	// SECCOMP_RET_ERRNO can only deliver 0 or -errno to the tracee
+	if ((! known) || (value > 0) || (value < -MAX_ERRNO_VALUE))
+		return FALSE;
+
+	entry->constant_result = TRUE;
+	entry->constant_value = value;
+	return TRUE;
+}
+
+syscall_dispatch_entry* get_dispatch_entry(int syscall_number)
+{
+	if ((syscall_number < 0) || (syscall_number >= dispatch_table_len))
+		return NULL;
+	if (dispatch_table[syscall_number].before_chain_len == 0)
+		return NULL;
+	return &(dispatch_table[syscall_number]);
+}
+
+/*! Copies the context into the tracee_descriptor, read by the functions without FLAG_CONTEXT_HANDLER and by the arena
+ \param context The syscall being processed
+*/
+void share_context(syscall_context* context)
+{
+	tracee.trace_PID = context->tid;
+	tracee.return_value = context->return_value;
+	tracee.kernel_return_value = context->kernel_return_value;
+	tracee.kernel_executed = context->kernel_executed;
+}
+
+/*! Calls a BEFORE or AFTER function, with the 6 arguments or, with FLAG_CONTEXT_HANDLER, with its own copy of the context.
+ * The states of the thread are looked up at the first context handler of the chain.
+ * A function with FLAG_OBSERVE_ONLY is a context handler without state, put in the queue of the worker if it runs.
+ \param function The BEFORE or AFTER function of the custom syscall
+ \param link The custom syscall, for its flags, the slot of its library in the states and its memory arguments
+ \param context The syscall being processed
+ \param call_args The arguments passed to the function, with the memory arguments in the arena
+ \param states The states of the thread, NULL until needed
+ \return the value returned by the function, 0 for an observe-only one
+*/
+long int call_custom_function(long int (*function)(), custom_syscall_link* link, syscall_context* context, long int* call_args, library_states** states)
+{
+	custom_syscall_descriptor* custom_syscall = link->syscall;
+	syscall_context library_context;
+
+	if (! ((custom_syscall->flags) & (FLAG_CONTEXT_HANDLER | FLAG_OBSERVE_ONLY)))
+		return function(call_args[0],call_args[1],call_args[2],call_args[3],call_args[4],call_args[5]);
+
+	if (*states == NULL)
+		*states = get_library_states(context->tid);
+	library_context = *context;
+	library_context.args = call_args;
+	library_context.state = NULL;
+	if (*states != NULL)
+	{
+		library_context.state = &((*states)->slots[link->library_index]);
+		if (library_context.tgid == 0)
+			library_context.tgid = (*states)->tgid;
+	}
+	if ((custom_syscall->flags) & FLAG_OBSERVE_ONLY)
+	{
+		// The thread may end, and its slots be released, before the worker runs the call
+		library_context.state = NULL;
+		if (observe_running)
+			observe_enqueue(function, link->buffers, &library_context);
+		else
+			function(&library_context);
+		return 0;
+	}
+	return function(&library_context);
+}
+
+int execute_before_chain(syscall_dispatch_entry* entry, syscall_context* context)
+{
+	custom_syscall_descriptor* custom_syscall;
+	long int custom_result;
+	long int function_args[ARENA_ARGUMENTS];
+	long int* args = context->args;
+	long int* call_args = args;
+	library_states* states = NULL;
+	int no_kernel = FALSE;
+	int i;
+
+	chain_fired_libraries = 0;
+	if (entry->shared_state)
+		share_context(context);
+	if (entry->has_buffers)
+	{
+		arena_begin(entry, args, FALSE);
+		call_args = function_args;
+	}
+	for(i=0;i<entry->before_chain_len;i++)
+	{
+		custom_syscall = entry->before_chain[i].syscall;
+		vprintf(CUSTOM_SYSCALL_CATCHED_S_FROM_S,custom_syscall->name,entry->before_chain[i].library->name );
+
+		if ((custom_syscall->custom_syscall_before) != NULL)
+		{
+			vprintf(CUSTOM_SYSCALL_CALLED_BEFORE );
+			if (call_args != args)
+				arena_function_args(entry->before_chain[i].buffers, args, function_args);
+			custom_result = call_custom_function(custom_syscall->custom_syscall_before, &(entry->before_chain[i]), context, call_args, &states);
+			chain_fired_libraries |= LIBRARY_BIT(entry->before_chain[i].library_index);
+
+			// Executing the Custom Syscall and keeping the result value
+
+			if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && (custom_result <0) )
+				break; //Quit of error option
+
+			if (! ((custom_syscall->flags) & (FLAG_KEEP_PREVIOUS_RETURN | FLAG_OBSERVE_ONLY)) )
+			{
+				context->return_value = custom_result; // If not said the opossite, drag the return code along
+				if (entry->shared_state)
+					tracee.return_value = custom_result;
+			}
+
+		} // End If execute before
+
+		if (((custom_syscall->flags) & FLAG_DONT_CALL_KERNEL))
+		{
+			//If kernel syscall is not to be called
+			vprintf(CUSTOM_SYSCALL_NOKERNEL );
+			no_kernel = TRUE;
+		}
+		vprintf(LF_CR);
+	}
+	if (call_args != args)
+		arena_end(FALSE);
+	return no_kernel;
+}
+
+void execute_after_chain(syscall_dispatch_entry* entry, syscall_context* context)
+{
+	custom_syscall_descriptor* custom_syscall;
+	long int custom_result;
+	long int function_args[ARENA_ARGUMENTS];
+	long int* args = context->args;
+	long int* call_args = args;
+	library_states* states = NULL;
+	int i;
+
+	if (entry->shared_state)
+		share_context(context);
+	if ((entry->has_buffers) && (entry->after_chain_len > 0))
+	{
+		arena_begin(entry, args, TRUE);
+		call_args = function_args;
+	}
+
+	for(i=0;i<entry->after_chain_len;i++)
+	{
+		custom_syscall = entry->after_chain[i].syscall;
+		vprintf(CUSTOM_SYSCALL_CALLED_AFTER );
+		if (call_args != args)
+			arena_function_args(entry->after_chain[i].buffers, args, function_args);
+		custom_result = call_custom_function(custom_syscall->custom_syscall_after, &(entry->after_chain[i]), context, call_args, &states);
+		chain_fired_libraries |= LIBRARY_BIT(entry->after_chain[i].library_index);
+
+		//Executing the Custom Syscall and keeping the result value
+		if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && (custom_result <0) )
+			break;//Quit of error option
+		if (! ((custom_syscall->flags) & (FLAG_KEEP_PREVIOUS_RETURN | FLAG_OBSERVE_ONLY)) )
+		{
+			context->return_value = custom_result;
+			if (entry->shared_state)
+				tracee.return_value = custom_result;
+		}
+	}
+	if (call_args != args)
+		arena_end(TRUE);
+}
+
 custom_syscall_descriptor* get_valid_custom_syscall(custom_library_descriptor* library_descriptor, int syscall_number)
 {
 	custom_syscall_descriptor* syscall_desc = NULL;
@@ -175,7 +725,7 @@ void print_syscall_descriptor(custom_syscall_descriptor* custom_syscall )
 int is_valid_custom_library(custom_library_descriptor* library_descriptor)
 {
 	return (	//cond 1 = Array length within boundaries
-			(library_descriptor->syscall_descriptor_array_len >= 0 ) && (library_descriptor->syscall_descriptor_array_len < MAX_SYSCALLS)
+			(library_descriptor->syscall_descriptor_array_len >= 0 ) && (library_descriptor->syscall_descriptor_array_len <= MAX_SYSCALL_NUMBER)
 		&&  //cond 1 = Array pointer is not NULL
 			(library_descriptor->syscall_descriptor_array != NULL)
 	) ? RETURN_OK: 9;
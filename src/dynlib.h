@@ -34,15 +34,81 @@ SOFTWARE.
 
 #include "sandbox_customsyscall_descriptor.h"
 #include "list.h"
-
-
+#include "syscall_names.h"
+
+/** Maximum amount of syscalls supported in the architecture, the ones of its generated table. \see syscalls.h */
+#define MAX_SYSCALLS 		SYSCALL_TABLE_LEN
+
+/** Bit of a library in chain_fired_libraries, 0 beyond the 32nd library */
+#define LIBRARY_BIT(index)	(((index) < 32) ? (1U << (index)) : 0)
+
+/** Highest errno that a syscall can return, as -errno */
+#define MAX_ERRNO_VALUE		4095
+
+/*! \brief A custom syscall in an execution chain, together with the library it belongs to */
+typedef struct {
+	custom_library_descriptor* library;	//!< Library implementing the custom syscall
+	custom_syscall_descriptor* syscall;	//!< Custom syscall descriptor, inside the library
+	int library_index;					//!< Position of the library in custom_libs_list, from 0
+	buffer_descriptor* buffers;			//!< Its MAX_BUFFER_ARGUMENTS memory arguments, inside the library. NULL if it declares none
+	}
+custom_syscall_link;
+
+/*! \brief Memory arguments declared by the custom syscalls of a library, by syscall number.
+ * Only the sparse format declares them, in custom_syscall_entry.buffers: the array format keeps its first layout */
+typedef struct {
+	buffer_descriptor** by_syscall;		//!< The buffers of the entry of each syscall number, NULL if none. NULL for the array format
+	int len;							//!< Amount of elements in by_syscall
+	}
+library_buffers;
+
+/*! \brief Precomputed execution plan of a syscall number, built once all the libraries are loaded */
+typedef struct {
+	custom_syscall_link* before_chain;	//!< All the custom syscalls for this number, in the order of the libraries. NULL if none
+	custom_syscall_link* after_chain;	//!< The custom syscalls having an AFTER function, in reverse order of the libraries
+	int before_chain_len;				//!< Amount of elements in before_chain
+	int after_chain_len;				//!< Amount of elements in after_chain
+	char flags;							//!< OR of the flags of all the custom syscalls in the chain
+	char needs_exit_stop;				//!< TRUE if an AFTER function needs the syscall-exit-stop
+	char resolved_at_entry;				//!< TRUE if the chain completes at the entry: no AFTER function, or the kernel is always skipped
+	char constant_result;				//!< TRUE if the chain always returns constant_value without kernel, so the seccomp filter answers it
+	char has_buffers;					//!< TRUE if a custom syscall of the chain declares memory arguments, copied through the arena. \see arena.h
+	char shared_state;					//!< TRUE if the chain uses the tracee_descriptor or the arena, single for all the tracees: the caller runs it under its lock
+	long int constant_value;			//!< Return value of the chain, only meaningful if constant_result is TRUE
+	}
+syscall_dispatch_entry;
+
+/*! \brief State of the libraries for a thread of the \b tracee, passed to the functions with FLAG_CONTEXT_HANDLER */
+typedef struct {
+	pid_t tgid;			//!< Process of the thread, read once
+	void* slots[];		//!< syscall_context.state of each library, in the order of custom_libs_list
+	}
+library_states;
 
 /** List of pointers to library descriptors */
 extern list* custom_libs_list;
 
+/** List of the full paths of the loaded libraries */
+extern list* custom_libs_files;
+
+/** List of the names of the loaded libraries not declared async-signal-safe */
+extern list* custom_libs_signal_unsafe;
+
+/** Execution plan of every syscall number, indexed by syscall number. \see build_dispatch_table() */
+extern syscall_dispatch_entry* dispatch_table;
+
+/** Amount of entries in dispatch_table: MAX_SYSCALLS, or more if a library hooks a higher syscall number */
+extern int dispatch_table_len;
+
 /*! Structure containting the tracee information. */
 extern tracee_descriptor tracee;
 
+/** TRUE if a loaded library has functions with FLAG_OBSERVE_ONLY, the Sandbox starts the worker of observe.h */
+extern char libraries_observe;
+
+/** Bit i is set if a function of the i-th library ran in the last BEFORE and AFTER chains of the calling thread, for the first 32 libraries */
+extern __thread unsigned int chain_fired_libraries;
+
 /*! Unloads the dynamic libraries, if any. Also frees the allocated memory for the custom syscall descriptors, if any.
  *
  * While unloading, the terminate() functions of each library is called
@@ -52,7 +118,8 @@ void unload_libraries();
 
 /*! \brief Adds a given custom library to the list, if it passes the checks.
  * Checks the library pointed by the argument and, if OK, adds it to the array of libraries descriptors custom_libs_list.
- * To work, the library being added MUST have a valid structure custom_library_descriptor inside, called like the macro CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL.
+ * To work, the library being added MUST have a valid structure custom_library_descriptor inside, called like the macro CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL,
+ * or a custom_library_v2_descriptor called like the macro CUSTOM_LIBRARY_V2_DESCRIPTOR_SYMBOL, which is then compiled by compile_custom_library_v2().
  * To work, the library being added MUST have a structure pointer tracee_descriptor inside, called like the MACRO CUSTOM_TRACEE_DESCRIPTOR_SYMBOL.
  * When loading the library, the initialize() method of the library is called
  * When loading the library, the internal  tracee_descriptor is pointed to the location where is information resides in the Sandbox.
@@ -62,10 +129,71 @@ void unload_libraries();
 */
 int add_custom_library(char * filename);
 
+/*! Compiles the sparse descriptor of a library into a custom_library_descriptor, allocated by the Sandbox.
+ * Its array is indexed by syscall number up to the highest one listed, the other slots are left empty.
+ * \param library_v2 is the descriptor found in the library
+ * \param buffers receives the memory arguments of its entries, by syscall number
+ * \return the compiled descriptor, or NULL if the version is unknown, a syscall number is out of range or repeated, or memory could not be allocated
+*/
+custom_library_descriptor* compile_custom_library_v2(custom_library_v2_descriptor* library_v2, library_buffers* buffers);
+
 /*! Initializes the structure to hold the custom libraries
 */
 void init_custom_libraries();
 
+/*! Builds the dispatch_table from the libraries in custom_libs_list.
+ * The table is allocated with dispatch_table_len entries, enough for the highest syscall number of all libraries.
+ * For each syscall number, the custom syscalls of all libraries are placed in the BEFORE chain (in order) and the AFTER chain (reversed).
+ * \pre All the custom libraries are loaded
+ * \return RETURN_OK if the table was built, <>RETURN_OK if memory could not be allocated
+*/
+int build_dispatch_table();
+
+/*! Checks if the chain of a syscall can be answered by the seccomp filter, setting constant_result and constant_value.
+ * All the custom syscalls of the chain must have FLAG_CONSTANT_RESULT, the kernel must be skipped, and the result must be 0 or an errno (-1 to -4095).
+ * The chain is evaluated once, with null arguments, following the same flags as execute_before_chain() and execute_after_chain().
+ * \param entry is the execution plan of the syscall
+ * \return TRUE if the chain is constant, FALSE otherwise
+*/
+int resolve_constant_result(syscall_dispatch_entry* entry);
+
+/*! Gets the execution plan for a syscall.
+ * \param syscall_number The number of the requested syscall.
+ * \return the entry in dispatch_table, or NULL if no library implements the syscall
+*/
+syscall_dispatch_entry* get_dispatch_entry(int syscall_number);
+
+/*! Gets the states of the libraries for a thread, created empty at its first call.
+ * \param tid The thread of the \b tracee
+ * \return the states, or NULL if memory could not be allocated
+*/
+library_states* get_library_states(pid_t tid);
+
+/*! Forgets the states of the libraries for a thread that ended. What the slots point to belongs to the libraries.
+ * \param tid The thread of the \b tracee
+*/
+void release_library_states(pid_t tid);
+
+/*! Executes the BEFORE functions of the chain, from the first library to the last.
+ * The return value is dragged along in context->return_value, according to the flags of each custom syscall.
+ * If the chain has shared_state, tracee is filled from the context first, and the caller must hold its lock.
+ * The declared memory arguments are passed as pointers into the arena, and written back when the chain ends.
+ * chain_fired_libraries is reset, then marks the libraries whose function ran.
+ * \param entry is the execution plan of the syscall
+ * \param context is the syscall being processed. Its 6 arguments are passed to each custom function
+ * \return TRUE if any custom syscall asked not to call the kernel, FALSE otherwise
+*/
+int execute_before_chain(syscall_dispatch_entry* entry, syscall_context* context);
+
+/*! Executes the AFTER functions of the chain, from the last library to the first.
+ * The return value is dragged along in context->return_value, according to the flags of each custom syscall.
+ * If the chain has shared_state, tracee is filled from the context first, and the caller must hold its lock.
+ * The declared memory arguments are passed as pointers into the arena, and written back when the chain ends.
+ * \param entry is the execution plan of the syscall
+ * \param context is the syscall being processed. Its 6 arguments are passed to each custom function
+*/
+void execute_after_chain(syscall_dispatch_entry* entry, syscall_context* context);
+
 /*! Looks if there is a custom syscall registered for execution in the library.
  * Internally checks for validity of the structure, using \c is_valid_customsyscall().
  * \param syscall_number The number of the requested syscall.
@@ -0,0 +1,125 @@
+/*! \file eventlog.c
+    \brief Binary log of the syscalls completed by the tracer, in a preallocated ring file (option -o)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see eventlog.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+#include "list.h"
+#include "messages.h"
+#include "dynlib.h"
+#include "stats.h"			// For stats_now()
+#include "eventlog.h"
+
+eventlog_header* event_log = NULL;		//!< The mapped file, NULL if there is no log
+event_record* event_slots = NULL;		//!< The record slots, right after the header
+size_t event_log_size = 0;				//!< Size of the mapping
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+int open_event_log(char* filename)
+{
+	custom_library_descriptor* custom_library;
+	int fd;
+	int i = 0;
+
+	fd = open(filename, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+	{
+		eprintf(ERROR_EVENTLOG_S, filename);
+		return 9;
+	}
+	// Preallocated, the records never extend the file
+	event_log_size = sizeof(eventlog_header) + (size_t)EVENTLOG_RECORDS * sizeof(event_record);
+	if (posix_fallocate(fd, 0, event_log_size) != 0)
+	{
+		close(fd);
+		eprintf(ERROR_EVENTLOG_S, filename);
+		return 19;
+	}
+	event_log = (eventlog_header*)mmap(NULL, event_log_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (event_log == MAP_FAILED)
+	{
+		event_log = NULL;
+		eprintf(ERROR_EVENTLOG_S, filename);
+		return 29;
+	}
+	event_slots = (event_record*)(event_log + 1);
+
+	memcpy(event_log->magic, EVENTLOG_MAGIC, sizeof(event_log->magic));
+	event_log->version = EVENTLOG_VERSION;
+	event_log->record_size = sizeof(event_record);
+	event_log->capacity = EVENTLOG_RECORDS;
+	event_log->written = 0;
+
+	seek(custom_libs_list, 0);
+	while ((has_next(custom_libs_list)) && (i < EVENTLOG_MAX_LIBRARIES))
+	{
+		custom_library = (custom_library_descriptor*)get_next(custom_libs_list);
+		strncpy(event_log->libraries[i], custom_library->name, EVENTLOG_NAME_LENGTH-1);
+		i++;
+	}
+	event_log->libraries_len = i;
+	vprintf(EVENTLOG_OPEN_S_D, filename, EVENTLOG_RECORDS);
+	return RETURN_OK;
+}
+
+void record_event(int tid, int nr, long int* args, long int kernel_return, long int final_return, unsigned int libraries, unsigned int flags)
+{
+	event_record* record;
+	uint64_t sequence;
+	int i;
+
+	if (event_log == NULL)
+		return;
+
+	sequence = __atomic_fetch_add(&(event_log->written), 1, __ATOMIC_RELAXED);
+	record = &(event_slots[sequence % EVENTLOG_RECORDS]);
+	record->timestamp_ns = stats_now();
+	record->tid = tid;
+	record->nr = nr;
+	for(i=0;i<6;i++)
+		record->args[i] = args[i];
+	record->kernel_return = kernel_return;
+	record->final_return = final_return;
+	record->libraries = libraries;
+	record->flags = flags;
+	__atomic_store_n(&(record->sequence), sequence, __ATOMIC_RELEASE);	// Last, the decoder trusts a slot whose sequence matches
+}
+
+void close_event_log(void)
+{
+	if (event_log == NULL)
+		return;
+	msync(event_log, event_log_size, MS_ASYNC);
+	munmap(event_log, event_log_size);
+	event_log = NULL;
+}
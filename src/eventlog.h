@@ -0,0 +1,109 @@
+/*! \file eventlog.h
+    \brief Binary log of the syscalls completed by the tracer, in a preallocated ring file (option -o)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * The file is an eventlog_header followed by a fixed amount of event_record slots, created at its full size and mapped with mmap().
+	 * Recording an event is an atomic increment of the header counter and a copy into the slot, there is no formatting and no syscall.
+	 * When the slots are full, the oldest records are overwritten.
+	 *
+	 * The records are decoded offline by the sandboxlog tool, into text, CSV or JSON.
+	 *
+	 * \code
+	 sandbox -o /tmp/trace.log -L bin/libs -l pid bin/tests/testLibPID
+	 sandboxlog -f csv /tmp/trace.log
+	 \endcode
+	 *
+	\see eventlog.c sandboxlog.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_EVENTLOG	//Lock to prevent recursive inclusions
+#define INC_EVENTLOG
+
+#include <stdint.h>
+
+/** First bytes of a log file */
+#define EVENTLOG_MAGIC			"SBXLOG1"
+/** Version of the format, changes with event_record */
+#define EVENTLOG_VERSION		1
+/** Amount of records in a new log file */
+#define EVENTLOG_RECORDS		65536
+/** Libraries named in the header, as many as bits in event_record.libraries */
+#define EVENTLOG_MAX_LIBRARIES	32
+/** Length of the library names in the header */
+#define EVENTLOG_NAME_LENGTH	24
+
+/** event_record.flags: the kernel executed the syscall */
+#define EVENT_KERNEL_EXECUTED	1
+/** event_record.flags: the returns are unknown, the tracee was resumed without exit stop */
+#define EVENT_NO_RETURN			2
+/** event_record.flags: a custom library implements the syscall */
+#define EVENT_CUSTOM			4
+
+/*! \brief One syscall, as completed by the tracer. Fixed size, 96 bytes */
+typedef struct {
+	uint64_t timestamp_ns;		//!< CLOCK_MONOTONIC when the record was written
+	int32_t tid;				//!< TID of the tracee
+	int32_t nr;					//!< Syscall number
+	int64_t args[6];			//!< Arguments at the entry
+	int64_t kernel_return;		//!< Return of the kernel, if EVENT_KERNEL_EXECUTED
+	int64_t final_return;		//!< Return delivered to the tracee
+	uint32_t libraries;			//!< Bit i set if a function of the i-th library ran
+	uint32_t flags;				//!< EVENT_ flags
+	uint64_t sequence;			//!< Number of the record since the start, to spot slots being rewritten
+	}
+event_record;
+
+/*! \brief Start of the log file */
+typedef struct {
+	char magic[8];				//!< EVENTLOG_MAGIC
+	uint32_t version;			//!< EVENTLOG_VERSION
+	uint32_t record_size;		//!< sizeof(event_record)
+	uint64_t capacity;			//!< Amount of record slots after the header
+	uint64_t written;			//!< Records written since the start. The next one goes into slot (written % capacity)
+	uint32_t libraries_len;		//!< Amount of names in libraries
+	uint32_t reserved;			//!< Padding
+	char libraries[EVENTLOG_MAX_LIBRARIES][EVENTLOG_NAME_LENGTH];	//!< Names of the loaded libraries, in loading order
+	}
+eventlog_header;
+
+/*! Creates the log file at its full size and maps it. Names the loaded libraries in the header
+ * \param filename Path of the file, truncated if it exists
+ * \return RETURN_OK if the log is ready, <>RETURN_OK otherwise
+*/
+int open_event_log(char* filename);
+
+/*! Appends a record. Does nothing if the log is not open. Safe from several tracer threads
+ * \param tid TID of the tracee
+ * \param nr Syscall number
+ * \param args The 6 arguments
+ * \param kernel_return Return of the kernel
+ * \param final_return Return delivered to the tracee
+ * \param libraries Libraries that ran, as chain_fired_libraries
+ * \param flags EVENT_ flags
+*/
+void record_event(int tid, int nr, long int* args, long int kernel_return, long int final_return, unsigned int libraries, unsigned int flags);
+
+/*! Flushes and unmaps the log */
+void close_event_log(void);
+
+#endif
@@ -0,0 +1,179 @@
+/*! \file filter.c
+    \brief Functions building and installing the seccomp pre-filter of the tracee
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see filter.h
+
+	\internal
+
+	* The program is a flat list of comparisons on the syscall number:
+	\code
+	 load arch ; if arch != native -> ALLOW
+	 load nr
+	 if nr == A -> TRACE
+	 if nr == B -> TRACE
+	 if nr == C -> ERRNO(value)
+	 if nr == D -> USER_NOTIF		(option -u)
+	 ...
+	 ALLOW					(TRACE with option -c)
+	\endcode
+	* A syscall only appears once, no matter how many libraries implement it.
+	* A syscall whose chain is constant (FLAG_CONSTANT_RESULT) returns SECCOMP_RET_ERRNO with its value instead of stopping the \b tracee.
+	* Only with option -p: the children inherit the filter, and without -p their syscalls must reach the kernel untouched.
+	* BPF jumps are relative and limited to 255 instructions, so every comparison jumps at most 1 instruction.
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <stddef.h>				// For offsetof()
+#include <sys/prctl.h>			// For PR_SET_NO_NEW_PRIVS
+#include <sys/syscall.h>		// For syscall(SYS_seccomp)
+#include <linux/filter.h>		// BPF instructions
+#include <linux/seccomp.h>		// Seccomp return values
+#include <linux/audit.h>		// Architecture identifiers
+
+#include "messages.h"
+#include "dynlib.h"
+#include "filter.h"
+#include "replay.h"
+#include "syscalls.h"
+
+#ifdef __x86_64__
+	#define FILTER_ARCH	AUDIT_ARCH_X86_64
+	//!< Architecture the custom libraries are numbered for
+#endif
+#ifdef __i386__
+	#define FILTER_ARCH	AUDIT_ARCH_I386
+	//!< Architecture the custom libraries are numbered for
+#endif
+
+/** Instructions needed before and after the syscall comparisons: arch load, arch check, allow, nr load, final allow */
+#define FILTER_FIXED_INSTRUCTIONS	5
+
+struct sock_filter* filter_program = NULL;	//!< BPF instructions of the filter, allocated by build_syscall_filter()
+unsigned short filter_program_len = 0;		//!< Amount of instructions in filter_program
+int filter_traced_syscalls = 0;				//!< Amount of syscalls for which the filter returns SECCOMP_RET_TRACE
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+int filter_answers(syscall_dispatch_entry* entry)
+{
+	// The filter is inherited by every child: without -p the children are not monitored, the tracer lets their syscalls through
+	return (entry != NULL) && (entry->constant_result) && (childProcessFlag) && (! statsFlag);
+}
+
+int build_syscall_filter(void)
+{
+	int i, traced = 0, constant = 0;
+	struct sock_filter* instruction;
+	syscall_dispatch_entry* entry;
+	unsigned int action;
+
+	for(i=0;i<dispatch_table_len;i++)
+	{
+		entry = get_dispatch_entry(i);
+		if (entry == NULL)
+		{
+			if (replay_traced_syscall(i))
+				traced++;
+			continue;
+		}
+		if (filter_answers(entry))
+			constant++;
+		else
+			traced++;
+	}
+
+	filter_program_len = FILTER_FIXED_INSTRUCTIONS + 2*(traced+constant);
+	filter_program = (struct sock_filter*)malloc(filter_program_len * sizeof(struct sock_filter));
+	if (filter_program == NULL)
+	{
+		eprintf(ERROR_FILTER_MALLOC);
+		return 9;
+	}
+
+	instruction = filter_program;
+	*(instruction++) = (struct sock_filter)BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, arch));
+	*(instruction++) = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, FILTER_ARCH, 1, 0);
+	*(instruction++) = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW);
+	*(instruction++) = (struct sock_filter)BPF_STMT(BPF_LD | BPF_W | BPF_ABS, offsetof(struct seccomp_data, nr));
+
+	for(i=0;i<dispatch_table_len;i++)
+	{
+		entry = get_dispatch_entry(i);
+		if ((entry == NULL) && (! replay_traced_syscall(i)))
+			continue;
+
+		if (entry == NULL)		// Recorded or replayed, -R or -P
+		{
+			action = SECCOMP_RET_TRACE;
+			filter_traced_syscalls++;
+		}
+		else if (filter_answers(entry))		// The kernel returns the value of the chain, -errno or 0
+		{
+			action = SECCOMP_RET_ERRNO | ((-(entry->constant_value)) & SECCOMP_RET_DATA);
+			vprintf(FILTER_ANSWERS_S_D_LD, syscall_name(i), i, entry->constant_value);
+		}
+		else if ((userNotifFlag) && (entry->resolved_at_entry))		// The supervisor answers it, without ptrace
+			action = SECCOMP_RET_USER_NOTIF;
+		else
+		{
+			action = SECCOMP_RET_TRACE;
+			filter_traced_syscalls++;
+		}
+
+		// Not equal jumps over the RET, equal falls into it
+		*(instruction++) = (struct sock_filter)BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, i, 0, 1);
+		*(instruction++) = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, action);
+	}
+
+	// With -c all the syscalls are counted, all of them stop the tracee
+	*(instruction++) = (struct sock_filter)BPF_STMT(BPF_RET | BPF_K, (statsFlag ? SECCOMP_RET_TRACE : SECCOMP_RET_ALLOW));
+
+	vprintf(FILTER_BUILT_D_D,traced,constant);
+	return RETURN_OK;
+}
+
+int install_syscall_filter(void)
+{
+	struct sock_fprog program;
+
+	if (filter_program == NULL)
+		return 9;
+
+	program.len = filter_program_len;
+	program.filter = filter_program;
+
+	if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0))
+	{
+		perror("prctl: ");
+		return 19;
+	}
+	// With -u the kernel returns a listener fd, the Sandbox takes it at the exit of this syscall. \see notify.c
+	if (syscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, (userNotifFlag ? SECCOMP_FILTER_FLAG_NEW_LISTENER : 0), &program) < 0)
+	{
+		perror("seccomp: ");
+		return 29;
+	}
+	return RETURN_OK;
+}
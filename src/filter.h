@@ -0,0 +1,74 @@
+/*! \file filter.h
+    \brief Functions dedicated to the seccomp pre-filter installed in the tracee
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * Only the syscalls implemented by at least one of the loaded custom libraries need to stop the \b tracee.
+	 * A seccomp BPF program is built from the union of all the custom_syscall_descriptor arrays, returning SECCOMP_RET_TRACE for those syscalls and SECCOMP_RET_ALLOW for all the others.
+	 * Syscalls with a constant chain (see FLAG_CONSTANT_RESULT) are answered by the filter itself with SECCOMP_RET_ERRNO, with option -p.
+	 * With option -c, all the syscalls return SECCOMP_RET_TRACE, to be counted. With options -R and -P, so do the replayable ones (see replay.h).
+	 * With option -u, the syscalls completed at their entry return SECCOMP_RET_USER_NOTIF, and are answered by the supervisor (notify.c) instead of ptrace.
+	 *
+	 * The filter is built by the Sandbox once the libraries are loaded, and installed by the \b tracee itself just before execv().
+	 * The tracer is then woken up by PTRACE_EVENT_SECCOMP stops only, all other syscalls run at native speed.
+	 *
+	\see filter.c sandbox.c trace.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_FILTER	//Lock to prevent recursive inclusions
+#define INC_FILTER
+
+#include "dynlib.h"
+
+/*! Builds the seccomp BPF program from the custom libraries, as found in the dispatch_table.
+ *
+ * Each syscall implemented by any library makes the filter return SECCOMP_RET_TRACE, every other syscall is allowed.
+ * Syscalls from a foreign architecture (i.e. i386 calls on x86_64) are always allowed, as the libraries are numbered for the native one.
+ * \pre The dispatch_table must be built already
+ * \return RETURN_OK if the program was built, <>RETURN_OK otherwise
+*/
+int build_syscall_filter(void);
+
+/** Amount of syscalls for which the filter returns SECCOMP_RET_TRACE, set by build_syscall_filter(). If 0 with option -u, ptrace is not needed */
+extern int filter_traced_syscalls;
+
+/*! Tells if the filter answers a syscall by itself, with SECCOMP_RET_ERRNO, so that the tracer never sees it.
+ *
+ * Only constant chains (see FLAG_CONSTANT_RESULT) with option -p: the filter is inherited by the children of the \b tracee,
+ * and without -p they are not monitored. Never with -c, every syscall is counted.
+ * These syscalls are not in the event log of option -o nor in the messages of -v, build_syscall_filter() names them with -v.
+ * \param entry of the dispatch_table, may be NULL
+ * \return TRUE(1) if the filter answers the syscall, FALSE(0) otherwise
+*/
+int filter_answers(syscall_dispatch_entry* entry);
+
+/*! Installs the previously built seccomp program in the calling process.
+ *
+ * This is called by the \b tracee, after PTRACE_TRACEME and before execv(). PR_SET_NO_NEW_PRIVS is set, as required by the kernel for unprivileged filters.
+ * With option -u, the filter is installed with a listener fd for the supervisor.
+ * The filter is inherited by all children and threads of the \b tracee.
+ * \pre build_syscall_filter() was called
+ * \return RETURN_OK if the filter was installed, <>RETURN_OK otherwise
+*/
+int install_syscall_filter(void);
+
+#endif
@@ -0,0 +1,84 @@
+# @file gensyscalls.awk
+## @brief Generates syscall_names.h from the strace tables syscall_table_X86_64.txt and syscall_table_i386.txt
+
+# Call as 'awk -f src/gensyscalls.awk src/syscall_table_X86_64.txt src/syscall_table_i386.txt > bin/gen/syscall_names.h'
+# Each table gives, for its architecture:
+#	SYSCALL_NR_<name>		the number of the syscall, for the custom libraries
+#	SYSCALL_TABLE_LEN		the highest number plus 1
+#	SYSCALL_TABLE_INIT		the initializer of an array of syscall_info, indexed by number. \see syscalls.h
+# Entries without a name are left out, their slot of the array stays empty
+
+# Authors: Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+# Date: Oct 2026
+# Version: 1.5
+
+BEGIN {
+	print "/*! \\file syscall_names.h"
+	print "    \\brief Syscall numbers, names and argument counts of x86_64 and i386, generated by gensyscalls.awk. Do not edit"
+	print "*/"
+	print ""
+	print "#ifndef INC_SYSCALL_NAMES\t//Lock to prevent recursive inclusions"
+	print "#define INC_SYSCALL_NAMES"
+	arch = ""
+}
+
+# A new table, closing the previous one
+FNR == 1 {
+	if (arch != "")
+		close_table()
+	arch = (FILENAME ~ /i386/) ? "__i386__" : "__x86_64__"
+	print ""
+	print "#ifdef " arch
+	count = 0
+	highest = -1
+}
+
+# [  0] ={ 3,	TD,		 		"read"			},
+/^\[ *[0-9]+\]/ {
+	if (match($0, /"[a-z_0-9]+"/) == 0)
+		next
+	name = substr($0, RSTART+1, RLENGTH-2)
+	number = $0
+	sub(/^\[ */, "", number)
+	sub(/\].*$/, "", number)
+	number = number + 0
+
+	fields = $0
+	sub(/^[^{]*\{/, "", fields)
+	split(fields, field, ",")
+	nargs = field[1] + 0
+	flags = field[2]
+	gsub(/[ \t]/, "", flags)
+	gsub(/[A-Z][A-Z]/, "SYSCALL_&", flags)
+	if (flags == "")
+		flags = "0"
+
+	printf("\t#define SYSCALL_NR_%s\t%d\n", name, number)
+	entry[count++] = sprintf("\t\t[%d] = {%d, %s, \"%s\"}", number, nargs, flags, name)
+	if (number > highest)
+		highest = number
+}
+
+END {
+	if (arch != "")
+		close_table()
+	print ""
+	print "#endif"
+}
+
+function close_table(   i, line) {
+	print ""
+	print "\t/** Highest syscall number of the architecture, plus 1 */"
+	printf("\t#define SYSCALL_TABLE_LEN\t%d\n", highest + 1)
+	print ""
+	print "\t/** Initializer of syscall_info[SYSCALL_TABLE_LEN], indexed by syscall number */"
+	print "\t#define SYSCALL_TABLE_INIT \\"
+	for (i = 0; i < count; i++)
+	{
+		line = entry[i]
+		if (i < count - 1)
+			line = line ", \\"
+		print line
+	}
+	print "#endif"
+}
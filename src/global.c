@@ -28,4 +28,12 @@ SOFTWARE.
 char explicitOutputFlag = 0; 
 char execTreeOutputFlag = 0; 
 char childProcessFlag = 0; 
+int tracerThreadsCount = 1;
+int observeQueueSlots = 1024;
+char userNotifFlag = 0;
+char dispatchFlag = 0;
+char statsFlag = 0;
+char* eventLogFile = 0;
+char* recordFile = 0;
+char* replayFile = 0;
 
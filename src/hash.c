@@ -0,0 +1,159 @@
+/*! \file hash.c
+    \brief Hash table used to find the structures of the Sandbox by an integer key
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+    This is an open-addressing hash table, with an int key and a void* pointer as data
+    Collisions are solved by linear probing, deletions shift back the following items
+    The table doubles its capacity when 3/4 full
+
+	\see hash.h
+
+*/
+
+#include <stdlib.h>
+#include "hash.h"
+
+/** Multiplier of the Fibonacci hashing, 2^32 / golden ratio */
+#define HASH_MULTIPLIER	2654435769U
+
+/*! Computes the slot where the probing for the key starts.
+ * Fibonacci hashing spreads consecutive PIDs/TIDs all over the table.
+ \param h is the pointer to the table
+ \param key to hash
+ \return the index of the first slot to probe
+*/
+int hash_index(hash_table* h, int key)
+{
+	return (int)(((unsigned int)key * HASH_MULTIPLIER) & (unsigned int)(h->capacity - 1));
+}
+
+hash_table* new_hash_table(int capacity)
+{
+	hash_table* H;
+	int size = 8;
+
+	while (size < capacity) size <<= 1;
+
+	H = (hash_table *)malloc(sizeof(hash_table));
+	if (H == NULL) return NULL;
+	H->slots = (struct slot *)calloc(size, sizeof(struct slot));
+	if (H->slots == NULL)
+	{
+		free(H);
+		return NULL;
+	}
+	H->capacity = size;
+	H->counter = 0;
+	return H;
+}
+
+/*! Doubles the amount of slots, placing again all the items.
+ \param h is the pointer to the table to grow
+ \return 0 (OK) if the table grew, -1 (ERR) if memory could not be allocated
+*/
+int hash_grow(hash_table* h)
+{
+	struct slot* old_slots = h->slots;
+	int old_capacity = h->capacity;
+	int i, j;
+
+	h->slots = (struct slot *)calloc(old_capacity*2, sizeof(struct slot));
+	if (h->slots == NULL)
+	{
+		h->slots = old_slots;
+		return -1;
+	}
+	h->capacity = old_capacity*2;
+
+	for(i=0;i<old_capacity;i++)
+	{
+		if (old_slots[i].data == NULL)
+			continue;
+		j = hash_index(h, old_slots[i].key);
+		while (h->slots[j].data != NULL)
+			j = (j+1) & (h->capacity-1);
+		h->slots[j] = old_slots[i];
+	}
+	free(old_slots);
+	return 0;
+}
+
+int hash_insert(hash_table* h, int key, void * item)
+{
+	int i;
+	if (item==NULL) return -1;
+	if ((h->counter+1)*4 > h->capacity*3)	//Keeping the table at most 3/4 full
+		if (hash_grow(h) != 0)
+			return -1;
+
+	i = hash_index(h, key);
+	while (h->slots[i].data != NULL)
+	{
+		if (h->slots[i].key == key)		//Key already present, replaced
+		{
+			h->slots[i].data = item;
+			return 0;
+		}
+		i = (i+1) & (h->capacity-1);
+	}
+	h->slots[i].key = key;
+	h->slots[i].data = item;
+	h->counter++;
+	return 0;
+}
+
+void* hash_find(hash_table* h, int key)
+{
+	int i = hash_index(h, key);
+
+	while (h->slots[i].data != NULL)
+	{
+		if (h->slots[i].key == key)
+			return h->slots[i].data;
+		i = (i+1) & (h->capacity-1);
+	}
+	return NULL;
+}
+
+int hash_delete(hash_table* h, int key)
+{
+	int i, j, k;
+	int mask = h->capacity-1;
+
+	i = hash_index(h, key);
+	while (h->slots[i].data != NULL)
+	{
+		if (h->slots[i].key == key)
+			break;
+		i = (i+1) & mask;
+	}
+	if (h->slots[i].data == NULL)
+		return -1;		//Not found
+
+	// Backward shift: the items after the hole are moved into it, unless their probing starts after the hole
+	j = i;
+	while (1)
+	{
+		j = (j+1) & mask;
+		if (h->slots[j].data == NULL)
+			break;
+		k = hash_index(h, h->slots[j].key);
+		if ( ((j > i) && ((k <= i) || (k > j))) || ((j < i) && ((k <= i) && (k > j))) )
+		{
+			h->slots[i] = h->slots[j];
+			i = j;
+		}
+	}
+	h->slots[i].data = NULL;
+	h->counter--;
+	return 0;
+}
+
+void* get_slot(hash_table* h, int index)
+{
+	if ((index < 0) || (index >= h->capacity))
+		return NULL;
+	return h->slots[index].data;
+}
@@ -0,0 +1,112 @@
+/*! \file hash.h
+    \brief Hash table used to find the structures of the Sandbox by an integer key
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+    This is an open-addressing hash table, with an int key and a void* pointer as data
+
+    Collisions are solved by linear probing. Deletions shift back the following items of the probe sequence, so there are no tombstones and the lookups stay short.
+
+    The table grows (doubles) automatically when it is 3/4 full, insertion, lookup and deletion are O(1) on average.
+
+    The table is not ordered. It can be iterated by slot index with get_slot(), empty slots return NULL.
+
+    \code
+	hash_table* H = new_hash_table(16);
+	int data = 10;
+	hash_insert(H,1234,&data);
+	data = *(int*)hash_find(H,1234);
+	H->counter;
+	hash_delete(H,1234);	//Deletes the item with the key, the data pointer is not freed
+	\endcode
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ *
+ * */
+
+
+#ifndef INC_HASH	//Lock to prevent recursive inclusions
+#define INC_HASH
+
+/*! \brief Slot of the hash table. */
+struct slot
+{
+	int key;	//!< Key of the item, only meaningful if data is not NULL
+	void* data;	//!< Pointer to the data contained in the slot. NULL if the slot is empty
+};
+
+/*! \brief A hash table.
+*/
+typedef struct {
+	int counter ;  //!< Counts the number of elements
+	int capacity ;  //!< Number of slots, always a power of 2
+	struct slot* slots ;  //!< Array of slots
+	}
+hash_table;
+
+/**
+ \param capacity is the initial number of slots, rounded up to a power of 2
+  \return An Empty table, or NULL if memory could not be allocated
+*/
+hash_table* new_hash_table(int capacity);
+
+/** Adding a not-NULL memory location item to the table.
+ *
+ * The content of the item pointer is not copied into the table, only referenced.
+ * If the key is already in the table, its data is replaced.
+ *
+ \param h is the pointer to the table to operate
+ \param key identifies the item
+ \param item is the pointer to the data to be contained in the slot.
+  \return 0 (OK) if addition was OK, -1 (ERR) if not
+
+*/
+int hash_insert(hash_table* h, int key, void *item);
+
+/** Looking for the item with the given key.
+ *
+ \param h is the pointer to the table to operate
+ \param key identifies the item
+  \return the memory pointer to the DATA of the item, or NULL if the key is not in the table
+
+*/
+void* hash_find(hash_table* h, int key);
+
+/** Deleting the item with the given key.
+ *
+ * This deletes the slot, does not delete the item in memory
+ *
+ \param h is the pointer to the table to operate
+ \param key identifies the item
+  \return 0 (OK) if deletion was OK, -1 (ERR) if the key was not found
+
+*/
+int hash_delete(hash_table* h, int key);
+
+/** Gets the data in a slot, to iterate the table.
+ *
+ \param h is the pointer to the table to operate
+ \param index of the slot, between 0 and (h.capacity-1)
+  \return the memory pointer to the DATA of the slot, or NULL if the slot is empty
+
+*/
+void* get_slot(hash_table* h, int index);
+
+#endif
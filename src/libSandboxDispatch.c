@@ -0,0 +1,394 @@
+/*! \file libSandboxDispatch.c
+    \brief Runtime preloaded in the tracee with option -d, running the custom syscalls from Syscall User Dispatch
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	This file is built, with dynlib.c, list.c and global.c, into bin/libSandboxDispatch.so
+	*
+	* The kernel lets through the syscalls issued from the code of this library, and raises SIGSYS for all the others while the
+	* selector of the thread is SYSCALL_DISPATCH_FILTER_BLOCK. The selector is set to SYSCALL_DISPATCH_FILTER_ALLOW while a handler runs,
+	* so the custom functions and the libc they call are not dispatched again.
+	*
+	* Signal handlers return through rt_sigreturn, that must come from this library too: the restorer of every handler installed by the \b tracee is replaced.
+	* SIGSYS and SIGTRAP belong to the runtime. They are removed from the signal masks of the \b tracee, a blocked SIGSYS would kill it.
+	*
+	* A new thread or process starts without Syscall User Dispatch. The clone syscalls are stepped over with the trap flag,
+	* and the SIGTRAP handler arms the new thread when it is monitored.
+
+	\see dispatch.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#define _GNU_SOURCE			// For dl_iterate_phdr(), REG_RIP and gettid
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <signal.h>
+#include <pthread.h>
+#include <link.h>			// For dl_iterate_phdr()
+#include <ucontext.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/prctl.h>	// For PR_SET_SYSCALL_USER_DISPATCH
+
+#include "list.h"
+#include "messages.h"
+#include "dynlib.h"
+#include "arena.h"
+#include "trace.h"
+#include "dispatch.h"
+
+#ifndef __x86_64__
+	#error "The runtime of option -d is only implemented for x86_64"
+#endif
+
+/** Length of the syscall instruction, to execute it again */
+#define SYSCALL_INSTRUCTION_LEN		2
+/** Trap flag of RFLAGS, single step */
+#define RFLAGS_TF					0x100
+/** Bit of a signal in the kernel sigset_t */
+#define SIGNAL_BIT(s)				(1UL << ((s)-1))
+/** Signals that the tracee cannot block nor handle */
+#define RUNTIME_SIGNALS				(SIGNAL_BIT(SIGSYS) | SIGNAL_BIT(SIGTRAP))
+
+#ifndef SA_RESTORER
+	#define SA_RESTORER		0x04000000
+#endif
+
+/*! \brief Signal action as the kernel expects it in rt_sigaction, which is not the sigaction of libc */
+struct kernel_sigaction {
+	void* handler;			//!< Handler of the signal
+	unsigned long flags;	//!< SA_ flags
+	void* restorer;			//!< Code calling rt_sigreturn when the handler returns
+	unsigned long mask;		//!< Signals blocked during the handler
+};
+
+void dispatch_restorer(void);
+__asm__ (
+	".text\n"
+	".align 16\n"
+	"dispatch_restorer:\n"
+	"	mov $15, %rax\n"		// SYS_rt_sigreturn
+	"	syscall\n"
+);
+
+pid_t dispatch_main_pid = 0;		//!< PID of the main \b tracee
+char dispatch_children = FALSE;		//!< TRUE if the children and threads are monitored (option -p)
+unsigned long dispatch_region_start = 0;	//!< Start of the code of this library, where syscalls are let through
+unsigned long dispatch_region_len = 0;		//!< Length of the code of this library
+pthread_mutex_t dispatch_lock = PTHREAD_MUTEX_INITIALIZER;	//!< The chains with shared_state share the tracee structure, one thread at a time
+
+__thread char dispatch_selector = SYSCALL_DISPATCH_FILTER_ALLOW;	//!< Selector of the thread, read by the kernel at every syscall
+__thread pid_t dispatch_tid = 0;			//!< TID for which the selector is armed. Differs after fork(), that does not keep the dispatch
+__thread long int dispatch_return_value = DEFAULT_RETURN_VALUE;			//!< Kept between syscalls, as tracee_flow_descriptor.return_value
+__thread long int dispatch_kernel_return_value = DEFAULT_RETURN_VALUE;	//!< Kept between syscalls, as tracee_flow_descriptor.kernel_return_value
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/*! Issues a syscall from the code of this library, which the kernel lets through.
+ \return The raw kernel result, -errno on error
+*/
+long int dispatch_raw_syscall(long int nr, long int* args)
+{
+	long int ret;
+	register long int r10 __asm__("r10") = args[3];
+	register long int r8 __asm__("r8") = args[4];
+	register long int r9 __asm__("r9") = args[5];
+
+	__asm__ volatile ("syscall"
+		: "=a"(ret)
+		: "a"(nr), "D"(args[0]), "S"(args[1]), "d"(args[2]), "r"(r10), "r"(r8), "r"(r9)
+		: "rcx", "r11", "memory");
+	return ret;
+}
+
+/*! Same as dispatch_raw_syscall() with 4 arguments */
+long int dispatch_raw_syscall4(long int nr, long int a0, long int a1, long int a2, long int a3)
+{
+	long int args[6] = {a0, a1, a2, a3, 0, 0};
+	return dispatch_raw_syscall(nr, args);
+}
+
+/*! Finds the executable segment of this library */
+int find_dispatch_region(struct dl_phdr_info* info, size_t size, void* data)
+{
+	unsigned long code = (unsigned long)data;
+	unsigned long start;
+	int i;
+
+	for(i=0;i<info->dlpi_phnum;i++)
+	{
+		if ((info->dlpi_phdr[i].p_type != PT_LOAD) || (! (info->dlpi_phdr[i].p_flags & PF_X)))
+			continue;
+		start = info->dlpi_addr + info->dlpi_phdr[i].p_vaddr;
+		if ((code >= start) && (code < start + info->dlpi_phdr[i].p_memsz))
+		{
+			dispatch_region_start = start;
+			dispatch_region_len = info->dlpi_phdr[i].p_memsz;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/*! Arms Syscall User Dispatch on the calling thread, if it is monitored */
+void arm_dispatch(void)
+{
+	pid_t tid = (pid_t)dispatch_raw_syscall4(SYS_gettid, 0, 0, 0, 0);
+
+	if ((tid != dispatch_main_pid) && (! dispatch_children))
+		return;
+	dispatch_selector = SYSCALL_DISPATCH_FILTER_ALLOW;
+	if (prctl(PR_SET_SYSCALL_USER_DISPATCH, PR_SYS_DISPATCH_ON, dispatch_region_start, dispatch_region_len, &dispatch_selector) != 0)
+		return;
+	dispatch_tid = tid;
+	dispatch_selector = SYSCALL_DISPATCH_FILTER_BLOCK;
+}
+
+/*! Runs the chain of a custom syscall, with the same steps as processInSyscall() and processOutSyscall() in trace.c
+ \param entry The execution plan of the syscall
+ \param nr The syscall number
+ \param args The 6 arguments
+ \return The result for the tracee
+*/
+long int dispatch_custom_syscall(syscall_dispatch_entry* entry, long int nr, long int* args)
+{
+	syscall_context context;
+
+	context.tid = dispatch_tid;
+	context.tgid = getpid();
+	context.syscall_number = nr;
+	context.args = args;
+	context.return_value = dispatch_return_value;
+	context.kernel_return_value = dispatch_kernel_return_value;
+	context.kernel_executed = FALSE;
+	context.state = NULL;
+
+	if (entry->shared_state)
+		pthread_mutex_lock(&dispatch_lock);
+	if (execute_before_chain(entry, &context))
+	{
+		context.kernel_return_value = DEFAULT_RETURN_VALUE;
+		execute_after_chain(entry, &context);
+	}
+	else
+	{
+		dispatch_return_value = context.return_value;
+		if (entry->shared_state)
+			pthread_mutex_unlock(&dispatch_lock);
+
+		// The kernel may block, the other threads run their chains meanwhile
+		context.kernel_return_value = dispatch_raw_syscall(nr, args);
+		if (! entry->needs_exit_stop)
+			return context.kernel_return_value;
+
+		context.kernel_executed = TRUE;
+		context.return_value = context.kernel_return_value;
+		if (entry->shared_state)
+			pthread_mutex_lock(&dispatch_lock);
+		execute_after_chain(entry, &context);
+	}
+	dispatch_return_value = context.return_value;
+	dispatch_kernel_return_value = context.kernel_return_value;
+	if (entry->shared_state)
+		pthread_mutex_unlock(&dispatch_lock);
+	return context.return_value;
+}
+
+/*! rt_sigaction of the tracee: the handlers return through dispatch_restorer(), and SIGSYS and SIGTRAP are kept by the runtime */
+long int dispatch_sigaction(long int* args)
+{
+	struct kernel_sigaction action;
+	long int local_args[6];
+
+	if ((args[0] == SIGSYS) || (args[0] == SIGTRAP))
+	{
+		if (args[2])
+			memset((void*)args[2], 0, sizeof(struct kernel_sigaction));
+		return 0;
+	}
+	memcpy(local_args, args, sizeof(local_args));
+	if (args[1])
+	{
+		memcpy(&action, (void*)args[1], sizeof(action));
+		if (action.flags & SA_RESTORER)
+			action.restorer = (void*)dispatch_restorer;
+		action.mask &= ~RUNTIME_SIGNALS;
+		local_args[1] = (long int)&action;
+	}
+	return dispatch_raw_syscall(SYS_rt_sigaction, local_args);
+}
+
+/*! rt_sigprocmask of the tracee: SIGSYS and SIGTRAP are never blocked */
+long int dispatch_sigprocmask(long int* args)
+{
+	unsigned long mask;
+	long int local_args[6];
+
+	memcpy(local_args, args, sizeof(local_args));
+	if ((args[1]) && (args[0] != SIG_UNBLOCK))
+	{
+		mask = *(unsigned long*)args[1] & ~RUNTIME_SIGNALS;
+		local_args[1] = (long int)&mask;
+	}
+	return dispatch_raw_syscall(SYS_rt_sigprocmask, local_args);
+}
+
+/*! Handler of SIGSYS, raised by the kernel for every syscall of a dispatched thread
+ \param sig SIGSYS
+ \param info The syscall number is in si_syscall
+ \param context The registers of the tracee, the result is written into RAX
+*/
+void dispatch_sigsys_handler(int sig, siginfo_t* info, void* context)
+{
+	greg_t* gregs = ((ucontext_t*)context)->uc_mcontext.gregs;
+	syscall_dispatch_entry* entry;
+	long int args[6];
+	long int nr = info->si_syscall;
+	int saved_errno = errno;
+
+	dispatch_selector = SYSCALL_DISPATCH_FILTER_ALLOW;
+	args[0] = gregs[REG_RDI];
+	args[1] = gregs[REG_RSI];
+	args[2] = gregs[REG_RDX];
+	args[3] = gregs[REG_R10];
+	args[4] = gregs[REG_R8];
+	args[5] = gregs[REG_R9];
+
+	switch (nr)
+	{
+	case SYS_clone:
+	case SYS_clone3:
+	case SYS_fork:
+	case SYS_vfork:
+		// The new thread must not start inside this handler: the syscall runs again at its place, with the selector open,
+		// and the trap flag brings both threads into dispatch_sigtrap_handler() right after it
+		gregs[REG_RIP] -= SYSCALL_INSTRUCTION_LEN;
+		gregs[REG_EFL] |= RFLAGS_TF;
+		errno = saved_errno;
+		return;
+	case SYS_rt_sigaction:
+		gregs[REG_RAX] = dispatch_sigaction(args);
+		break;
+	case SYS_rt_sigprocmask:
+		gregs[REG_RAX] = dispatch_sigprocmask(args);
+		break;
+	default:
+		entry = get_dispatch_entry(nr);
+		if (entry == NULL)
+			gregs[REG_RAX] = dispatch_raw_syscall(nr, args);
+		else
+			gregs[REG_RAX] = dispatch_custom_syscall(entry, nr, args);
+	}
+	errno = saved_errno;
+	dispatch_selector = SYSCALL_DISPATCH_FILTER_BLOCK;
+}
+
+/*! Handler of SIGTRAP, after a clone syscall was stepped over. Runs in the calling thread and in the new one
+ \param sig SIGTRAP
+ \param info Single steps have si_code TRAP_TRACE
+ \param context The registers of the thread, the trap flag is cleared
+*/
+void dispatch_sigtrap_handler(int sig, siginfo_t* info, void* context)
+{
+	greg_t* gregs = ((ucontext_t*)context)->uc_mcontext.gregs;
+	struct kernel_sigaction action;
+
+	if (info->si_code != TRAP_TRACE)
+	{
+		// Not ours, the default action of SIGTRAP
+		memset(&action, 0, sizeof(action));
+		action.handler = SIG_DFL;
+		dispatch_raw_syscall4(SYS_rt_sigaction, SIGTRAP, (long int)&action, 0, sizeof(action.mask));
+		return;
+	}
+	gregs[REG_EFL] &= ~RFLAGS_TF;
+
+	if (dispatch_tid == (pid_t)dispatch_raw_syscall4(SYS_gettid, 0, 0, 0, 0))
+		dispatch_selector = SYSCALL_DISPATCH_FILTER_BLOCK;
+	else
+		arm_dispatch();		// A new thread, or the child of fork()
+}
+
+/*! Installs a handler of the runtime, with dispatch_restorer() as restorer */
+int install_runtime_handler(int sig, void (*handler)(int, siginfo_t*, void*))
+{
+	struct kernel_sigaction action;
+
+	memset(&action, 0, sizeof(action));
+	action.handler = (void*)handler;
+	action.flags = SA_SIGINFO | SA_RESTORER;
+	action.restorer = (void*)dispatch_restorer;
+	return (int)dispatch_raw_syscall4(SYS_rt_sigaction, sig, (long int)&action, 0, sizeof(action.mask));
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/*! Loads the custom libraries and arms the main thread, before main() of the tracee */
+__attribute__((constructor)) void dispatch_runtime_init(void)
+{
+	char* libs_value;
+	char* pid_value;
+	char* lib_path;
+
+	libs_value = getenv(DISPATCH_ENV_LIBS);
+	pid_value = getenv(DISPATCH_ENV_PID);
+	if ((libs_value == NULL) || (pid_value == NULL))
+		return;
+	dispatch_main_pid = atoi(pid_value);
+	dispatch_children = (getenv(DISPATCH_ENV_CHILDREN) != NULL);
+	if ((getpid() != dispatch_main_pid) && (! dispatch_children))
+		return;		// A child that called execv(), not monitored
+
+	arena_in_process = TRUE;		// The handlers run in a signal handler, the arena is reserved before
+	init_custom_libraries();
+	libs_value = strdup(libs_value);
+	for (lib_path = strtok(libs_value, ":"); lib_path != NULL; lib_path = strtok(NULL, ":"))
+		if (add_custom_library(lib_path) != RETURN_OK)
+			return;
+	if (build_dispatch_table() != RETURN_OK)
+		return;
+	if (arena_reserve() != RETURN_OK)
+	{
+		eprintf(ERROR_DISPATCH_MALLOC);
+		return;
+	}
+
+	dl_iterate_phdr(find_dispatch_region, (void*)dispatch_raw_syscall);
+	if ((dispatch_region_len == 0) || (install_runtime_handler(SIGSYS, dispatch_sigsys_handler) != 0) || (install_runtime_handler(SIGTRAP, dispatch_sigtrap_handler) != 0))
+	{
+		eprintf(ERROR_DISPATCH_ARM);
+		return;
+	}
+	arm_dispatch();
+	if (dispatch_tid == 0)
+		eprintf(ERROR_DISPATCH_ARM);
+}
+
+/*! Runs the terminate() functions of the libraries when the main tracee exits */
+__attribute__((destructor)) void dispatch_runtime_end(void)
+{
+	dispatch_selector = SYSCALL_DISPATCH_FILTER_ALLOW;
+	if ((dispatch_tid != 0) && (getpid() == dispatch_main_pid))
+		unload_libraries();
+}
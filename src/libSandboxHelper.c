@@ -9,6 +9,13 @@
 	* For instance, reading a chunk of memory from the tracee space, given its PID
 	* 
 	* Use the structure tracee_descriptor to get this kind of usefull info
+	*
+	* The memory is copied with process_vm_readv()/process_vm_writev(): one syscall for any amount of bytes, and several regions in one call.
+	* They do not write read-only pages, and need the permission of ptrace on the process. When they fail, /proc/pid/mem is used,
+	* with the same rights as PTRACE_PEEKDATA/PTRACE_POKEDATA. Each thread keeps its descriptor open for the last tracee it accessed.
+	*
+	* When the Sandbox knows the memory maps of the tracee (tracee_descriptor.memory_access), unmapped ranges are rejected before any copy,
+	* and regions the tracee cannot read or write go straight to /proc/pid/mem, without a failing process_vm_readv()/process_vm_writev() first.
 	
 	\see sandbox_customsyscall_descriptor.h
 		
@@ -30,76 +37,325 @@ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTH
 LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
  * */
+#define _GNU_SOURCE			// For process_vm_readv() and process_vm_writev()
+#define _FILE_OFFSET_BITS 64	// Addresses as offsets of /proc/pid/mem, on i386 too
 #include <stdio.h>
 #include <stdlib.h>
-#include <unistd.h>	
-#include <sys/ptrace.h>		// Trace related functions
-#include <string.h>			// Neede for strcpy
-#include <errno.h>			// Needed for errors in PTRACE calls
+#include <string.h>			// For memchr()
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <errno.h>
+#include <sys/uio.h>		// For process_vm_readv() and process_vm_writev()
+#include <sys/types.h>
 
-#define RETURN_ERR -1
-	
-int read_memory_byte(pid_t tracee, void * addr, void* dst,  int n)
+#include "sandbox_customsyscall_descriptor.h"
+
+/** Path of the memory file of a process */
+#define PROC_MEM_PATH	"/proc/%d/mem"
+
+/** Regions copied by each process_vm_readv()/process_vm_writev(). The iovecs are on the stack, which with option -d is the one of the tracee thread in its SIGSYS handler */
+#define HELPER_IOV_CHUNK	64
+
+/** Pages read by each process_vm_readv() of read_string(), paths are seldom longer than one */
+#define STRING_CHUNK_PAGES	4
+
+__thread pid_t proc_mem_pid = 0;		//!< Tracee whose /proc/pid/mem is open, per thread: the tracer threads of option -j copy at the same time
+__thread int proc_mem_fd = -1;			//!< Descriptor of its /proc/pid/mem, -1 if none
+
+/** Linked to the tracee_descriptor of the Sandbox, by the library or by memmap.c. Weak, as the runtime of option -d has none */
+extern tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR __attribute__((weak));
+
+/*! Gives the access of a region, from the maps cached by the Sandbox
+ \param tracee PID of the process
+ \param addr Address in the tracee
+ \param n Amount of bytes
+ \return the MEMORY_* flags, 0 if not mapped, RETURN_ERR if the maps are not known
+*/
+int region_access(pid_t tracee, void* addr, int n)
 {
-	
-	unsigned long ret;
-	int read=0;
-	if( (n>0) && (addr) && (dst))
+	if ((&CUSTOM_TRACEE_DESCRIPTOR == NULL) || (CUSTOM_TRACEE_DESCRIPTOR == NULL) || (CUSTOM_TRACEE_DESCRIPTOR->memory_access == NULL))
+		return RETURN_ERR;
+	return CUSTOM_TRACEE_DESCRIPTOR->memory_access(tracee, addr, n);
+}
+
+/*! Copies regions of a tracee with a single process_vm_readv() or process_vm_writev()
+ \param tracee PID of the process
+ \param local Buffers in the Sandbox
+ \param remote Regions in the tracee, the same amount and sizes as local
+ \param count Amount of regions, at most HELPER_IOV_CHUNK
+ \param write TRUE(1) to copy into the tracee, FALSE(0) to copy from it
+ \return the amount of bytes copied, RETURN_ERR if the call failed
+*/
+ssize_t process_vm_copy(pid_t tracee, struct iovec* local, struct iovec* remote, int count, int write)
+{
+	if (write)
+		return process_vm_writev(tracee, local, count, remote, count, 0);
+	return process_vm_readv(tracee, local, count, remote, count, 0);
+}
+
+/*! Copies a region of a tracee through /proc/pid/mem.
+ * Used when process_vm_readv()/process_vm_writev() fail: read-only pages, or kernels without them
+ \param tracee PID of the process
+ \param addr Address in the tracee
+ \param buf Buffer in the Sandbox
+ \param n Amount of bytes
+ \param write TRUE(1) to copy buf into the tracee, FALSE(0) to copy from it
+ \return n if all bytes were copied, RETURN_ERR otherwise
+*/
+int proc_mem_copy(pid_t tracee, void* addr, void* buf, int n, int write)
+{
+	char path[32];
+	ssize_t done = 0;
+	int retry;
+
+	for(retry=0;retry<2;retry++)
 	{
-		// PEEKDATA read on words, but in general: n bytes to read = X(words) + Y(bytes).
-		while( (n - read ) > sizeof(ret) )
+		if ((proc_mem_fd < 0) || (proc_mem_pid != tracee) || (retry > 0))
 		{
-			// So first we read full words until possible. 
-			// If the n is not a multiple of words, they the remaining chunck is read byte by byte
-			ret =  ptrace(PTRACE_PEEKDATA, tracee, (void*)addr+read, NULL);
-			if(errno != 0) 	//checking if there was any error while reading memory
+			// Another tracee, or a descriptor of a process that ended and whose PID was reused
+			if (proc_mem_fd >= 0)
+				close(proc_mem_fd);
+			snprintf(path, sizeof(path), PROC_MEM_PATH, tracee);
+			proc_mem_fd = open(path, O_RDWR | O_CLOEXEC);
+			proc_mem_pid = tracee;
+			if (proc_mem_fd < 0)
 				return RETURN_ERR;
-			memcpy(dst + read, &ret, sizeof ret);
-			read+=sizeof ret;
 		}
-		while( (n - read ) > 0)
+		if (write)
+			done = pwrite(proc_mem_fd, buf, n, (off_t)(uintptr_t)addr);
+		else
+			done = pread(proc_mem_fd, buf, n, (off_t)(uintptr_t)addr);
+		if (done == n)
+			return n;
+	}
+	return RETURN_ERR;
+}
+
+/*! Copies several regions of a tracee, in as few syscalls as possible.
+ * Regions with a NULL address or buffer, or no bytes, are skipped
+ \param tracee PID of the process
+ \param regions The regions, in the tracee and in the Sandbox
+ \param count Amount of regions
+ \param write TRUE(1) to copy into the tracee, FALSE(0) to copy from it
+ \return the amount of bytes copied, all of them, RETURN_ERR otherwise
+*/
+int copy_memory_regions(pid_t tracee, memory_region* regions, int count, int write)
+{
+	struct iovec local[HELPER_IOV_CHUNK], remote[HELPER_IOV_CHUNK];
+	ssize_t done, expected;
+	int i, j, k, batch, total = 0;
+
+	int access, needed = (write ? MEMORY_WRITE : MEMORY_READ);
+
+	if ((regions == NULL) || (count < 0))
+		return RETURN_ERR;
+
+	// Invalid pointers fail before copying anything
+	for(i=0;i<count;i++)
+		if ((regions[i].addr != NULL) && (regions[i].buf != NULL) && (regions[i].n > 0) && (region_access(tracee, regions[i].addr, regions[i].n) == 0))
+			return RETURN_ERR;
+
+	for(i=0;i<count;i=j)
+	{
+		// A batch of up to HELPER_IOV_CHUNK regions
+		expected = 0;
+		for(j=i,batch=0;(j<count) && (batch<HELPER_IOV_CHUNK);j++)
+		{
+			if ((regions[j].addr == NULL) || (regions[j].buf == NULL) || (regions[j].n <= 0))
+				continue;
+			// Protected regions, i.e. breakpoints in code, only go through /proc/pid/mem
+			access = region_access(tracee, regions[j].addr, regions[j].n);
+			if ((access != RETURN_ERR) && (! (access & needed)))
+			{
+				if (proc_mem_copy(tracee, regions[j].addr, regions[j].buf, regions[j].n, write) != regions[j].n)
+					return RETURN_ERR;
+				total += regions[j].n;
+				continue;
+			}
+			local[batch].iov_base = regions[j].buf;
+			local[batch].iov_len = regions[j].n;
+			remote[batch].iov_base = regions[j].addr;
+			remote[batch].iov_len = regions[j].n;
+			expected += regions[j].n;
+			batch++;
+		}
+		if (batch == 0)
+			continue;
+
+		done = process_vm_copy(tracee, local, remote, batch, write);
+		if (done == expected)
 		{
-			ret =  ptrace(PTRACE_PEEKDATA, tracee, (void*)addr+read, NULL);
-			if(errno != 0) 	//checking if there was any error while reading memory
+			total += done;
+			continue;
+		}
+		// Partial or failed: the kernel stops at the first fault, the regions from there go through /proc/pid/mem
+		if (done < 0)
+			done = 0;
+		for(k=0;k<batch;k++)
+		{
+			if (done >= (ssize_t)local[k].iov_len)
+			{
+				done -= local[k].iov_len;
+				total += local[k].iov_len;
+				continue;
+			}
+			if (proc_mem_copy(tracee, remote[k].iov_base, local[k].iov_base, local[k].iov_len, write) != (int)local[k].iov_len)
 				return RETURN_ERR;
-			memcpy(dst + read, &ret, (n - read ));
-			read+=(n - read );
+			done = 0;
+			total += local[k].iov_len;
+		}
+	}
+	return total;
+}
+
+int write_writable_regions(pid_t tracee, memory_region* regions, int count)
+{
+	struct iovec local[HELPER_IOV_CHUNK], remote[HELPER_IOV_CHUNK];
+	ssize_t done;
+	int i, j, k, batch, access, total = 0, failed = 0;
+
+	if ((regions == NULL) || (count < 0))
+		return RETURN_ERR;
+
+	for(i=0;i<count;i=j)
+	{
+		for(j=i,batch=0;(j<count) && (batch<HELPER_IOV_CHUNK);j++)
+		{
+			if ((regions[j].addr == NULL) || (regions[j].buf == NULL) || (regions[j].n <= 0))
+				continue;
+			local[batch].iov_base = regions[j].buf;
+			local[batch].iov_len = regions[j].n;
+			remote[batch].iov_base = regions[j].addr;
+			remote[batch].iov_len = regions[j].n;
+			batch++;
+		}
+
+		k = 0;
+		while (k < batch)
+		{
+			done = process_vm_writev(tracee, local + k, batch - k, remote + k, batch - k, 0);
+			if ((done < 0) && (errno != EFAULT))
+			{
+				// No process_vm_writev(): /proc/pid/mem, only where the maps tell that the tracee can write
+				for(;k<batch;k++)
+				{
+					access = region_access(tracee, remote[k].iov_base, remote[k].iov_len);
+					if ((access != RETURN_ERR) && (access & MEMORY_WRITE)
+						&& (proc_mem_copy(tracee, remote[k].iov_base, local[k].iov_base, local[k].iov_len, 1) == (int)local[k].iov_len))
+						total += local[k].iov_len;
+					else
+						failed++;
+				}
+				break;
+			}
+			if (done < 0)
+				done = 0;
+			// The kernel stops at the first page the tracee cannot write, the rest of that region is skipped
+			while ((k < batch) && (done >= (ssize_t)local[k].iov_len))
+			{
+				done -= local[k].iov_len;
+				total += local[k].iov_len;
+				k++;
+			}
+			if (k < batch)
+			{
+				total += done;
+				failed++;
+				k++;
+			}
 		}
-		return read;
 	}
-	else
+	return ((total == 0) && (failed > 0)) ? RETURN_ERR : total;
+}
+
+int read_memory_regions(pid_t tracee, memory_region* regions, int count)
+{
+	return copy_memory_regions(tracee, regions, count, 0);
+}
+
+int write_memory_regions(pid_t tracee, memory_region* regions, int count)
+{
+	return copy_memory_regions(tracee, regions, count, 1);
+}
+
+int read_memory_byte(pid_t tracee, void * addr, void* dst,  int n)
+{
+	memory_region region;
+
+	if ((n <= 0) || (addr == NULL) || (dst == NULL))
 		return RETURN_ERR;
+	region.addr = addr;
+	region.buf = dst;
+	region.n = n;
+	return copy_memory_regions(tracee, &region, 1, 0);
 }
 
 int write_memory_byte(pid_t tracee, void * addr, void* src,  int n)
 {
-	unsigned long ret;
-	int wrote=0;
-	if( (n>0) && (addr) && (src))
+	memory_region region;
+
+	if ((n <= 0) || (addr == NULL) || (src == NULL))
+		return RETURN_ERR;
+	region.addr = addr;
+	region.buf = src;
+	region.n = n;
+	return copy_memory_regions(tracee, &region, 1, 1);
+}
+
+int query_memory(pid_t tracee, void* addr, int n)
+{
+	return region_access(tracee, addr, n);
+}
+
+int read_string(pid_t tracee, void* addr, char* dst, int max)
+{
+	struct iovec local, remote[STRING_CHUNK_PAGES];
+	uintptr_t page_size = sysconf(_SC_PAGESIZE);
+	uintptr_t address = (uintptr_t)addr;
+	uintptr_t page_end;
+	ssize_t got;
+	char* terminator;
+	int done = 0, wanted, pages;
+
+	if ((addr == NULL) || (dst == NULL) || (max <= 0))
+		return RETURN_ERR;
+	if (region_access(tracee, addr, 1) == 0)
+		return RETURN_ERR;
+
+	while (done < max)
 	{
-		// PEEKDATA read on words, but in general: n bytes to read = X(words) + Y(bytes).
-		while( (n - wrote ) > sizeof(ret) )
+		// One remote iovec per page, the kernel stops at the first page not mapped and returns the pages before it
+		wanted = 0;
+		for(pages=0;(pages<STRING_CHUNK_PAGES) && (done+wanted < max);pages++)
 		{
-			// So first we read full words until possible. 
-			// If the n is not a multiple of words, they the remaining chunck is read byte by byte
-			memcpy( &ret,src + wrote, sizeof ret);
-			ptrace(PTRACE_POKEDATA, tracee, (void*)addr+wrote, ret);
-			if(errno != 0) 	//checking if there was any error while reading memory
-				return RETURN_ERR;
-			wrote+=sizeof ret;
+			page_end = (address + wanted + page_size) & ~(page_size - 1);
+			remote[pages].iov_base = (void*)(address + wanted);
+			remote[pages].iov_len = page_end - (address + wanted);
+			if (done + wanted + (int)remote[pages].iov_len > max)
+				remote[pages].iov_len = max - done - wanted;
+			wanted += remote[pages].iov_len;
 		}
-		while( (n - wrote ) > 0)
+		local.iov_base = dst + done;
+		local.iov_len = wanted;
+		got = process_vm_readv(tracee, &local, 1, remote, pages, 0);
+		if (got <= 0)
 		{
-			ret =  ptrace(PTRACE_PEEKDATA, tracee, (void*)addr+wrote, NULL);
-			memcpy(&ret,src + wrote, (n - wrote ));
-			ptrace(PTRACE_POKEDATA, tracee, (void*)addr+wrote, ret);
-			if(errno != 0) 	//checking if there was any error while reading memory
+			// A page the tracee cannot read, or no process_vm_readv(): only that page, through /proc/pid/mem
+			got = remote[0].iov_len;
+			if (proc_mem_copy(tracee, remote[0].iov_base, dst + done, got, 0) != got)
 				return RETURN_ERR;
-			wrote+=(n - wrote );
 		}
-		return wrote;
+
+		// memchr() scans a word or a vector register at a time
+		terminator = (char*)memchr(dst + done, 0, got);
+		if (terminator != NULL)
+			return terminator - dst;
+		// After a partial read, the next one starts at the page that failed, and fails alone
+		done += got;
+		address += got;
 	}
-	else
-		return RETURN_ERR;
+	// No terminator in the max bytes: truncated
+	dst[max-1] = 0;
+	return max;
 }
-
@@ -0,0 +1,502 @@
+/*! \file libcapture.c
+    \brief Library capturing the full payloads of the I/O syscalls into memory-mapped segment files
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	* Every byte read or written by read, write, pread64, pwrite64, readv and writev is copied into a segment file (see capture.h),
+	* with an index slot giving the time, TID, process and fd of the syscall. The results of the syscalls are not changed.
+	*
+	* The syscalls creating or closing descriptors (open, openat, creat, socket, accept, dup, pipe, socketpair, fcntl F_DUPFD, close, close_range...)
+	* get an index slot without payload, or with the path for open, openat and creat: a reused fd starts a new stream in sandboxcapture.
+	*
+	* The functions run AFTER the kernel, when the amount of bytes moved is known. They are context handlers, for the process of the thread,
+	* so they may run concurrently: the segment is written under capture_lock.
+	* The bytes are read from the tracee with read_memory_regions() straight into the mapped file: one process_vm_readv() for a whole readv() or writev().
+	*
+	* The environment variable SANDBOX_CAPTURE gives the path prefix of the segments, CAPTURE_DEFAULT_PREFIX by default.
+	* SANDBOX_CAPTURE_SEGMENT gives the bytes of payload of a segment, CAPTURE_DEFAULT_PAYLOAD by default.
+	*
+	* It uses read_memory_regions(), so it has to be compiled
+	\code
+		gcc -c  -fPIC   libs/libcapture.c
+		gcc -c  -fPIC   libSandboxHelper.c
+		gcc -shared  -nostdlib  -o libcapture.so libcapture.o  libSandboxHelper.o
+	\endcode
+
+	\see capture.h sandboxcapture.c libSandboxHelper.c
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#define _GNU_SOURCE			// For IOV_MAX and F_DUPFD_CLOEXEC
+#include <sys/types.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include <limits.h>			// For IOV_MAX
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/uio.h>		// For struct iovec
+#include <linux/close_range.h>	// For CLOSE_RANGE_CLOEXEC
+
+#include "sandbox_customsyscall_descriptor.h"
+#include "syscall_names.h"					//Numbers of the syscalls, by name
+#include "capture.h"
+
+/** Environment variable with the path prefix of the segments */
+#define CAPTURE_PREFIX_ENV		"SANDBOX_CAPTURE"
+/** Environment variable with the bytes of payload of a segment */
+#define CAPTURE_PAYLOAD_ENV		"SANDBOX_CAPTURE_SEGMENT"
+/** Smallest payload area of a segment */
+#define CAPTURE_MIN_PAYLOAD		4096
+/** Buffers of readv and writev read at a time, the arrays are on the stack of the tracer thread, or of the tracee with option -d */
+#define CAPTURE_IOV_CHUNK		64
+
+
+/*! Tracee Descriptor, for the checks of the memory helpers*/
+tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = NULL;
+
+ char capture_prefix[PATH_MAX] = CAPTURE_DEFAULT_PREFIX;	//!< Path of the segments, without their number
+ uint64_t capture_payload = CAPTURE_DEFAULT_PAYLOAD;		//!< Bytes of payload of each segment
+ int capture_segment = -1;									//!< Number of the open segment, -1 if none
+ pthread_mutex_t capture_lock = PTHREAD_MUTEX_INITIALIZER;	//!< Protects the segment
+
+ capture_header* segment = NULL;		//!< The mapped segment, NULL if none could be opened
+ capture_index* segment_index = NULL;	//!< Its index slots, right after the header
+ char* segment_payload = NULL;			//!< Its payload area, right after the index slots
+ size_t segment_size = 0;				//!< Size of the mapping
+
+/** Unmaps the open segment, with the amount of slots and bytes written in its header */
+void close_segment(void)
+{
+	if (segment == NULL)
+		return;
+	msync(segment, segment_size, MS_ASYNC);
+	munmap(segment, segment_size);
+	segment = NULL;
+}
+
+/** Closes the open segment and creates the next one, at its full size
+ * \return 0 if the segment is mapped, <>0 otherwise
+ * */
+int next_segment(void)
+{
+	char path[PATH_MAX + 16];
+	int fd;
+
+	close_segment();
+	capture_segment++;
+	snprintf(path, sizeof(path), "%s.%d", capture_prefix, capture_segment);
+
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return 9;
+	// Preallocated, the payloads never extend the file
+	segment_size = sizeof(capture_header) + CAPTURE_INDEX_SLOTS * sizeof(capture_index) + capture_payload;
+	if (posix_fallocate(fd, 0, segment_size) != 0)
+	{
+		close(fd);
+		return 19;
+	}
+	segment = (capture_header*)mmap(NULL, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (segment == MAP_FAILED)
+	{
+		segment = NULL;
+		return 29;
+	}
+	segment_index = (capture_index*)(segment + 1);
+	segment_payload = (char*)(segment_index + CAPTURE_INDEX_SLOTS);
+
+	memcpy(segment->magic, CAPTURE_MAGIC, sizeof(segment->magic));
+	segment->version = CAPTURE_VERSION;
+	segment->index_size = sizeof(capture_index);
+	segment->segment = capture_segment;
+	segment->index_capacity = CAPTURE_INDEX_SLOTS;
+	segment->payload_capacity = capture_payload;
+	segment->index_used = 0;
+	segment->payload_used = 0;
+	return 0;
+}
+
+/** Makes room in the open segment for an index slot and length bytes of payload, in the next segment if needed. Call under capture_lock
+ * \param length Bytes of payload, at most capture_payload
+ * \return 0 if there is room, <>0 otherwise
+ * */
+int reserve_slot(long int length)
+{
+	if ((segment == NULL) || (segment->index_used >= CAPTURE_INDEX_SLOTS) || (segment->payload_used + length > capture_payload))
+		return next_segment();
+	return 0;
+}
+
+/** Fills the index slot taken by reserve_slot(), for a payload already in the payload area. Call under capture_lock
+ * \param context The syscall, for its time, TID and process
+ * \param fd File descriptor of the syscall
+ * \param direction CAPTURE_IN, CAPTURE_OUT, CAPTURE_OPEN or CAPTURE_CLOSE
+ * \param file_offset Offset of pread64() and pwrite64(), last fd of close_range(), -1 otherwise
+ * \param length Bytes of payload
+ * \param flags CAPTURE_ flags
+ * */
+void commit_slot(syscall_context* context, int fd, int direction, long int file_offset, long int length, uint8_t flags)
+{
+	capture_index* slot;
+	struct timespec now;
+
+	clock_gettime(CLOCK_REALTIME, &now);
+	slot = &(segment_index[segment->index_used]);
+	slot->timestamp_ns = (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+	slot->tid = context->tid;
+	slot->tgid = context->tgid;
+	slot->fd = fd;
+	slot->length = length;
+	slot->offset = segment->payload_used;
+	slot->file_offset = file_offset;
+	slot->nr = context->syscall_number;
+	slot->direction = direction;
+	slot->flags = flags;
+	slot->reserved = 0;
+	segment->payload_used += length;
+	segment->index_used++;
+}
+
+/** Captures the payload of a syscall: takes an index slot and room in the payload area, then reads the regions of the tracee into it.
+ * The iovec arrays of readv and writev are read CAPTURE_IOV_CHUNK entries at a time, with the regions they point to.
+ * \param context The syscall
+ * \param fd File descriptor argument
+ * \param direction CAPTURE_IN or CAPTURE_OUT
+ * \param file_offset Offset of pread64() and pwrite64(), -1 otherwise
+ * \param buffer The single buffer of read, write, pread64 and pwrite64, NULL for readv and writev
+ * \param vector The iovec array in the tracee, for readv and writev
+ * \param iovcnt Amount of buffers, 1 for a single buffer
+ * \param total Bytes moved by the kernel, spread over the buffers in order
+ * */
+void capture_payload_regions(syscall_context* context, int fd, int direction, long int file_offset, void* buffer, struct iovec* vector, int iovcnt, long int total)
+{
+	struct iovec iov[CAPTURE_IOV_CHUNK];
+	memory_region regions[CAPTURE_IOV_CHUNK];
+	long int length, left, wanted;
+	char* dst;
+	int i, k, chunk, count;
+	uint8_t flags = 0;
+
+	if (total <= 0)
+		return;
+	length = total;
+	if ((uint64_t)length > capture_payload)
+	{
+		length = capture_payload;
+		flags |= CAPTURE_TRUNCATED;
+	}
+	pthread_mutex_lock(&capture_lock);
+	if (reserve_slot(length) != 0)
+	{
+		pthread_mutex_unlock(&capture_lock);
+		return;
+	}
+
+	// The kernel fills the buffers in order, the last ones may be partly or not used
+	dst = segment_payload + segment->payload_used;
+	left = length;
+	for(i=0;(i<iovcnt) && (left > 0);i+=chunk)
+	{
+		chunk = ((iovcnt - i) < CAPTURE_IOV_CHUNK) ? (iovcnt - i) : CAPTURE_IOV_CHUNK;
+		if (buffer != NULL)
+		{
+			iov[0].iov_base = buffer;
+			iov[0].iov_len = left;
+		}
+		else if (read_memory_byte(context->tid, vector + i, iov, chunk * sizeof(struct iovec)) <= 0)
+			break;
+
+		count = 0;
+		wanted = 0;
+		for(k=0;(k<chunk) && (left > wanted);k++)
+		{
+			regions[count].addr = iov[k].iov_base;
+			regions[count].buf = dst + wanted;
+			regions[count].n = ((long int)iov[k].iov_len < left - wanted) ? (long int)iov[k].iov_len : left - wanted;
+			wanted += regions[count].n;
+			count++;
+		}
+		if (read_memory_regions(context->tid, regions, count) != wanted)
+			break;
+		dst += wanted;
+		left -= wanted;
+	}
+	if ((left > 0) && (i < iovcnt))
+	{
+		length = 0;
+		flags |= CAPTURE_UNREADABLE;
+	}
+	else
+		length -= left;
+
+	commit_slot(context, fd, direction, file_offset, length, flags);
+	pthread_mutex_unlock(&capture_lock);
+}
+
+/** Captures a descriptor created or closed, with the path of open(), openat() and creat() as payload
+ * \param context The syscall
+ * \param fd The descriptor
+ * \param direction CAPTURE_OPEN or CAPTURE_CLOSE
+ * \param last_fd Last descriptor closed by close_range(), -1 otherwise
+ * \param path Address of the path in the tracee, NULL if none
+ * */
+void capture_descriptor(syscall_context* context, int fd, int direction, long int last_fd, char* path)
+{
+	long int length = 0;
+	uint8_t flags = 0;
+
+	if (fd < 0)
+		return;
+	pthread_mutex_lock(&capture_lock);
+	if (reserve_slot((path != NULL) ? PATH_MAX : 0) != 0)
+	{
+		pthread_mutex_unlock(&capture_lock);
+		return;
+	}
+	if (path != NULL)
+	{
+		length = read_string(context->tid, path, segment_payload + segment->payload_used, PATH_MAX);
+		if (length < 0)
+		{
+			length = 0;
+			flags |= CAPTURE_UNREADABLE;
+		}
+		else if (length >= PATH_MAX)
+		{
+			length = PATH_MAX - 1;
+			flags |= CAPTURE_TRUNCATED;
+		}
+	}
+	commit_slot(context, fd, direction, last_fd, length, flags);
+	pthread_mutex_unlock(&capture_lock);
+}
+
+/** Captures a single buffer, of read, write, pread64 and pwrite64 */
+void capture_buffer(syscall_context* context, int direction, long int file_offset)
+{
+	if (! context->kernel_executed)
+		return;
+	capture_payload_regions(context, context->args[0], direction, file_offset, (void*)context->args[1], NULL, 1, context->kernel_return_value);
+}
+
+/** Captures the buffers of readv and writev, whose iovec array is read from the tracee a chunk at a time */
+void capture_vector(syscall_context* context, int direction)
+{
+	int iovcnt = context->args[2];
+
+	if ((! context->kernel_executed) || (context->kernel_return_value <= 0) || (iovcnt <= 0) || (iovcnt > IOV_MAX) || (context->args[1] == 0))
+		return;
+	capture_payload_regions(context, context->args[0], direction, -1, NULL, (struct iovec*)context->args[1], iovcnt, context->kernel_return_value);
+}
+
+/** Captures the bytes read. Call AFTER kernel, keep Kernel Result */
+long int capture_read(syscall_context* context)
+{
+	capture_buffer(context, CAPTURE_IN, -1);
+	return 0;
+}
+
+/** Captures the bytes written. Call AFTER kernel, keep Kernel Result */
+long int capture_write(syscall_context* context)
+{
+	capture_buffer(context, CAPTURE_OUT, -1);
+	return 0;
+}
+
+/** Captures the bytes read at an offset. Call AFTER kernel, keep Kernel Result */
+long int capture_pread(syscall_context* context)
+{
+	capture_buffer(context, CAPTURE_IN, context->args[3]);
+	return 0;
+}
+
+/** Captures the bytes written at an offset. Call AFTER kernel, keep Kernel Result */
+long int capture_pwrite(syscall_context* context)
+{
+	capture_buffer(context, CAPTURE_OUT, context->args[3]);
+	return 0;
+}
+
+/** Captures the bytes read into several buffers. Call AFTER kernel, keep Kernel Result */
+long int capture_readv(syscall_context* context)
+{
+	capture_vector(context, CAPTURE_IN);
+	return 0;
+}
+
+/** Captures the bytes written from several buffers. Call AFTER kernel, keep Kernel Result */
+long int capture_writev(syscall_context* context)
+{
+	capture_vector(context, CAPTURE_OUT);
+	return 0;
+}
+
+/** Captures the descriptor returned by open and creat, with the path of the first argument. Call AFTER kernel, keep Kernel Result */
+long int capture_open(syscall_context* context)
+{
+	if (context->kernel_executed)
+		capture_descriptor(context, context->kernel_return_value, CAPTURE_OPEN, -1, (char*)context->args[0]);
+	return 0;
+}
+
+/** Captures the descriptor returned by openat, with the path of the second argument. Call AFTER kernel, keep Kernel Result */
+long int capture_openat(syscall_context* context)
+{
+	if (context->kernel_executed)
+		capture_descriptor(context, context->kernel_return_value, CAPTURE_OPEN, -1, (char*)context->args[1]);
+	return 0;
+}
+
+/** Captures the descriptor returned by socket, accept, dup and dup3. Call AFTER kernel, keep Kernel Result */
+long int capture_new_fd(syscall_context* context)
+{
+	if (context->kernel_executed)
+		capture_descriptor(context, context->kernel_return_value, CAPTURE_OPEN, -1, NULL);
+	return 0;
+}
+
+/** Captures the descriptor of dup2, unless it duplicated a descriptor on itself. Call AFTER kernel, keep Kernel Result */
+long int capture_dup2(syscall_context* context)
+{
+	if ((context->kernel_executed) && (context->kernel_return_value != context->args[0]))
+		capture_descriptor(context, context->kernel_return_value, CAPTURE_OPEN, -1, NULL);
+	return 0;
+}
+
+/** Captures the descriptor returned by fcntl F_DUPFD and F_DUPFD_CLOEXEC. Call AFTER kernel, keep Kernel Result */
+long int capture_fcntl(syscall_context* context)
+{
+	if ((context->kernel_executed) && ((context->args[1] == F_DUPFD) || (context->args[1] == F_DUPFD_CLOEXEC)))
+		capture_descriptor(context, context->kernel_return_value, CAPTURE_OPEN, -1, NULL);
+	return 0;
+}
+
+/** Captures the two descriptors written by pipe, pipe2 and socketpair in the array of an argument
+ * \param context The syscall
+ * \param arg Argument with the address of the array
+ * */
+void capture_fd_pair(syscall_context* context, int arg)
+{
+	int fds[2];
+	int got;
+
+	if ((! context->kernel_executed) || (context->kernel_return_value != 0))
+		return;
+	pthread_mutex_lock(&capture_lock);
+	got = read_memory_byte(context->tid, (void*)context->args[arg], fds, sizeof(fds));
+	pthread_mutex_unlock(&capture_lock);
+	if (got != sizeof(fds))
+		return;
+	capture_descriptor(context, fds[0], CAPTURE_OPEN, -1, NULL);
+	capture_descriptor(context, fds[1], CAPTURE_OPEN, -1, NULL);
+}
+
+/** Captures the descriptors of pipe and pipe2. Call AFTER kernel, keep Kernel Result */
+long int capture_pipe(syscall_context* context)
+{
+	capture_fd_pair(context, 0);
+	return 0;
+}
+
+/** Captures the descriptors of socketpair. Call AFTER kernel, keep Kernel Result */
+long int capture_socketpair(syscall_context* context)
+{
+	capture_fd_pair(context, 3);
+	return 0;
+}
+
+/** Captures a closed descriptor. Call AFTER kernel, keep Kernel Result */
+long int capture_close(syscall_context* context)
+{
+	if ((context->kernel_executed) && (context->kernel_return_value == 0))
+		capture_descriptor(context, context->args[0], CAPTURE_CLOSE, -1, NULL);
+	return 0;
+}
+
+/** Captures the range of descriptors closed by close_range, unless it only set them close on exec. Call AFTER kernel, keep Kernel Result */
+long int capture_close_range(syscall_context* context)
+{
+	if ((context->kernel_executed) && (context->kernel_return_value == 0) && (! (context->args[2] & CLOSE_RANGE_CLOEXEC)))
+		capture_descriptor(context, context->args[0], CAPTURE_CLOSE, (unsigned int)context->args[1], NULL);
+	return 0;
+}
+
+void init(void)
+{
+	char* value;
+
+	value = getenv(CAPTURE_PREFIX_ENV);
+	if ((value != NULL) && (value[0] != '\0'))
+		snprintf(capture_prefix, sizeof(capture_prefix), "%s", value);
+	value = getenv(CAPTURE_PAYLOAD_ENV);
+	if (value != NULL)
+	{
+		capture_payload = strtoull(value, NULL, 10);
+		if (capture_payload < CAPTURE_MIN_PAYLOAD)
+			capture_payload = CAPTURE_MIN_PAYLOAD;
+	}
+	// The first segment is created at the first payload, a tracee without I/O leaves no file
+}
+
+void end(void)
+{
+	close_segment();
+}
+
+
+/** The functions of the library: context handlers run AFTER the kernel, keeping its result */
+#define CAPTURE_FLAGS		(FLAG_CONTEXT_HANDLER | FLAG_KEEP_PREVIOUS_RETURN)
+
+/*! Custom syscalls of the library */
+custom_syscall_entry custom_syscalls_2[] = {
+	{ SYSCALL_NR_read, {NULL, (long int (*)())capture_read, "capture_read", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_write, {NULL, (long int (*)())capture_write, "capture_write", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_pread, {NULL, (long int (*)())capture_pread, "capture_pread", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_pwrite, {NULL, (long int (*)())capture_pwrite, "capture_pwrite", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_readv, {NULL, (long int (*)())capture_readv, "capture_readv", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_writev, {NULL, (long int (*)())capture_writev, "capture_writev", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_open, {NULL, (long int (*)())capture_open, "capture_open", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_creat, {NULL, (long int (*)())capture_open, "capture_creat", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_openat, {NULL, (long int (*)())capture_openat, "capture_openat", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_openat2, {NULL, (long int (*)())capture_openat, "capture_openat2", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_socket, {NULL, (long int (*)())capture_new_fd, "capture_socket", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_accept, {NULL, (long int (*)())capture_new_fd, "capture_accept", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_accept4, {NULL, (long int (*)())capture_new_fd, "capture_accept4", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_dup, {NULL, (long int (*)())capture_new_fd, "capture_dup", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_dup2, {NULL, (long int (*)())capture_dup2, "capture_dup2", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_dup3, {NULL, (long int (*)())capture_new_fd, "capture_dup3", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_fcntl, {NULL, (long int (*)())capture_fcntl, "capture_fcntl", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_pipe, {NULL, (long int (*)())capture_pipe, "capture_pipe", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_pipe2, {NULL, (long int (*)())capture_pipe, "capture_pipe2", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_socketpair, {NULL, (long int (*)())capture_socketpair, "capture_socketpair", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_close, {NULL, (long int (*)())capture_close, "capture_close", CAPTURE_FLAGS} },
+	{ SYSCALL_NR_close_range, {NULL, (long int (*)())capture_close_range, "capture_close_range", CAPTURE_FLAGS} }
+};
+
+/*! Library Descriptor*/
+custom_library_v2_descriptor CUSTOM_LIBRARY_V2_DESCRIPTOR = {
+	CUSTOM_LIBRARY_VERSION,init,end,custom_syscalls_2, sizeof(custom_syscalls_2)/sizeof(custom_syscall_entry),"libCapture"
+	};
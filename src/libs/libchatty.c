@@ -42,6 +42,7 @@ SOFTWARE.
 
 
 #include "sandbox_customsyscall_descriptor.h"		//Cumpolsory to interact with sandbox
+#include "syscall_names.h"					//Numbers of the syscalls, by name
 
 #define CHATTY_LOGO "\t\t\t\t =0 : "
 /** Prefix for all CHATTY Lib messages */
@@ -164,51 +165,35 @@ int mystat(const char *path, struct stat *buf)
 	}
 
 
-#ifdef __x86_64__
-	#define READ_SYSCALL_NUMBER 0
-	#define WRITE_SYSCALL_NUMBER 1
-	#define OPEN_SYSCALL_NUMBER 2
-	#define CLOSE_SYSCALL_NUMBER 3
-	#define STAT_SYSCALL_NUMBER 4
-	#define FSTAT_SYSCALL_NUMBER 5
-	#define MMAP_SYSCALL_NUMBER 9
-	#define ALARM_SYSCALL_NUMBER 37
-	#define GETPID_SYSCALL_NUMBER 39
-	#define KILL_SYSCALL_NUMBER 62
-	#define GETDENTS_SYSCALL_NUMBER 78
-	#define GETUID_SYSCALL_NUMBER 102
-	#define GETGID_SYSCALL_NUMBER 104
-	#define GETEUID_SYSCALL_NUMBER 107
-	#define GETEGID_SYSCALL_NUMBER 108
-	#define GETPPID_SYSCALL_NUMBER 110
-	
-	
-#endif
 
+#ifndef SYSCALL_NR_mmap
+	#define SYSCALL_NR_mmap		SYSCALL_NR_mmap2
+	//!< i386 has the old mmap() with its arguments in memory, the C library calls mmap2()
+#endif
 
 /*! Array of Structures, one per custom syscall*/
 custom_syscall_descriptor custom_syscalls_array_3[] = { 
-	[READ_SYSCALL_NUMBER] = {	(long int (*)())myread, 	NULL,"read()",		},
-	[WRITE_SYSCALL_NUMBER] = {	(long int (*)())mywrite,	NULL,"write()",		},
-	[OPEN_SYSCALL_NUMBER] = {	(long int (*)())myopen, 	NULL,"open()",		},
-	[CLOSE_SYSCALL_NUMBER] = {	(long int (*)())myclose,	NULL,"close()",		},
-	[STAT_SYSCALL_NUMBER] = {	(long int (*)())mystat, 	NULL,"stat()",		},
-	[FSTAT_SYSCALL_NUMBER] = {	(long int (*)())myfstat,	NULL,"fstat()",		},
-	[MMAP_SYSCALL_NUMBER] = {	(long int (*)())mymmap,		NULL,"mmap()",		},
-	[ALARM_SYSCALL_NUMBER] = {	(long int (*)())myalarm,	NULL,"alarm()",		},
-	[GETPID_SYSCALL_NUMBER] = {	(long int (*)())mygetpid,	NULL, "getpid()" ,	},
-	[KILL_SYSCALL_NUMBER] = {	(long int (*)())mykill,		NULL,"kill()",		},
-	[GETDENTS_SYSCALL_NUMBER] = {(long int (*)())mygetdents,NULL,"getdents()",	},
-	[GETUID_SYSCALL_NUMBER] = {	(long int (*)())mygetuid,	NULL,"getuid()",	},
-	[GETGID_SYSCALL_NUMBER] = {	(long int (*)())mygetgid,	NULL,"getgid()",	},
-	[GETEUID_SYSCALL_NUMBER] = {(long int (*)())mygeteuid,	NULL,"geteuid()",	},
-	[GETEGID_SYSCALL_NUMBER] = {(long int (*)())mygetegid,	NULL,"getegid()",	},
-	[GETPPID_SYSCALL_NUMBER] = {(long int (*)())mygetppid,	NULL,"getppid()",	}
+	[SYSCALL_NR_read] = {	(long int (*)())myread, 	NULL,"read()",		},
+	[SYSCALL_NR_write] = {	(long int (*)())mywrite,	NULL,"write()",		},
+	[SYSCALL_NR_open] = {	(long int (*)())myopen, 	NULL,"open()",		},
+	[SYSCALL_NR_close] = {	(long int (*)())myclose,	NULL,"close()",		},
+	[SYSCALL_NR_stat] = {	(long int (*)())mystat, 	NULL,"stat()",		},
+	[SYSCALL_NR_fstat] = {	(long int (*)())myfstat,	NULL,"fstat()",		},
+	[SYSCALL_NR_mmap] = {	(long int (*)())mymmap,		NULL,"mmap()",		},
+	[SYSCALL_NR_alarm] = {	(long int (*)())myalarm,	NULL,"alarm()",		},
+	[SYSCALL_NR_getpid] = {	(long int (*)())mygetpid,	NULL, "getpid()" ,	},
+	[SYSCALL_NR_kill] = {	(long int (*)())mykill,		NULL,"kill()",		},
+	[SYSCALL_NR_getdents] = {(long int (*)())mygetdents,NULL,"getdents()",	},
+	[SYSCALL_NR_getuid] = {	(long int (*)())mygetuid,	NULL,"getuid()",	},
+	[SYSCALL_NR_getgid] = {	(long int (*)())mygetgid,	NULL,"getgid()",	},
+	[SYSCALL_NR_geteuid] = {(long int (*)())mygeteuid,	NULL,"geteuid()",	},
+	[SYSCALL_NR_getegid] = {(long int (*)())mygetegid,	NULL,"getegid()",	},
+	[SYSCALL_NR_getppid] = {(long int (*)())mygetppid,	NULL,"getppid()",	}
 };
 
 /*! Library Descriptor*/
 custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
-	before,after,custom_syscalls_array_3, GETPPID_SYSCALL_NUMBER+1,"libchatty"
+	before,after,custom_syscalls_array_3, sizeof(custom_syscalls_array_3)/sizeof(custom_syscall_descriptor),"libchatty"
 	};
 
 /*! Tracee Descriptor*/
@@ -8,14 +8,17 @@
 	*
 	* /tmp/Sandbox.read, /tmp/Sandbox.write
 
-	It uses read_memory_byte(), so it has to be compiled
+	Both functions are observe only (FLAG_OBSERVE_ONLY): the Sandbox copies the buffers, resumes the tracee and writes the files on its worker thread.
+
+	Each syscall is one record, a header line then the first bytes of the buffer:
 	\code
-		gcc -c  -fPIC   libs/libio.c
-		gcc -c  -fPIC   libSandboxHelper.c
-		gcc -shared  -nostdlib  -o libio.so libio.o  libSandboxHelper.o
+		W <TID> <fd> <count> <captured>: <captured bytes>
+		R <TID> <fd> <result> <captured>: <captured bytes>
 	\endcode
+	The amount of bytes captured is set by the environment variable SANDBOX_IO_CAPTURE, 64 by default.
+	The records are gathered in a buffer per file, written in chunks of SNIFFER_BUFFER_LENGTH bytes and when the library is unloaded.
 
-	\see sandbox.c libSandboxHelper.c
+	\see sandbox.c observe.h
 
 */
 
@@ -46,125 +49,150 @@ SOFTWARE.
 
 
 #include "sandbox_customsyscall_descriptor.h"
+#include "syscall_names.h"					//Numbers of the syscalls, by name
 
 #define LOCAL_TEMP_FILE_READ "/tmp/Sandbox.read"
 #define LOCAL_TEMP_FILE_WRITE "/tmp/Sandbox.write"
 
-#define BUFFER_LENGTH	64
+/** Environment variable with the amount of bytes captured per syscall */
+#define CAPTURE_LENGTH_ENV		"SANDBOX_IO_CAPTURE"
+/** Bytes captured per syscall if CAPTURE_LENGTH_ENV is not set */
+#define CAPTURE_LENGTH_DEFAULT	64
+/** Highest capture length, the copy of the Sandbox is limited to it */
+#define CAPTURE_LENGTH_MAX		BUFFER_DEFAULT_MAX_LENGTH
+
+/** Size of the append buffer of each file, it is written in one syscall when full */
+#define SNIFFER_BUFFER_LENGTH	65536
+/** Longest header of a record: 'W', TID, fd, length and captured bytes */
+#define RECORD_HEADER_LENGTH	64
 
+/*! \brief A sniffer file and its append buffer */
+typedef struct {
+	int fd;								//!< File object, -1 if it could not be opened
+	int used;							//!< Bytes waiting in buffer
+	char lock;							//!< Taken while appending, the functions run in every thread of the tracee with option -d
+	char buffer[SNIFFER_BUFFER_LENGTH];	//!< Records not written yet
+	}
+sniffer_file;
 
- int snifferWR;	//!< File object for the Write syscalls
- int snifferRD;	//!< File object for the Read syscalls
+ sniffer_file snifferWR = {-1};	//!< File object for the Write syscalls
+ sniffer_file snifferRD = {-1};	//!< File object for the Read syscalls
+
+ int capture_length = CAPTURE_LENGTH_DEFAULT;	//!< Bytes of the buffers written to the files
 
 
 /*! Tracee Descriptor*/
 tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = NULL;
 
-/** Writes to a local file all the write values, up to a certain amount of bytes.
+/** Writes the waiting records of a file. The caller holds its lock */
+void flush_sniffer(sniffer_file* sniffer)
+{
+	if ((sniffer->used > 0) && (sniffer->fd >= 0))
+		write(sniffer->fd, sniffer->buffer, sniffer->used);
+	sniffer->used = 0;
+}
+
+/** Appends a record to a file: a header line "kind TID fd result captured: " then the captured bytes and a new line.
  *
- * Call BEFORE kernel, keep Kernel Result.
+ * The record goes to the append buffer, the file is written once the buffer is full, or by end().
+ * */
+void append_record(sniffer_file* sniffer, char kind, syscall_context* context, long int result, const char* data)
+{
+	char header[RECORD_HEADER_LENGTH];
+	int header_len, captured = 0;
+
+	if (sniffer->fd < 0)
+		return;
+	if ((result > 0) && (data != NULL))
+		captured = (result > capture_length) ? capture_length : result;
+	header_len = snprintf(header, RECORD_HEADER_LENGTH, "%c %d %d %ld %d: ", kind, (int)context->tid, (int)context->args[0], result, captured);
+
+	while (__atomic_test_and_set(&(sniffer->lock), __ATOMIC_ACQUIRE))
+		;
+	if (sniffer->used + header_len + captured + 1 > SNIFFER_BUFFER_LENGTH)
+		flush_sniffer(sniffer);
+	memcpy(sniffer->buffer + sniffer->used, header, header_len);
+	sniffer->used += header_len;
+	if (captured > 0)
+	{
+		memcpy(sniffer->buffer + sniffer->used, data, captured);		// The copy of the Sandbox, not the memory of the tracee
+		sniffer->used += captured;
+	}
+	sniffer->buffer[sniffer->used++] = '\n';
+	__atomic_clear(&(sniffer->lock), __ATOMIC_RELEASE);
+}
+
+/** Writes to a local file all the write values, up to capture_length bytes.
  *
- * File output is LOCAL_TEMP_FILE_WRITE, BUFFER_LENGTH is the max amount of bytes to sniff.
+ * Call BEFORE kernel, observe only: the Sandbox copies the buffer and runs it on its worker thread, the tracee does not wait for the file.
+ *
+ * File output is LOCAL_TEMP_FILE_WRITE, the length of the record is the count argument.
  * */
-ssize_t mywrite(int fd, const void *buf, size_t count)
+long int mywrite(syscall_context* context)
 {
-	 //Cannot touch the buffer as it belongs to another process and it would be invading memory
-
-	 int i;
-	 char buffer[BUFFER_LENGTH];
-
-	 if (snifferWR)
-	 {
-			memset(buffer, 0, BUFFER_LENGTH);
-			sprintf(buffer,"Writing %d bytes to %d : ",(int)count,fd);
-			write(snifferWR,buffer,BUFFER_LENGTH);
-			i = count;
-			if ( i >=0 )
-			{
-				if (i > BUFFER_LENGTH )i = BUFFER_LENGTH;
-				if (read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)buf, (void*)buffer, i) > 0)
-					write(snifferWR,buffer,i);
-			}
-			write(snifferWR,"\n",1);
-	 }
-	 return 0;
+	append_record(&snifferWR, 'W', context, context->args[2], (const char*)context->args[1]);
+	return 0;
 }
 
 
-/** writes to a local file all the read values, up to a certain amount of bytes.
+/** writes to a local file all the read values, up to capture_length bytes.
  *
- * Call AFTER kernel, keep Kernel Result.
+ * Call AFTER kernel, observe only: the Sandbox copies the buffer and runs it on its worker thread, the tracee does not wait for the file.
  *
- * File output is LOCAL_TEMP_FILE_READ, BUFFER_LENGTH is the max amount of bytes to sniff.
+ * File output is LOCAL_TEMP_FILE_READ, the length of the record is the kernel result.
  *
  * */
-ssize_t myread(int fd, const void *buf, size_t count)
- {
-	//Cannot touch the buffer as it belongs to another process and it would be invading memory
-	int i;
-	 char buffer[BUFFER_LENGTH];
-
-	  if  ( (snifferRD)  )
-	 {
-
-								//printf("TraceePID : %d \n",44);
-			memset(buffer, 0, BUFFER_LENGTH);
-			sprintf(buffer,"Reading %d bytes from %d : ",(int) CUSTOM_TRACEE_DESCRIPTOR->kernel_return_value ,fd);
-			write(snifferRD,buffer,BUFFER_LENGTH);
-			i = CUSTOM_TRACEE_DESCRIPTOR->kernel_return_value;
-			if ( i >=0 )
-			{
-				if (i > BUFFER_LENGTH )i = BUFFER_LENGTH;
-				if (read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)buf, (void*)buffer, i) > 0)
-					write(snifferRD,buffer,i);
-			}
-			write(snifferRD,"\n",1);
-	 }
-	 return 0;
+long int myread(syscall_context* context)
+{
+	append_record(&snifferRD, 'R', context, context->kernel_return_value, (const char*)context->args[1]);
+	return 0;
 }
 
+/** Position of each custom syscall in custom_syscalls_2, for init() */
+#define ENTRY_READ		0
+#define ENTRY_WRITE		1
+
+/*! Custom syscalls of the library, with their memory arguments. The copy length is set by init() */
+extern custom_syscall_entry custom_syscalls_2[];
+
 void init(void)
 {
-	 snifferWR = open(LOCAL_TEMP_FILE_WRITE, O_CREAT | O_APPEND | O_RDWR , S_IRWXU | S_IROTH);
-	 snifferRD = open(LOCAL_TEMP_FILE_READ, O_CREAT | O_APPEND | O_RDWR , S_IRWXU | S_IROTH);
-
+	char* value = getenv(CAPTURE_LENGTH_ENV);
+
+	if (value != NULL)
+	{
+		capture_length = atoi(value);
+		if (capture_length < 0)
+			capture_length = 0;
+		if (capture_length > CAPTURE_LENGTH_MAX)
+			capture_length = CAPTURE_LENGTH_MAX;
+	}
+	// The Sandbox copies no more than what is written, 0 would be its default maximum
+	custom_syscalls_2[ENTRY_READ].buffers[0].length = (capture_length > 0) ? capture_length : 1;
+	custom_syscalls_2[ENTRY_WRITE].buffers[0].length = (capture_length > 0) ? capture_length : 1;
+
+	snifferWR.fd = open(LOCAL_TEMP_FILE_WRITE, O_CREAT | O_APPEND | O_WRONLY , S_IRWXU | S_IROTH);
+	snifferRD.fd = open(LOCAL_TEMP_FILE_READ, O_CREAT | O_APPEND | O_WRONLY , S_IRWXU | S_IROTH);
 }
 
 void end(void)
 {
-	close(snifferWR);
-	close(snifferRD);
+	flush_sniffer(&snifferWR);
+	flush_sniffer(&snifferRD);
+	close(snifferWR.fd);
+	close(snifferRD.fd);
 }
 
 
-#ifdef __x86_64__
-	#define READ_SYSCALL_NUMBER 0
-	#define WRITE_SYSCALL_NUMBER 1
-#endif
-#ifdef __i386__
-	#define READ_SYSCALL_NUMBER 3
-	#define WRITE_SYSCALL_NUMBER 4
-#endif
-
-
-
-/*! Array of Structures, one per custom syscall*/
-custom_syscall_descriptor custom_syscalls_array_1[] = {
-[READ_SYSCALL_NUMBER] = {
-		NULL,
-		(long int (*)())myread,
-		"myread",
-		FLAG_KEEP_PREVIOUS_RETURN
-		},
-[WRITE_SYSCALL_NUMBER] = {
-		(long int (*)())mywrite,
-		NULL,
-		"mywrite",
-		FLAG_KEEP_PREVIOUS_RETURN
-		}
+/*! Custom syscalls of the library, with their memory arguments */
+custom_syscall_entry custom_syscalls_2[] = {
+	[ENTRY_READ] = { SYSCALL_NR_read, {NULL, (long int (*)())myread, "myread", FLAG_OBSERVE_ONLY},
+		{ BUFFER_RETURN(1, BUFFER_IN, CAPTURE_LENGTH_DEFAULT) } },
+	[ENTRY_WRITE] = { SYSCALL_NR_write, {(long int (*)())mywrite, NULL, "mywrite", FLAG_OBSERVE_ONLY},
+		{ BUFFER_ARG(1, BUFFER_IN, 2, CAPTURE_LENGTH_DEFAULT) } }
 };
 
-/*! Library Descriptor*/
-custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
-	init,end,custom_syscalls_array_1, WRITE_SYSCALL_NUMBER+1,"libIO"
+/*! Library Descriptor, in the sparse format: the array format cannot declare memory arguments */
+custom_library_v2_descriptor CUSTOM_LIBRARY_V2_DESCRIPTOR = {
+	CUSTOM_LIBRARY_VERSION,init,end,custom_syscalls_2, sizeof(custom_syscalls_2)/sizeof(custom_syscall_entry),"libIO"
 	};
@@ -32,10 +32,14 @@ SOFTWARE.
 
 
 #include "sandbox_customsyscall_descriptor.h"		//Cumpolsory to interact with sandbox
+#include "syscall_names.h"					//Numbers of the syscalls, by name
 
 /*! Tracee Descriptor*/
 tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = NULL;
 
+/*! Async-signal-safe, the functions only change the values returned: usable with option -d*/
+const int CUSTOM_LIBRARY_SIGNAL_SAFE = 1;
+
 const pid_t PID = 666;
 const pid_t PPID = 999;
 
@@ -58,7 +62,7 @@ pid_t mygetppid(void)
 }
 
 /** kill that does nothing
- *  EXEC_BEFORE_KERNEL | FLAG_EXEC_DONT_CALL_KERNEL
+ *  EXEC_BEFORE_KERNEL | FLAG_EXEC_DONT_CALL_KERNEL | FLAG_CONSTANT_RESULT
  * \return 0 as if OK
  * */
 int mykill(pid_t pid, int sig)
@@ -67,27 +71,17 @@ int mykill(pid_t pid, int sig)
 }
 
 
-#ifdef __x86_64__	
-	#define GETPID_SYSCALL_NUMBER 39
-	#define GETPPID_SYSCALL_NUMBER 110
-	#define KILL_SYSCALL_NUMBER 62
-#endif
-#ifdef __i386__	
-	#define GETPID_SYSCALL_NUMBER 20
-	#define GETPPID_SYSCALL_NUMBER 64
-	#define KILL_SYSCALL_NUMBER 37
-#endif
 
 
 /*! Array of Structures, one per custom syscall*/
 custom_syscall_descriptor custom_syscalls_array_2[] = { 
-[GETPID_SYSCALL_NUMBER] = {NULL, (long int (*)())mygetpid, "getpid" ,FLAG_DONT_CALL_KERNEL},
-[KILL_SYSCALL_NUMBER] = {(long int (*)())mykill,0,"kill",FLAG_DONT_CALL_KERNEL},
-[GETPPID_SYSCALL_NUMBER] = {NULL,(long int (*)())mygetppid,"getppid",FLAG_DONT_CALL_KERNEL}
+[SYSCALL_NR_getpid] = {NULL, (long int (*)())mygetpid, "getpid" ,FLAG_DONT_CALL_KERNEL},
+[SYSCALL_NR_kill] = {(long int (*)())mykill,0,"kill",FLAG_DONT_CALL_KERNEL | FLAG_CONSTANT_RESULT},
+[SYSCALL_NR_getppid] = {NULL,(long int (*)())mygetppid,"getppid",FLAG_DONT_CALL_KERNEL}
 };
 
 /*! Library Descriptor*/
 custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
-	NULL,NULL,custom_syscalls_array_2, GETPPID_SYSCALL_NUMBER+1,"libpid"
+	NULL,NULL,custom_syscalls_array_2, sizeof(custom_syscalls_array_2)/sizeof(custom_syscall_descriptor),"libpid"
 	};
 	
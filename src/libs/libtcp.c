@@ -8,12 +8,8 @@
 	* When RCVFROM, all numbers are replaced by '0'
 	* When BIND, the Port is shifted some offset if it is >1024. This allows to fool the Server that thinks it has obtained a priviledged port
 
-	It uses read_memory_byte()/write_memory_byte()), so it has to be compiled
-	\code
-		gcc -c  -fPIC   libs/libio.c
-		gcc -c  -fPIC   libSandboxHelper.c
-		gcc -shared  -nostdlib  -o libio.so libio.o  libSandboxHelper.o
-	\endcode
+	The buffers and the address of the tracee are declared as memory arguments (see buffer_descriptor).
+	The Sandbox copies them before the functions and writes back only the bytes they changed, so it does not need libSandboxHelper.c
 
 	\see sandbox.c
 
@@ -46,6 +42,7 @@ SOFTWARE.
 #include <ctype.h>
 
 #include "sandbox_customsyscall_descriptor.h"
+#include "syscall_names.h"					//Numbers of the syscalls, by name
 
 /** If the port to bind is < TCP_PORT_LIMIT, then the port value is added TCP_PORT_SHIFT and binded  */
 #define TCP_PORT_SHIFT 2000
@@ -58,32 +55,27 @@ SOFTWARE.
 /*! Tracee Descriptor*/
 tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = NULL;
 
+/*! Async-signal-safe, the functions only use ctype on the buffers copied by the Sandbox*/
+const int CUSTOM_LIBRARY_SIGNAL_SAFE = 1;
+
 /** Inverts Upper and Lower case
  * Call BEFORE kernel, keep Kernel Result
  * */
-ssize_t mywrite(int sockfd, const void *buf, size_t len, int flags, const struct sockaddr *dest_addr, socklen_t addrlen)
+ssize_t mywrite(int sockfd, char *buf, size_t len, int flags, const struct sockaddr *dest_addr, socklen_t addrlen)
 {
-	 //Cannot touch the buffer as it belongs to another process and it would be invading memory
-
-	 int i = len;
-	 char buffer[BUFFER_LENGTH],*c;
+	//The buffer is a local copy of the one of the tracee, with at most BUFFER_LENGTH bytes
+	int i = len;
+	char *c;
 
-	if ( i >1 )
+	if ( (i >1) && (buf != NULL) )
 	{
 		if (i > BUFFER_LENGTH ) i = BUFFER_LENGTH;
-		//printf("Reading mem...");
-		if (read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)buf, (void*)buffer, i) > 0)
+		for(c=buf; c<buf+i; c++)
 		{
-			c = buffer + i;
-			while( c>=buffer )
+			if( isalpha(*c) )
 			{
-				if( isalpha(*c) )
-				{
-					*c = islower(*c) ? toupper(*c) : tolower(*c);
-				}
-			c--;
+				*c = islower(*c) ? toupper(*c) : tolower(*c);
 			}
-			write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)buf, (void*)buffer, i);
 		}
 	}
 	return len;
@@ -92,29 +84,22 @@ ssize_t mywrite(int sockfd, const void *buf, size_t len, int flags, const struct
 /** replaces any number found by 0
  * Call AFTER kernel, keep Kernel Result
  * */
-ssize_t myread(int sockfd, void *buf, size_t len, int flags, struct sockaddr *src_addr, socklen_t *addrlen)
+ssize_t myread(int sockfd, char *buf, size_t len, int flags, struct sockaddr *src_addr, socklen_t *addrlen)
 
  {
-	//Cannot touch the buffer as it belongs to another process and it would be invading memory
-	//We get the bytes actually read by the kernel
-	 int i = CUSTOM_TRACEE_DESCRIPTOR->kernel_return_value;
-	 char buffer[BUFFER_LENGTH],*c;
+	//We get the bytes actually read by the kernel, the Sandbox copied at most BUFFER_LENGTH of them
+	int i = CUSTOM_TRACEE_DESCRIPTOR->kernel_return_value;
+	char *c;
 
-	if ( i >=0 )
+	if ( (i >=0) && (buf != NULL) )
 	{
 		if (i > BUFFER_LENGTH ) i = BUFFER_LENGTH;
-		if (read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)buf, (void*)buffer, i) > 0)
+		for(c=buf; c<buf+i; c++)
 		{
-			c = buffer + i;
-			while(c >= buffer)
+			if( isdigit(*c) )
 			{
-				if( isdigit(*c) )
-				{
-					*c = '0';
-				}
-			c--;
+				*c = '0';
 			}
-			write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)buf, (void*)buffer, i);
 		}
 	}
 	return len;
@@ -126,19 +111,14 @@ ssize_t myread(int sockfd, void *buf, size_t len, int flags, struct sockaddr *sr
  * If the port to bind is < TCP_PORT_LIMIT, then the port value is added TCP_PORT_SHIFT and binded
  * Call BEFORE kernel
  * */
-int mybind(int sockfd, const struct sockaddr *addr, socklen_t addrlen)
+int mybind(int sockfd, struct sockaddr_in *addr, socklen_t addrlen)
 {
 	int port;
-	struct sockaddr_in socket_address;
-	if (read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)addr, (void*)&socket_address, sizeof(struct sockaddr_in)) > 0)
+	if ((addr != NULL) && (addrlen >= sizeof(struct sockaddr_in)) && (addr->sin_family == AF_INET))
 	{
-		if (socket_address.sin_family == AF_INET)
-		{
-			port = ntohs(socket_address.sin_port);
-			port = (port < TCP_PORT_LIMIT) ? port+TCP_PORT_SHIFT : port;
-			socket_address.sin_port = htons(port);
-			write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)addr, (void*)&socket_address,  sizeof(struct sockaddr_in));
-		}
+		port = ntohs(addr->sin_port);
+		port = (port < TCP_PORT_LIMIT) ? port+TCP_PORT_SHIFT : port;
+		addr->sin_port = htons(port);
 	}
 	return 0;
 }
@@ -147,53 +127,31 @@ int mybind(int sockfd, const struct sockaddr *addr, socklen_t addrlen)
  * This function is executed to hide to the tracee the changes in the data
  * Call AFTER kernel
  * */
-int unbind(int sockfd, const struct sockaddr *addr, socklen_t addrlen)
+int unbind(int sockfd, struct sockaddr_in *addr, socklen_t addrlen)
 {
 	int port;
-	struct sockaddr_in socket_address;
-	if (read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)addr, (void*)&socket_address, sizeof(struct sockaddr_in)) > 0)
+	if ((addr != NULL) && (addrlen >= sizeof(struct sockaddr_in)) && (addr->sin_family == AF_INET))
 	{
-		if (socket_address.sin_family == AF_INET)
-		{
-			port = ntohs(socket_address.sin_port);
-			port = ( (port -TCP_PORT_SHIFT) <  TCP_PORT_LIMIT) ? port-TCP_PORT_SHIFT : port;
-			socket_address.sin_port = htons(port);
-			write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)addr, (void*)&socket_address,  sizeof(struct sockaddr_in));
-		}
+		port = ntohs(addr->sin_port);
+		port = ( (port -TCP_PORT_SHIFT) <  TCP_PORT_LIMIT) ? port-TCP_PORT_SHIFT : port;
+		addr->sin_port = htons(port);
 	}
 	return 0;
 }
 
-#ifdef __x86_64__
-	#define RCVFROM_SYSCALL_NUMBER 45
-	#define SENDTO_SYSCALL_NUMBER 44
-	#define BIND_SYSCALL_NUMBER 49
-#endif
-
-
-/*! Array of Structures, one per custom syscall*/
-custom_syscall_descriptor custom_syscalls_array_1[] = {
-[RCVFROM_SYSCALL_NUMBER] = {
-		NULL,
-		(long int (*)())myread,
-		"NetRead",
-		FLAG_KEEP_PREVIOUS_RETURN
-		},
-[SENDTO_SYSCALL_NUMBER] = {
-		(long int (*)())mywrite,
-		NULL,
-		"NetWrite",
-		0
-		},
-[BIND_SYSCALL_NUMBER] = {
-		(long int (*)())mybind,
-		(long int (*)())unbind,
-		"mybind",
-		0
-		}
+
+
+/*! Custom syscalls of the library, with their memory arguments */
+custom_syscall_entry custom_syscalls_2[] = {
+	{ SYSCALL_NR_recvfrom, {NULL, (long int (*)())myread, "NetRead", FLAG_KEEP_PREVIOUS_RETURN},
+		{ BUFFER_RETURN(1, BUFFER_INOUT, BUFFER_LENGTH) } },
+	{ SYSCALL_NR_sendto, {(long int (*)())mywrite, NULL, "NetWrite", 0},
+		{ BUFFER_ARG(1, BUFFER_INOUT, 2, BUFFER_LENGTH) } },
+	{ SYSCALL_NR_bind, {(long int (*)())mybind, (long int (*)())unbind, "mybind", 0},
+		{ BUFFER_ARG(1, BUFFER_INOUT, 2, sizeof(struct sockaddr_in)) } }
 };
 
-/*! Library Descriptor*/
-custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
-	NULL,NULL,custom_syscalls_array_1, BIND_SYSCALL_NUMBER+1,"libTCP"
+/*! Library Descriptor, in the sparse format: the array format cannot declare memory arguments */
+custom_library_v2_descriptor CUSTOM_LIBRARY_V2_DESCRIPTOR = {
+	CUSTOM_LIBRARY_VERSION,NULL,NULL,custom_syscalls_2, sizeof(custom_syscalls_2)/sizeof(custom_syscall_entry),"libTCP"
 	};
@@ -11,12 +11,8 @@
     35	sys_nanosleep	struct timespec *rqtp	struct timespec *rmtp				
 	36	sys_getitimer	int which	struct itimerval *value
 
-	It uses write_memory_byte(), so it has to be compiled
-	\code
-		gcc -c  -fPIC   libs/libio.c 
-		gcc -c  -fPIC   libSandboxHelper.c 
-		gcc -shared  -nostdlib  -o libio.so libio.o  libSandboxHelper.o  
-	\endcode
+	The structures of the tracee are declared as memory arguments (see buffer_descriptor), the Sandbox copies them in and out,
+	so the functions work on plain pointers and it does not need libSandboxHelper.c
 	
 	\see sandbox.c sandbox_customsyscall_descriptor.h
 	
@@ -47,28 +43,33 @@ SOFTWARE.
 #include <sys/time.h>
 
 #include "sandbox_customsyscall_descriptor.h"		//Cumpolsory to interact with sandbox
+#include "syscall_names.h"					//Numbers of the syscalls, by name
 
 /*! Tracee Descriptor*/
 tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = NULL;
 
+/*! Async-signal-safe, the functions only change the times copied by the Sandbox*/
+const int CUSTOM_LIBRARY_SIGNAL_SAFE = 1;
+
 const time_t YEAR = (60*60*24*30*12);
-char FlipFlop = 0;
 
 const pid_t PPID = 999;
 
-/** Substract and add 1 year to subsequent calls of time()
+/** Substract and add 1 year to subsequent calls of time(), for each thread
  * Called after the kernel, overrides the return value
+ * The flip-flop is kept in the slot of the thread, as NULL or not, so threads do not change each other's
  * */
-time_t mytime(time_t *tloc)
+time_t mytime(syscall_context* context)
 {
-	time_t i = (time_t)CUSTOM_TRACEE_DESCRIPTOR->kernel_return_value;
-	if (i>YEAR)
+	time_t i = (time_t)context->kernel_return_value;
+	time_t* tloc = (time_t*)context->args[0];
+	if ((i>YEAR) && (context->state != NULL))
 	{	
-		if (FlipFlop) i = i-YEAR;
+		if (*(context->state) != NULL) i = i-YEAR;
 		else i = i + YEAR;		
-		FlipFlop = !FlipFlop;
+		*(context->state) = (*(context->state) != NULL) ? NULL : context->state;
 		if (tloc != NULL)
-			write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)tloc, (void*)i, sizeof(time_t));
+			*tloc = i;
 	}
 	return i;
 }
@@ -76,19 +77,12 @@ time_t mytime(time_t *tloc)
 /** Multiplies by 5 the time asked to sleep
  * Call before kernel, keep the previous result just in case
  * */
- int mynanosleep(const struct timespec *req, struct timespec *rem)
+ int mynanosleep(struct timespec *req, struct timespec *rem)
 {
-	int i=0;
-	struct timespec tm;
 	if (req != NULL)
 	{
-		read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)req, (void*)&tm, sizeof(tm));
-		if (i == 0)
-			{
-				tm.tv_sec*=5;tm.tv_nsec=0;
-				i = write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)req, (void*)&tm, sizeof(tm));
-				read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)req, (void*)&tm, sizeof(tm));
-			}
+		req->tv_sec*=5;
+		req->tv_nsec=0;
 	}
 	return 0;
 }
@@ -97,26 +91,19 @@ time_t mytime(time_t *tloc)
  * Call AFTER kernel, so the caller does not see we changed it 
  * Keep the previous result just in case
  * */
- int mynanosleep2(const struct timespec *req, struct timespec *rem)
+ int mynanosleep2(struct timespec *req, struct timespec *rem)
 {
-	int i=0;
-	struct timespec tm;
 	if (req != NULL)
 	{
-		read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)req, (void*)&tm, sizeof(tm));
-		if (i == 0)
-			{
-				tm.tv_sec/=5;tm.tv_nsec=0;
-				i = write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)req, (void*)&tm, sizeof(tm));
-				read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)req, (void*)&tm, sizeof(tm));
-			}
+		req->tv_sec/=5;
+		req->tv_nsec=0;
 	}
 	return 0;
 }
 
 
 /**Tries to set the Time of the system. OK is returned but nothing is actually done
- * Call BEFORE the Kernel, do not call the Kernel
+ * Call BEFORE the Kernel, do not call the Kernel. Constant result, it is answered by the seccomp filter
  * */
 int mysettimeofday(const struct timeval *tv, const struct timezone *tz)
 {
@@ -128,43 +115,28 @@ int mysettimeofday(const struct timeval *tv, const struct timezone *tz)
 /** Returns always the same date and Time Zone
  * Call AFTER the Kernel
  * */
-int mygettimeofday(const struct timeval *tv, const struct timezone *tz)
+int mygettimeofday(struct timeval *tv, struct timezone *tz)
 {
-	struct timeval timev;
-	
 	if (tv != NULL)
-	{
-		if(read_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)tv, (void*)&timev, sizeof(struct timeval)) == 0)
-			{
-				timev.tv_sec=STATIC_DATE_SECS;
-				write_memory_byte( CUSTOM_TRACEE_DESCRIPTOR->trace_PID , (void*)tv, (void*)&timev, sizeof(struct timeval));
-			}
-	}
+		tv->tv_sec=STATIC_DATE_SECS;
 	
 	return 0;
 }
 
-#ifdef __x86_64__	
-	
-	#define NANOSLEEP_SYSCALL_NUMBER 		35
-	#define GETTIME_SYSCALL_NUMBER 			96
-	#define SETTIME_SYSCALL_NUMBER 			164
-	#define TIME_SYSCALL_NUMBER 		201
-#endif
-#ifdef __i386__	
-#endif
-
-
-/*! Array of Structures, one per custom syscall*/
-custom_syscall_descriptor custom_syscalls_array_2[] = { 
-[NANOSLEEP_SYSCALL_NUMBER] = {(long int (*)())mynanosleep,(long int (*)())mynanosleep2,"nanosleep",FLAG_KEEP_PREVIOUS_RETURN},
-[GETTIME_SYSCALL_NUMBER] = {NULL, (long int (*)())mygettimeofday, "gettimeofday" ,0},
-[SETTIME_SYSCALL_NUMBER] = { (long int (*)())mysettimeofday,NULL, "settimeofday" ,FLAG_DONT_CALL_KERNEL},
-[TIME_SYSCALL_NUMBER] = {NULL,(long int (*)())mytime,"time",0}
+
+
+/*! Custom syscalls of the library, listed by syscall number*/
+custom_syscall_entry custom_syscalls_2[] = {
+	{ SYSCALL_NR_nanosleep, {(long int (*)())mynanosleep,(long int (*)())mynanosleep2,"nanosleep",FLAG_KEEP_PREVIOUS_RETURN},
+		{ BUFFER_FIXED(0, BUFFER_INOUT, sizeof(struct timespec)) } },
+	{ SYSCALL_NR_gettimeofday, {NULL, (long int (*)())mygettimeofday, "gettimeofday" ,0},
+		{ BUFFER_FIXED(0, BUFFER_INOUT, sizeof(struct timeval)) } },
+	{ SYSCALL_NR_settimeofday, { (long int (*)())mysettimeofday,NULL, "settimeofday" ,FLAG_DONT_CALL_KERNEL | FLAG_CONSTANT_RESULT} },
+	{ SYSCALL_NR_time, {NULL,(long int (*)())mytime,"time",FLAG_CONTEXT_HANDLER},
+		{ BUFFER_FIXED(0, BUFFER_OUT, sizeof(time_t)) } }
 };
 
-/*! Library Descriptor*/
-custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
-	NULL,NULL,custom_syscalls_array_2, TIME_SYSCALL_NUMBER+1,"libtime"
+/*! Library Descriptor, in the sparse format*/
+custom_library_v2_descriptor CUSTOM_LIBRARY_V2_DESCRIPTOR = {
+	CUSTOM_LIBRARY_VERSION,NULL,NULL,custom_syscalls_2, sizeof(custom_syscalls_2)/sizeof(custom_syscall_entry),"libtime"
 	};
-	
@@ -32,6 +32,7 @@ SOFTWARE.
  #include <unistd.h>
  #include <sys/types.h>
 #include "sandbox_customsyscall_descriptor.h"
+#include "syscall_names.h"					//Numbers of the syscalls, by name
 #define NUMBER_SYSCALLS	2
 
 /** getuid simply returns a fake UID
@@ -53,23 +54,15 @@ uid_t mygeteuid(void)
   return 54321;
 }
 
-#ifdef __x86_64__	
-	#define GETUID_SYSCALL_NUMBER 102
-	#define GETEUID_SYSCALL_NUMBER 107
-#endif
-#ifdef __i386__	
-	#define GETUID_SYSCALL_NUMBER 24
-	#define GETEUID_SYSCALL_NUMBER 49
-#endif
 
 /*! Array of Structures, one per custom syscall*/
 custom_syscall_descriptor custom_syscalls_array_3[] = { 
-[GETUID_SYSCALL_NUMBER] = {NULL, (long int (*)())mygetuid, "getuid" ,0},
-[GETEUID_SYSCALL_NUMBER] = {NULL,(long int (*)())mygeteuid,"geteuid",0}
+[SYSCALL_NR_getuid] = {NULL, (long int (*)())mygetuid, "getuid" ,0},
+[SYSCALL_NR_geteuid] = {NULL,(long int (*)())mygeteuid,"geteuid",0}
 };
 
 /*! Library Descriptor*/
 custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR = {
-	NULL,NULL,custom_syscalls_array_3, GETEUID_SYSCALL_NUMBER+1,"libuid"
+	NULL,NULL,custom_syscalls_array_3, sizeof(custom_syscalls_array_3)/sizeof(custom_syscall_descriptor),"libuid"
 	};
 
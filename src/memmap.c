@@ -0,0 +1,327 @@
+/*! \file memmap.c
+    \brief Cached view of the memory maps of the tracees
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see memmap.h
+
+	\internal
+
+	* A memory_map is an array of ranges sorted by address, contiguous ranges with the same access are merged, so a lookup is a binary search.
+	* memmap_table finds the map of each PID/TID. The threads point to the same map, which counts its users.
+	* The maps are changed by the tracer threads at the memory syscalls, and read by the libraries, so all accesses are under memmap_lock.
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "messages.h"
+#include "dynlib.h"
+#include "hash.h"
+#include "memmap.h"
+
+/** Path of the memory maps of a process */
+#define MEMMAP_PATH				"/proc/%d/maps"
+/** Lines of /proc/pid/maps are at most a path plus the ranges and flags */
+#define MEMMAP_LINE_LENGTH		4352
+/** Addresses below are never mapped: NULL and small integers are rejected at once */
+#define MEMMAP_MIN_ADDRESS		4096
+/** Initial amount of slots of the table of maps */
+#define MEMMAP_TABLE_SIZE		16
+
+/*! \brief A range of addresses with the same access */
+typedef struct {
+	unsigned long start;		//!< First address
+	unsigned long end;			//!< Address after the last one
+	int flags;					//!< MEMORY_MAPPED, and MEMORY_READ, MEMORY_WRITE, MEMORY_EXEC as allowed
+	}
+memmap_range;
+
+/*! \brief The memory map of a process, shared by its threads */
+typedef struct {
+	memmap_range* ranges;		//!< Mapped ranges, sorted by address
+	int count;					//!< Amount of ranges
+	int capacity;				//!< Amount of ranges allocated
+	int users;					//!< PIDs/TIDs in memmap_table pointing to this map
+	char loaded;				//!< TRUE once read from /proc/pid/maps. FALSE to read it again at the next query
+	}
+memory_map;
+
+/** The helpers linked in the Sandbox find tracee_descriptor.memory_access through this pointer, as the ones linked in the libraries. \see libSandboxHelper.c */
+tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR = &tracee;
+
+hash_table* memmap_table = NULL;		//!< Map of each PID/TID, NULL with option -d
+pthread_mutex_t memmap_lock = PTHREAD_MUTEX_INITIALIZER;	//!< Protects memmap_table and the maps
+
+//-------------------------------------------------------------------------------------------------//
+
+/*! Appends a range after the last one of the map, merging it if it is contiguous with the same access
+ \param map where to append
+ \param start of the range
+ \param end of the range
+ \param flags of the range
+ \return RETURN_OK, RETURN_ERR if memory could not be allocated
+*/
+int append_range(memory_map* map, unsigned long start, unsigned long end, int flags)
+{
+	memmap_range* ranges;
+
+	if (start >= end)
+		return RETURN_OK;
+	if ((map->count > 0) && (map->ranges[map->count-1].end == start) && (map->ranges[map->count-1].flags == flags))
+	{
+		map->ranges[map->count-1].end = end;
+		return RETURN_OK;
+	}
+	if (map->count == map->capacity)
+	{
+		ranges = (memmap_range*)realloc(map->ranges, (map->capacity ? 2*map->capacity : 64) * sizeof(memmap_range));
+		if (ranges == NULL)
+			return RETURN_ERR;
+		map->ranges = ranges;
+		map->capacity = (map->capacity ? 2*map->capacity : 64);
+	}
+	map->ranges[map->count].start = start;
+	map->ranges[map->count].end = end;
+	map->ranges[map->count].flags = flags;
+	map->count++;
+	return RETURN_OK;
+}
+
+/*! Reads the map of a process from /proc/pid/maps
+ \param map to fill
+ \param pid of the process, or any of its threads
+ \return RETURN_OK, RETURN_ERR if the file could not be read
+*/
+int load_memory_map(memory_map* map, pid_t pid)
+{
+	char path[32];
+	char line[MEMMAP_LINE_LENGTH];
+	char perms[5];
+	unsigned long start, end;
+	int whole_line = TRUE;
+	int complete;
+	FILE* maps;
+
+	snprintf(path, sizeof(path), MEMMAP_PATH, pid);
+	maps = fopen(path, "re");
+	map->loaded = FALSE;
+	if (maps == NULL)
+		return RETURN_ERR;
+
+	map->count = 0;
+	while (fgets(line, sizeof(line), maps) != NULL)
+	{
+		// The end of a line longer than the buffer is not a new line
+		complete = (strchr(line, '\n') != NULL);
+		if ((whole_line) && (sscanf(line, "%lx-%lx %4s", &start, &end, perms) == 3))
+		{
+			if (append_range(map, start, end, MEMORY_MAPPED | ((perms[0] == 'r') ? MEMORY_READ : 0) | ((perms[1] == 'w') ? MEMORY_WRITE : 0) | ((perms[2] == 'x') ? MEMORY_EXEC : 0)) != RETURN_OK)
+			{
+				fclose(maps);
+				return RETURN_ERR;
+			}
+		}
+		whole_line = complete;
+	}
+	fclose(maps);
+	map->loaded = TRUE;
+	return RETURN_OK;
+}
+
+/*! Looks up the access allowed in a range of addresses
+ \param map to look in
+ \param start of the range
+ \param n amount of bytes, at least 1
+ \return the flags common to all the range, 0 if any byte is not mapped
+*/
+int lookup_range(memory_map* map, unsigned long start, unsigned long n)
+{
+	unsigned long end = start + n;
+	unsigned long address = start;
+	int low = 0, high = map->count - 1, middle;
+	int flags = MEMORY_MAPPED | MEMORY_READ | MEMORY_WRITE | MEMORY_EXEC;
+
+	if (end < start)
+		return 0;
+	while (low < high)		// First range ending after the start
+	{
+		middle = (low + high) / 2;
+		if (map->ranges[middle].end <= start)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+	for(;(low < map->count) && (address < end);low++)
+	{
+		if (map->ranges[low].start > address)
+			return 0;
+		flags &= map->ranges[low].flags;
+		address = map->ranges[low].end;
+	}
+	return (address < end) ? 0 : flags;
+}
+
+/*! Creates an empty map, read at its first query
+ \return the map, NULL if memory could not be allocated
+*/
+memory_map* new_memory_map(void)
+{
+	memory_map* map = (memory_map*)calloc(1, sizeof(memory_map));
+
+	if (map != NULL)
+		map->users = 1;
+	return map;
+}
+
+/*! Finds the map of a PID/TID. \pre memmap_lock is held
+ \param pid of the tracee
+ \param create TRUE(1) to create it if there is none
+ \return the map, NULL if there is none
+*/
+memory_map* find_memory_map(pid_t pid, int create)
+{
+	memory_map* map = (memory_map*)hash_find(memmap_table, pid);
+
+	if ((map == NULL) && (create))
+	{
+		map = new_memory_map();
+		if ((map != NULL) && (hash_insert(memmap_table, pid, map) != 0))
+		{
+			free(map);
+			map = NULL;
+		}
+	}
+	return map;
+}
+
+/*! Releases the map of a PID/TID, freed with its last user. \pre memmap_lock is held
+ \param pid of the tracee
+*/
+void detach_memory_map(pid_t pid)
+{
+	memory_map* map = (memory_map*)hash_find(memmap_table, pid);
+
+	if (map == NULL)
+		return;
+	hash_delete(memmap_table, pid);
+	map->users--;
+	if (map->users > 0)
+		return;
+	free(map->ranges);
+	free(map);
+}
+
+int init_memory_maps(void)
+{
+	if (dispatchFlag)
+		return RETURN_OK;		// No tracer, the libraries run inside the tracee
+
+	memmap_table = new_hash_table(MEMMAP_TABLE_SIZE);
+	if (memmap_table == NULL)
+	{
+		eprintf(ERROR_MEMMAP_MALLOC);
+		return 9;
+	}
+	tracee.memory_access = memory_access;
+	return RETURN_OK;
+}
+
+int memory_access(pid_t pid, void* addr, long int n)
+{
+	memory_map* map;
+	int fresh = FALSE;
+	int access;
+
+	if ((unsigned long)addr < MEMMAP_MIN_ADDRESS)
+		return 0;
+	if (n < 1)
+		n = 1;
+
+	pthread_mutex_lock(&memmap_lock);
+	map = find_memory_map(pid, TRUE);
+	if ((map != NULL) && (! map->loaded))
+	{
+		load_memory_map(map, pid);
+		fresh = TRUE;
+	}
+	if ((map == NULL) || (! map->loaded))
+	{
+		pthread_mutex_unlock(&memmap_lock);
+		return RETURN_ERR;
+	}
+	access = lookup_range(map, (unsigned long)addr, n);
+	if ((access == 0) && (! fresh) && (load_memory_map(map, pid) == RETURN_OK))
+		access = lookup_range(map, (unsigned long)addr, n);		// Not found, maybe mapped since it was read: mmap(), mremap(), or the stack growing
+	pthread_mutex_unlock(&memmap_lock);
+	return access;
+}
+
+void memmap_new_child(pid_t parent, pid_t child, int shares_memory)
+{
+	memory_map* parent_map;
+	memory_map* child_map;
+
+	if (memmap_table == NULL)
+		return;
+	pthread_mutex_lock(&memmap_lock);
+	detach_memory_map(child);
+	parent_map = find_memory_map(parent, FALSE);
+	if ((parent_map != NULL) && (shares_memory))
+	{
+		if (hash_insert(memmap_table, child, parent_map) == 0)
+			parent_map->users++;
+	}
+	else if ((parent_map != NULL) && (parent_map->loaded))
+	{
+		// A forked child has a copy of the address space of its parent
+		child_map = new_memory_map();
+		if ((child_map != NULL) && (parent_map->count > 0))
+		{
+			child_map->ranges = (memmap_range*)malloc(parent_map->count * sizeof(memmap_range));
+			if (child_map->ranges != NULL)
+			{
+				memcpy(child_map->ranges, parent_map->ranges, parent_map->count * sizeof(memmap_range));
+				child_map->count = parent_map->count;
+				child_map->capacity = parent_map->count;
+				child_map->loaded = TRUE;
+			}
+		}
+		if ((child_map != NULL) && (hash_insert(memmap_table, child, child_map) != 0))
+		{
+			free(child_map->ranges);
+			free(child_map);
+		}
+	}
+	pthread_mutex_unlock(&memmap_lock);
+}
+
+void memmap_detach(pid_t pid)
+{
+	if (memmap_table == NULL)
+		return;
+	pthread_mutex_lock(&memmap_lock);
+	detach_memory_map(pid);
+	pthread_mutex_unlock(&memmap_lock);
+}
@@ -0,0 +1,70 @@
+/*! \file memmap.h
+    \brief Cached view of the memory maps of the tracees, to validate the addresses before copying them
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * The libraries pass the addresses found in the syscall arguments to the memory helpers, and they may be NULL, bogus or unmapped.
+	 * The Sandbox keeps the mapped ranges of each \b tracee, read once from /proc/pid/maps, so that the helpers reject an invalid range
+	 * without any syscall, and copy the read-only or protected pages straight through /proc/pid/mem.
+	 *
+	 * The threads of a process, and a vfork() child until it calls execve(), share the same map. A forked child starts with a copy of its parent's.
+	 * The memory syscalls (mmap, munmap, mremap, mprotect...) do not stop the \b tracee, the map is refreshed lazily instead:
+	 * an address not found is looked up once more in a fresh map, and the map is dropped at the PTRACE_EVENT_EXEC stop of execve().
+	 * A range unmapped since the map was read is still reported, its copy then fails in the kernel as it would without the map.
+	 *
+	 * The libraries query the map through tracee_descriptor.memory_access, or query_memory() of libSandboxHelper.c.
+	 *
+	\see memmap.c libSandboxHelper.c trace.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_MEMMAP	//Lock to prevent recursive inclusions
+#define INC_MEMMAP
+
+#include <sys/types.h>
+
+/*! Prepares the maps, once the libraries are loaded.
+ * With option -d there are no maps, the libraries run inside the \b tracee.
+ * \return RETURN_OK, <>RETURN_OK if memory could not be allocated
+*/
+int init_memory_maps(void);
+
+/*! Gives the access allowed in a range of the memory of a \b tracee. Used as tracee_descriptor.memory_access.
+ * \param pid is the PID/TID of the \b tracee
+ * \param addr is the start of the range
+ * \param n is the amount of bytes
+ * \return MEMORY_MAPPED and the MEMORY_READ, MEMORY_WRITE and MEMORY_EXEC flags allowed in all the range, 0 if any byte is not mapped, RETURN_ERR if the map cannot be read
+*/
+int memory_access(pid_t pid, void* addr, long int n);
+
+/*! Gives a map to a new child or thread.
+ * \param parent is the PID/TID that created it
+ * \param child is the new PID/TID
+ * \param shares_memory TRUE(1) for a thread or a vfork() child, FALSE(0) for a forked copy
+*/
+void memmap_new_child(pid_t parent, pid_t child, int shares_memory);
+
+/*! Releases the map of a \b tracee that ended, or that called execve(): a new map is read at its next query.
+ * \param pid is the PID/TID of the \b tracee
+*/
+void memmap_detach(pid_t pid);
+
+#endif
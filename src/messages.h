@@ -16,6 +16,7 @@
 // Message Prefixes
 #define		SBOX_ERR	"SBOX-ERROR:"
 #define		SBOX_INFO	"SBOX-INFO:"
+#define		SBOX_WARN	"SBOX-WARNING:"
 #define		SBOX_DEBUG	"\t\t\tSBOX-DEBUG:"
 
 
@@ -48,10 +49,19 @@
 #define ERROR_EXEC_S			SBOX_ERR"Unable to create Process %s\n"
 #define ERROR_FORK 				SBOX_ERR"Unable to fork process\n"
 #define TRACEE_END_D			SBOX_INFO"Tracee terminated with return value %d\n"
+#define ERROR_FILTER_INSTALL	SBOX_ERR"Unable to install the seccomp filter in the Tracee\n"
+
+//From filter.c
+#define ERROR_FILTER_MALLOC		SBOX_ERR"Unable to allocate memory for the seccomp filter\n"
+#define FILTER_ANSWERS_S_D_LD	SBOX_INFO"Syscall %s (%d) is answered by the seccomp filter with %ld, it is not traced nor logged\n"
+#define FILTER_BUILT_D_D		SBOX_INFO"Seccomp filter built, %d syscalls stop the Tracee, %d are answered by the filter\n"
 
 //From opts.c
 #define ERROR_OPT_L_MISSING_ARG 	SBOX_ERR"Option -l requires the library filename as an argument.\n"
 #define ERROR_OPT_LL_MISSING_ARG 	SBOX_ERR"Option -L requires the path as an argument.\n"
+#define ERROR_OPT_J_ARG_D		 	SBOX_ERR"Option -j requires the amount of tracer threads, between 1 and %d.\n"
+#define ERROR_OPT_Q_ARG_D		 	SBOX_ERR"Option -q requires the amount of slots of the observe queue, between 1 and %d.\n"
+#define ERROR_OPT_O_MISSING_ARG 	SBOX_ERR"Option -o requires the log filename as an argument.\n"
 #define ERROR_UNKNOWN_OPT_C 		SBOX_ERR"Unknown option `-%c'.\n"
 #define ERROR_OPT_MISSING_CMD		SBOX_ERR"No Command to execute as Tracee.\n"
 #define INVALID_PATH_S				SBOX_ERR"Wrong path  '%s', please provide a valid path\n"
@@ -76,8 +86,12 @@
 #define CUSTOM_LIBRARY_S_D					SBOX_INFO"reading custom library %s with %d array\n"
 #define CUSTOM_LIBRARY_INIT_S				SBOX_INFO"executed initialize() of custom library %s\n"
 #define CUSTOM_LIBRARY_END_S				SBOX_INFO"executed terminate() of custom library %s\n"
+#define CUSTOM_LIBRARY_V2_S_D_D				SBOX_INFO"compiled custom library %s, %d custom syscalls in an array of %d\n"
 #define CUSTOM_SYSCALL_S_POINTERS_LD		"SBOX-TABLE: custom syscall %s, before %ld after %ld\n"
 #define CUSTOM_LIBRARY_S_D_POINTER_LD		"SBOX-TABLE: custom library %s with %d entries in array %ld\n"
+#define ERROR_DISPATCH_MALLOC				SBOX_ERR" building the dispatch table, unable to allocate memory \n"
+#define ERROR_CUSTOM_LIBRARY_VERSION_S_D_D	SBOX_ERR" loading custom library %s, descriptor version %d is not supported, expected %d \n"
+#define ERROR_CUSTOM_SYSCALL_NUMBER_S_D		SBOX_ERR" loading custom syscall %s, syscall number %d is out of range or repeated \n"
 #define ERROR_DLOPEN_S						SBOX_ERR" at opening library: %s\n"
 #define	ERROR_LOADING_CUSTOM_LIBRARY_S		SBOX_ERR" loading custom library (%s), descriptor is not valid \n"
 #define ERROR_LOADING_CUSTOM_SYMBOL_S		"ERROR loading custom syscall, required Symbol %s not found\n"
@@ -90,8 +104,19 @@
 #define LIBRARIES_LOADED_D  				SBOX_INFO"Libraries loaded = %d\n"
 #define LOADED_CUSTOM_SYSCALL_S				SBOX_INFO"loaded custom syscall %s \n"
 
+//arena.c
+#define BUFFER_NOT_READ_D				SBOX_INFO"memory argument %d could not be read from the tracee, passing NULL \n"
+#define BUFFER_NOT_WRITTEN				SBOX_INFO"memory arguments could not be written back to the tracee \n"
+
+//observe.c
+#define ERROR_OBSERVE_START				SBOX_ERR"Unable to start the observe worker, the observe-only functions run in the chains\n"
+#define OBSERVE_QUEUE_STATS_LU_LU_LU_D	SBOX_INFO"Observe queue: %lu calls, %lu dropped, highest depth %lu of %d slots\n"
+
+//memmap.c
+#define ERROR_MEMMAP_MALLOC				SBOX_ERR"Unable to allocate memory for the memory maps\n"
+
 //trace.c
-#define CUSTOM_SYSCALL_CATCHED_D		"SystemCall (%d)\n"
+#define CUSTOM_SYSCALL_CATCHED_S_D		"SystemCall %s (%d)\n"
 #define CUSTOM_SYSCALL_S_RET_D			SBOX_INFO"Custom SystemCall (%s) returns %d \n"
 #define CUSTOM_SYSCALL_CATCHED_S_FROM_S	SBOX_INFO"Custom SystemCall (%s) from Library (%s) "
 #define CUSTOM_SYSCALL_CALLED_AFTER		SBOX_INFO"Custom SystemCall called AFTER kernel \n"
@@ -101,9 +126,11 @@
 #define	CUSTOM_SYSCALL_CALLING_AFTER	" Calling AFTER kernel "
 #define CUSTOM_SYSCALL_QUIT_ON_ERROR	", QUIT on negative return "
 #define CUSTOM_SYSCALL_KEEP_RESULT		", KEEP previous return value"
+#define CUSTOM_SYSCALL_OBSERVE_ONLY		", OBSERVE only, on the worker thread"
 #define CUSTOM_LIB_CALLED_S_S			" Custom SystemCall (%s) from Library (%s) "
 #define KERNEL_SYSCALL					" KERNEL executing normal Syscall\n"
 #define NO_KERNEL_SYSCALL				" Skipping KERNEL normal Syscall\n"
+#define FILTER_SYSCALL_LD				" Moved into the seccomp filter, always returns %ld\n"
 #define	LF_CR							"\n"
 #define	LINE							"-----------------------------------------------------\n"
 #define SPACE							"+"
@@ -118,6 +145,41 @@
 #define TRACEE_FORKED 					SBOX_INFO"Tracee has forked as process\n"
 #define TRACKING_CLONED_D				SBOX_INFO"Monitoring cloned process %d\n"
 #define TRACKING_FORKED_D				SBOX_INFO"Monitoring forked process %d\n"
+#define TRACER_THREADS_D				SBOX_INFO"Tracing with %d tracer threads\n"
+#define TRACER_ADOPTED_D_D				SBOX_INFO"PID %d handed off to tracer thread %d\n"
+#define SUPERVISOR_STARTED_D_S			SBOX_INFO"Supervisor listening for seccomp notifications, fd %d, %s\n"
+#define SUPERVISOR_HYBRID				"ptrace for the syscalls with AFTER functions"
+#define SUPERVISOR_ONLY					"no ptrace"
+#define ERROR_SUPERVISOR_LISTENER		SBOX_ERR"Unable to get the seccomp listener of the Tracee\n"
+#define ERROR_SUPERVISOR_D				SBOX_ERR"Supervisor failed at the seccomp notification of pid %d\n"
+#define DISPATCH_STARTED_D				SBOX_INFO"Tracee %d runs its custom syscalls in-process, on Syscall User Dispatch\n"
+#define ERROR_DISPATCH_RUNTIME_S		SBOX_ERR"Runtime %s not found\n"
+#define ERROR_DISPATCH_ARM				SBOX_ERR"Unable to enable Syscall User Dispatch in the Tracee\n"
+#define WARNING_DISPATCH_SIGNAL_UNSAFE_S	SBOX_WARN"Library %s is not declared signal-safe: with -d its functions run in the SIGSYS handler of the tracee, where stdio, malloc or locks can deadlock\n"
+#define ERROR_OPT_C_MODE				SBOX_ERR"Option -c needs the ptrace mode, it cannot be used with -u or -d\n"
+#define ERROR_OPT_O_MODE				SBOX_ERR"Option -o records in the Sandbox, it cannot be used with -d\n"
+#define ERROR_OPT_RP_MODE				SBOX_ERR"Options -R and -P need the ptrace mode with a single tracer thread, they cannot be used together, with -u, -d or -j\n"
+#define ERROR_OPT_RP_MISSING_ARG		SBOX_ERR"Options -R and -P require the record filename as an argument.\n"
+#define REPLAY_RECORDING_S				SBOX_INFO"Recording the I/O syscalls in %s\n"
+#define REPLAY_LOADED_S_D_D				SBOX_INFO"Replaying %s, %d syscalls of %d tracees\n"
+#define REPLAY_END_D					SBOX_INFO"Records of tracee %d exhausted, end of the replay\n"
+#define ERROR_REPLAY_FILE_S				SBOX_ERR"Unable to use the record file %s\n"
+#define ERROR_REPLAY_DIVERGED_D_S_S		SBOX_ERR"Tracee %d diverged from the recording: syscall %s instead of %s. Its syscalls run in the kernel from now on\n"
+#define ERROR_REPLAY_HOOKED_S_S			SBOX_ERR"Syscall %s is hooked by library %s: the syscalls of the custom libraries are not recorded nor replayed, options -R and -P cannot be used with it\n"
+#define ERROR_REPLAY_FD_D_LD_LD			SBOX_ERR"Tracee %d got descriptor %ld for a replayed socket instead of %ld of the recording, the replay is aborted\n"
+#define EVENTLOG_OPEN_S_D				SBOX_INFO"Recording syscalls in %s, ring of %d records\n"
+#define ERROR_EVENTLOG_S				SBOX_ERR"Unable to create the event log %s\n"
+
+#define STATS_SYSCALL_HEADER			"\n   nr name                 calls    errors  kernel(us) | kernel p50/p99/p999 (us)    | before p50/p99/p999 (us)    | after p50/p99/p999 (us)     | custom\n"
+#define STATS_SYSCALL_D_S_LU_LU_F		" %4d %-16s %9lu %9lu %11.1f"
+#define STATS_PERCENTILES_F_F_F			" | %8.1f %8.1f %8.1f"
+#define STATS_NO_PERCENTILES			" |        -        -        -"
+#define STATS_NAME_S					" | %s\n"
+#define STATS_TOTAL_LU_LU_F				"  all                  %9lu %9lu %11.1f\n"
+#define STATS_TID_HEADER				"\n    tid     calls    errors  kernel(us)\n"
+#define STATS_TID_D_LU_LU_F				" %6d %9lu %9lu %11.1f\n"
+#define PROFILE_HEADER					"\n phase      stops    total(us) | p50/p99/p999 (us)\n"
+#define PROFILE_PHASE_S_LU_F			" %-6s %10lu %12.1f"
 #define EXIT_CAPTURED_D					SBOX_INFO"Received exit for PID %d\n"
 #define EXIT_EVENT_D					SBOX_INFO"Received exit event for PID %d\n"
 #define STOP_CAPTURED_H_D 				SBOX_INFO"Received stop signal %d for PID %d \n"
@@ -136,3 +198,11 @@
 extern char explicitOutputFlag;  //!< Determines if the Verbose option was requested, to print all usefull information during execution
 extern char execTreeOutputFlag;  //!< Determines if the Execution plan is printed
 extern char childProcessFlag;	 //!< Determines if the \b tracee child processes are monitored
+extern int tracerThreadsCount;	 //!< Amount of tracer threads sharing the \b tracee threads and children
+extern int observeQueueSlots;	 //!< Amount of slots of the queue of the observe-only functions, option -q
+extern char* eventLogFile;		 //!< Path of the binary event log of option -o, NULL if not requested
+extern char* recordFile;		 //!< Path of the record file of option -R, NULL if not recording
+extern char* replayFile;		 //!< Path of the record file of option -P, NULL if not replaying
+extern char statsFlag;			 //!< Determines if the statistics of the syscalls are collected and printed at the end
+extern char dispatchFlag;		 //!< Determines if the custom syscalls run inside the \b tracee, on Syscall User Dispatch
+extern char userNotifFlag;		 //!< Determines if the syscalls completed at their entry are answered by the seccomp user notification supervisor
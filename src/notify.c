@@ -0,0 +1,253 @@
+/*! \file notify.c
+    \brief Supervisor mode, answering the custom syscalls from seccomp user notifications instead of ptrace stops
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see notify.h
+
+	\internal
+
+	* The listener fd is created by the seccomp() call of the \b tracee, with O_CLOEXEC. It is taken before execv(), at the exit stop of that syscall.
+	* The supervisor thread shares the custom libraries with the tracer threads, the chains run under library_lock.
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/wait.h>
+#include <sys/ptrace.h>
+#include <sys/ioctl.h>			// For the SECCOMP_IOCTL_NOTIF_* requests
+#include <sys/epoll.h>
+#include <sys/syscall.h>		// For SYS_seccomp, SYS_pidfd_open, SYS_pidfd_getfd
+#include <linux/ptrace.h>		// For struct __ptrace_syscall_info
+#include <linux/seccomp.h>
+
+#include "messages.h"
+#include "dynlib.h"
+#include "filter.h"
+#include "trace.h"
+#include "notify.h"
+#include "eventlog.h"
+
+pid_t supervised_pid = 0;		//!< PID of the main \b tracee, the only one handled without option -p
+int listener_fd = -1;			//!< Seccomp listener of the \b tracee, duplicated in the Sandbox
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/*! Follows the stopped \b tracee syscall by syscall until its seccomp() call returns, and duplicates the listener fd it got.
+ \param pid The PID of the \b tracee, stopped
+ \return The listener fd in the Sandbox, -1 if it could not be taken. The \b tracee is left stopped at the exit of seccomp()
+*/
+int take_listener(pid_t pid)
+{
+	struct __ptrace_syscall_info info;
+	int status;
+	int in_seccomp = FALSE;
+	int pidfd, fd;
+
+	while (1)
+	{
+		if (ptrace(PTRACE_SYSCALL, pid, 0, 0) == -1)
+			return -1;
+		if ((waitpid(pid, &status, 0) == -1) || (! WIFSTOPPED(status)))
+			return -1;
+		if (WSTOPSIG(status) != (SIGTRAP|0x80))		// Signals to the tracee are discarded, it is still in the Sandbox code
+			continue;
+		if (ptrace(PTRACE_GET_SYSCALL_INFO, pid, sizeof(info), &info) <= 0)
+			return -1;
+
+		if (info.op == PTRACE_SYSCALL_INFO_ENTRY)
+			in_seccomp = (info.entry.nr == SYS_seccomp);
+		else if ((info.op == PTRACE_SYSCALL_INFO_EXIT) && (in_seccomp))
+		{
+			if (info.exit.is_error)
+				return -1;
+			pidfd = syscall(SYS_pidfd_open, pid, 0);
+			if (pidfd < 0)
+				return -1;
+			fd = syscall(SYS_pidfd_getfd, pidfd, (int)info.exit.rval, 0);
+			close(pidfd);
+			return fd;
+		}
+	}
+}
+
+/*! Runs the custom syscalls for one notification and fills the response.
+ *
+ * The chain is only run for the dispatched syscalls of the monitored processes, everything else is let to the kernel with SECCOMP_USER_NOTIF_FLAG_CONTINUE.
+ \param req The notification received
+ \param resp The response to send
+*/
+void answer_notification(struct seccomp_notif* req, struct seccomp_notif_resp* resp)
+{
+	syscall_dispatch_entry* entry;
+	syscall_context context;
+	long int args[6];
+	int i;
+	int no_kernel;
+
+	resp->id = req->id;
+	resp->val = 0;
+	resp->error = 0;
+	resp->flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE;
+
+	entry = get_dispatch_entry(req->data.nr);
+	if ((entry == NULL) || ((req->pid != (unsigned int)supervised_pid) && (! childProcessFlag)))
+		return;
+
+	for(i=0;i<6;i++)
+		args[i] = (long int)req->data.args[i];
+
+	context.tid = req->pid;
+	context.tgid = 0;
+	context.syscall_number = req->data.nr;
+	context.args = args;
+	context.return_value = DEFAULT_RETURN_VALUE;
+	context.kernel_return_value = DEFAULT_RETURN_VALUE;
+	context.kernel_executed = FALSE;
+	context.state = NULL;
+
+	// Always taken, even without shared_state: holding it at the end keeps the supervisor out of the unloaded libraries
+	pthread_mutex_lock(&library_lock);
+	no_kernel = execute_before_chain(entry, &context);
+	if (no_kernel)
+	{
+		// The filter only notifies the chains complete at the entry, the AFTER functions see no kernel result
+		execute_after_chain(entry, &context);
+		vprintf(CUSTOM_SYSCALL_S_RET_D,entry->before_chain[0].syscall->name, (int) context.return_value  );
+		resp->flags = 0;
+		resp->val = context.return_value;
+	}
+	pthread_mutex_unlock(&library_lock);
+	if (eventLogFile)		// The kernel result of a continued syscall never reaches the supervisor
+		record_event(req->pid, req->data.nr, args, DEFAULT_RETURN_VALUE, (no_kernel ? context.return_value : DEFAULT_RETURN_VALUE), chain_fired_libraries,
+			EVENT_CUSTOM | (no_kernel ? 0 : EVENT_KERNEL_EXECUTED | EVENT_NO_RETURN));
+}
+
+/*! Thread receiving the notifications of the listener until no process uses the filter anymore.
+ \param arg Unused
+ \return NULL
+*/
+void* supervisor_loop(void* arg)
+{
+	struct seccomp_notif_sizes sizes;
+	struct seccomp_notif* req;
+	struct seccomp_notif_resp* resp;
+	struct epoll_event event;
+	int epoll_fd;
+	int n;
+
+	// The kernel structures may grow, they are allocated with the sizes it reports
+	if (syscall(SYS_seccomp, SECCOMP_GET_NOTIF_SIZES, 0, &sizes) == -1)
+		return NULL;
+	req = (struct seccomp_notif*)malloc(sizes.seccomp_notif);
+	resp = (struct seccomp_notif_resp*)malloc(sizes.seccomp_notif_resp);
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if ((req == NULL) || (resp == NULL) || (epoll_fd == -1))
+		return NULL;
+
+	event.events = EPOLLIN;
+	event.data.fd = listener_fd;
+	epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener_fd, &event);
+
+	while (1)
+	{
+		n = epoll_wait(epoll_fd, &event, 1, -1);
+		if (n == -1)
+		{
+			if (errno == EINTR) continue;
+			break;
+		}
+		if (! (event.events & EPOLLIN))		// EPOLLHUP, all the processes with the filter are gone
+			break;
+
+		memset(req, 0, sizes.seccomp_notif);
+		if (ioctl(listener_fd, SECCOMP_IOCTL_NOTIF_RECV, req) == -1)
+			continue;		// The syscall was interrupted before being received
+
+		memset(resp, 0, sizes.seccomp_notif_resp);
+		answer_notification(req, resp);
+
+		// ENOENT if the process was killed or the syscall interrupted meanwhile, nothing to answer then
+		if ((ioctl(listener_fd, SECCOMP_IOCTL_NOTIF_SEND, resp) == -1) && (errno != ENOENT))
+			eprintf(ERROR_SUPERVISOR_D, req->pid);
+	}
+	close(epoll_fd);
+	free(req);
+	free(resp);
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+int supervise_PID(pid_t pid)
+{
+	int status;
+	int ret = -1;
+	pthread_t supervisor;
+
+	waitpid(pid, &status, 0);		// The tracee stopped itself with raise(SIGSTOP)
+	ptrace(PTRACE_SETOPTIONS, pid, 0, PTRACE_O_TRACESYSGOOD | PTRACE_O_EXITKILL);
+
+	listener_fd = take_listener(pid);
+	if (listener_fd == -1)
+	{
+		eprintf(ERROR_SUPERVISOR_LISTENER);
+		kill(pid, SIGKILL);
+		waitpid(pid, &status, 0);
+		return ret;
+	}
+	supervised_pid = pid;
+
+	pthread_create(&supervisor, NULL, supervisor_loop, NULL);
+	pthread_detach(supervisor);
+
+	if (filter_traced_syscalls > 0)
+	{
+		// Some syscalls need their AFTER functions at the kernel exit, they are still traced
+		vprintf(SUPERVISOR_STARTED_D_S, listener_fd, SUPERVISOR_HYBRID);
+		return trace_stopped_PID(pid);
+	}
+
+	vprintf(SUPERVISOR_STARTED_D_S, listener_fd, SUPERVISOR_ONLY);
+	ptrace(PTRACE_DETACH, pid, 0, 0);
+
+	while (waitpid(pid, &status, 0) != -1)
+	{
+		if (WIFEXITED(status))
+		{
+			vprintf(TRACEE_EXIT);
+			ret = WEXITSTATUS(status);
+			break;
+		}
+		if (WIFSIGNALED(status))
+		{
+			vprintf(TRACEE_EXIT_BY_SIGNAL_D,WTERMSIG(status));
+			break;
+		}
+	}
+	// The supervisor thread may still answer the children, it is kept out of the libraries from now on
+	pthread_mutex_lock(&library_lock);
+	return ret;
+}
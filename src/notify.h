@@ -0,0 +1,56 @@
+/*! \file notify.h
+    \brief Supervisor mode, answering the custom syscalls from seccomp user notifications instead of ptrace stops
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * With option -u the seccomp filter of the \b tracee returns SECCOMP_RET_USER_NOTIF for the syscalls whose chain completes at the entry:
+	 * no AFTER function, or the kernel is always skipped. The kernel then blocks the \b tracee and queues a notification on a listener fd.
+	 *
+	 * A supervisor thread waits on that fd with epoll, runs the chain with the arguments from struct seccomp_data, and answers either with the
+	 * return value of the chain, or with SECCOMP_USER_NOTIF_FLAG_CONTINUE so that the kernel executes the syscall. There is no ptrace stop, no register access.
+	 *
+	 * The syscalls that need the kernel return for their AFTER functions still use SECCOMP_RET_TRACE, and the main thread traces them as usual (trace.c).
+	 * If there is none, the \b tracee is not traced at all once the listener is taken.
+	 *
+	 * The filter is inherited by the children and threads of the \b tracee, all their notifications arrive on the same listener.
+	 *
+	 * \note Requires Linux 5.5 (SECCOMP_USER_NOTIF_FLAG_CONTINUE) and 5.6 (pidfd_getfd)
+	 * \note The custom libraries read the memory of a \b tracee that is not stopped by ptrace, see libSandboxHelper.c
+	 *
+	\see notify.c filter.c trace.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_NOTIFY	//Lock to prevent recursive inclusions
+#define INC_NOTIFY
+
+/*! Supervises the \b tracee until it ends, answering its seccomp user notifications.
+ *
+ * The \b tracee did PTRACE_TRACEME and stopped itself before installing its filter. It is followed until the exit of its seccomp() syscall,
+ * where the listener fd is taken with pidfd_getfd(). Then the supervisor thread is started, and the \b tracee is either traced with trace_stopped_PID()
+ * for the remaining SECCOMP_RET_TRACE syscalls, or detached.
+ *
+ * \param pid The PID of the child to be supervised
+ * \return the exit value of the Tracee, or -1 if terminated by signals
+*/
+int supervise_PID(pid_t pid);
+
+#endif
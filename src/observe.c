@@ -0,0 +1,243 @@
+/*! \file observe.c
+    \brief Worker thread running the observe-only functions of the custom syscalls
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see observe.h
+
+	\internal
+
+	* The queue is a bounded ring of cells, each with a sequence number (D. Vyukov's bounded queue).
+	* A producer takes a position with a compare-and-swap on observe_enqueue_pos, fills the cell and publishes it by storing position+1 in its sequence.
+	* The worker, the only consumer, takes the cell whose sequence is its position+1, and frees it for the next round with position+slots.
+	* The worker sleeps on a semaphore posted once per published call, which only enters the kernel if the worker is waiting.
+	*
+	* A call is a single allocation: the observe_call header, followed by the copies of the memory arguments.
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>					// For sched_yield()
+#include <pthread.h>
+#include <semaphore.h>
+
+#include "messages.h"
+#include "arena.h"
+#include "observe.h"
+
+/*! \brief A call of an observe-only function, waiting in the queue */
+typedef struct {
+	long int (*function)();				//!< The function to call
+	syscall_context context;			//!< Its context, args points to observe_call.args
+	long int args[ARENA_ARGUMENTS];		//!< The arguments, the memory arguments point after this structure
+	}
+observe_call;
+
+/*! \brief A slot of the queue */
+typedef struct {
+	unsigned long sequence;		//!< Position+1 once a call is published in it, position+slots once the worker took it
+	observe_call* call;			//!< The call, valid once published
+	}
+observe_cell;
+
+char observe_running = FALSE;
+
+observe_cell* observe_cells = NULL;			//!< The ring of cells
+unsigned long observe_mask = 0;				//!< Amount of cells - 1, a power of 2 - 1
+unsigned long observe_enqueue_pos = 0;		//!< Next position for the producers
+unsigned long observe_dequeue_pos = 0;		//!< Next position for the worker
+sem_t observe_published;					//!< Posted once per call published
+char observe_stopping = FALSE;				//!< Set by observe_stop(), the worker ends once the queue is empty
+pthread_t observe_thread;					//!< The worker thread
+
+unsigned long observe_calls = 0;			//!< Calls queued
+unsigned long observe_dropped = 0;			//!< Calls dropped, the queue was full
+unsigned long observe_max_depth = 0;		//!< Highest amount of calls waiting in the queue
+
+//-------------------------------------------------------------------------------------------------//
+
+/*! Takes the next call from the queue, waiting for its producer to publish it
+ \return the call, or NULL if the queue is empty
+*/
+observe_call* observe_dequeue(void)
+{
+	observe_cell* cell = &(observe_cells[observe_dequeue_pos & observe_mask]);
+	observe_call* call;
+
+	if (observe_dequeue_pos == __atomic_load_n(&observe_enqueue_pos, __ATOMIC_ACQUIRE))
+		return NULL;
+	// The position is taken, its producer may still be copying the call
+	while (__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) != observe_dequeue_pos + 1)
+		sched_yield();
+	call = cell->call;
+	__atomic_store_n(&(cell->sequence), observe_dequeue_pos + observe_mask + 1, __ATOMIC_RELEASE);
+	__atomic_store_n(&observe_dequeue_pos, observe_dequeue_pos + 1, __ATOMIC_RELEASE);
+	return call;
+}
+
+/*! Loop of the worker thread: runs the calls in the order of the queue, until observe_stop() and the queue is empty
+ \param arg Unused
+ \return NULL
+*/
+void* observe_worker(void* arg)
+{
+	observe_call* call;
+
+	while (1)
+	{
+		sem_wait(&observe_published);
+		call = observe_dequeue();
+		if (call == NULL)
+		{
+			if (__atomic_load_n(&observe_stopping, __ATOMIC_ACQUIRE))
+				break;
+			continue;
+		}
+		(call->function)(&(call->context));
+		free(call);
+	}
+	return NULL;
+}
+
+int observe_start(int slots)
+{
+	unsigned long size = 2;			// A cell is told free from published by its sequence, 1 cell is not enough
+	unsigned long i;
+
+	while ((int)size < slots)
+		size <<= 1;
+	observe_cells = (observe_cell*)malloc(size * sizeof(observe_cell));
+	if (observe_cells == NULL)
+	{
+		eprintf(ERROR_OBSERVE_START);
+		return 9;
+	}
+	for(i=0;i<size;i++)
+		observe_cells[i].sequence = i;
+	observe_mask = size - 1;
+
+	if ((sem_init(&observe_published, 0, 0) != 0) || (pthread_create(&observe_thread, NULL, observe_worker, NULL) != 0))
+	{
+		eprintf(ERROR_OBSERVE_START);
+		free(observe_cells);
+		observe_cells = NULL;
+		return 19;
+	}
+	observe_running = TRUE;
+	return RETURN_OK;
+}
+
+int observe_enqueue(long int (*function)(), buffer_descriptor* buffers, syscall_context* context)
+{
+	observe_call* call;
+	observe_cell* cell;
+	buffer_descriptor* buffer;
+	unsigned long pos, depth, highest;
+	size_t total = 0;
+	int length[ARENA_ARGUMENTS] = {0};
+	int declared = 0;
+	char* copy;
+	int i;
+
+	// The declared memory arguments point into the arena, they are copied after the call
+	for(i=0;(i<MAX_BUFFER_ARGUMENTS) && (buffers != NULL);i++)
+	{
+		buffer = &(buffers[i]);
+		if ((buffer->direction == 0) || (buffer->arg < 0) || (buffer->arg >= ARENA_ARGUMENTS) || (context->args[(int)buffer->arg] == 0))
+			continue;
+		if (! (declared & (1 << buffer->arg)))
+		{
+			declared |= 1 << buffer->arg;
+			length[(int)buffer->arg] = arena_buffer_length(buffer->arg);
+			total += length[(int)buffer->arg];
+		}
+	}
+
+	call = (observe_call*)malloc(sizeof(observe_call) + total);
+	if (call == NULL)
+	{
+		__atomic_fetch_add(&observe_dropped, 1, __ATOMIC_RELAXED);
+		return RETURN_ERR;
+	}
+	call->function = function;
+	call->context = *context;
+	call->context.args = call->args;
+	copy = (char*)(call + 1);
+	for(i=0;i<ARENA_ARGUMENTS;i++)
+	{
+		call->args[i] = context->args[i];
+		if (declared & (1 << i))
+			call->args[i] = 0;		// Empty, the arena slot is reused by the next syscall
+		if (length[i] > 0)
+		{
+			memcpy(copy, (void*)context->args[i], length[i]);
+			call->args[i] = (long int)copy;
+			copy += length[i];
+		}
+	}
+
+	pos = __atomic_load_n(&observe_enqueue_pos, __ATOMIC_RELAXED);
+	while (1)
+	{
+		cell = &(observe_cells[pos & observe_mask]);
+		if (__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) != pos)
+		{
+			if ((long)(__atomic_load_n(&(cell->sequence), __ATOMIC_ACQUIRE) - pos) < 0)
+			{
+				// The worker did not take the call of the previous round yet, the queue is full
+				__atomic_fetch_add(&observe_dropped, 1, __ATOMIC_RELAXED);
+				free(call);
+				return RETURN_ERR;
+			}
+			pos = __atomic_load_n(&observe_enqueue_pos, __ATOMIC_RELAXED);		// Taken by another producer
+			continue;
+		}
+		if (__atomic_compare_exchange_n(&observe_enqueue_pos, &pos, pos + 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+			break;
+	}
+	cell->call = call;
+	__atomic_store_n(&(cell->sequence), pos + 1, __ATOMIC_RELEASE);
+	sem_post(&observe_published);
+
+	__atomic_fetch_add(&observe_calls, 1, __ATOMIC_RELAXED);
+	depth = pos + 1 - __atomic_load_n(&observe_dequeue_pos, __ATOMIC_RELAXED);
+	highest = __atomic_load_n(&observe_max_depth, __ATOMIC_RELAXED);
+	while ((depth > highest) && (! __atomic_compare_exchange_n(&observe_max_depth, &highest, depth, FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+		;
+	return RETURN_OK;
+}
+
+void observe_stop(void)
+{
+	if (! observe_running)
+		return;
+	__atomic_store_n(&observe_stopping, TRUE, __ATOMIC_RELEASE);
+	sem_post(&observe_published);
+	pthread_join(observe_thread, NULL);
+	observe_running = FALSE;
+
+	if ((statsFlag) || (observe_dropped > 0))
+		printf(OBSERVE_QUEUE_STATS_LU_LU_LU_D, observe_calls, observe_dropped, observe_max_depth, (int)(observe_mask + 1));
+	sem_destroy(&observe_published);
+	free(observe_cells);
+	observe_cells = NULL;
+}
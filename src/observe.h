@@ -0,0 +1,71 @@
+/*! \file observe.h
+    \brief Worker thread running the observe-only functions of the custom syscalls, off the path of the tracee
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * A function with FLAG_OBSERVE_ONLY only looks at the syscall: its return value is ignored and it does not change the \b tracee.
+	 * Instead of running it in the chain, the tracer copies its context and its declared memory arguments into a bounded queue,
+	 * and resumes the \b tracee. A single worker thread takes the calls from the queue, in order, and runs them.
+	 *
+	 * The queue is lock-free, several tracer threads and the supervisor put calls in it. When it is full the call is dropped and counted.
+	 * Option -q sets its amount of slots. The calls, drops and highest depth are printed when the \b tracee ends, with option -c or if any call was dropped.
+	 * Before the libraries are unloaded, the worker runs all the calls left.
+	 *
+	 * With option -d, or before observe_start(), the observe-only functions run in the chain as context handlers.
+	 *
+	\see observe.c dynlib.c sandbox_customsyscall_descriptor.h
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_OBSERVE	//Lock to prevent recursive inclusions
+#define INC_OBSERVE
+
+#include "sandbox_customsyscall_descriptor.h"
+
+/** Default amount of slots of the queue */
+#define OBSERVE_QUEUE_DEFAULT	1024
+
+/** Maximum amount of slots of the queue, for option -q */
+#define OBSERVE_QUEUE_MAX		(1 << 20)
+
+/** TRUE while the worker thread takes the calls. \see observe_start() */
+extern char observe_running;
+
+/*! Creates the queue and starts the worker thread.
+ * \param slots is the amount of slots, rounded up to a power of 2
+ * \return RETURN_OK if the worker runs, <>RETURN_OK otherwise, the functions then run in the chains
+*/
+int observe_start(int slots);
+
+/*! Puts a call of an observe-only function in the queue, with a copy of the context and of the memory arguments it declared.
+ * \param function is the BEFORE or AFTER function
+ * \param buffers are the memory arguments declared by its custom syscall, NULL if none
+ * \param context is the context for the function, already prepared for its library. Its args are the ones for the function
+ * \return RETURN_OK if queued, RETURN_ERR if the call was dropped: queue full or no memory
+*/
+int observe_enqueue(long int (*function)(), buffer_descriptor* buffers, syscall_context* context);
+
+/*! Waits for the worker to run all the calls in the queue, and stops it.
+ * Prints the counters with option -c, or if any call was dropped.
+*/
+void observe_stop(void);
+
+#endif
@@ -40,6 +40,9 @@ SOFTWARE.
 #define OPTIONS_ERROR_LIBS	19
 #define OPTIONS_ERROR_PATH	9
 
+/** Maximum amount of tracer threads, option -j */
+#define MAX_TRACER_THREADS	64
+
 /*! Process the command line arguments when calling Sandbox.
  * \param argc number of arguments
  * \param argv array of arguments
@@ -0,0 +1,83 @@
+/*! \file profile.c
+    \brief Time spent by the tracer in each phase of a ptrace stop, compiled in with PROFILE only
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see profile.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+
+#include "messages.h"
+#include "stats.h"
+#include "profile.h"
+
+latency_histogram profile_table[PROFILE_PHASES];	//!< Histogram of every phase
+volatile sig_atomic_t profile_dump_requested = 0;	//!< Set by SIGUSR1
+
+/** Names of the phases, as printed */
+const char* profile_phase_names[PROFILE_PHASES] = { "wait", "read", "lookup", "chain", "write", "resume" };
+
+void profile_add(int phase, unsigned long long ns)
+{
+	histogram_add(&(profile_table[phase]), ns);
+}
+
+/*! Handler of SIGUSR1, the dump is done by a tracer thread, out of the signal handler */
+void profile_dump_handler(int sig)
+{
+	profile_dump_requested = 1;
+}
+
+void profile_init(void)
+{
+	struct sigaction action;
+
+	// No SA_RESTART, a tracer thread blocked in waitid() returns to dump
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = profile_dump_handler;
+	sigaction(SIGUSR1, &action, NULL);
+}
+
+void profile_check_dump(void)
+{
+	if ((profile_dump_requested) && (__sync_lock_test_and_set(&profile_dump_requested, 0)))
+		print_profile();
+}
+
+void print_profile(void)
+{
+	int i;
+	latency_histogram* h;
+
+	printf(PROFILE_HEADER);
+	for(i=0;i<PROFILE_PHASES;i++)
+	{
+		h = &(profile_table[i]);
+		printf(PROFILE_PHASE_S_LU_F, profile_phase_names[i], h->count, h->total_ns/1000.0);
+		print_percentiles(h);
+		printf(LF_CR);
+	}
+	fflush(stdout);
+}
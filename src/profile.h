@@ -0,0 +1,82 @@
+/*! \file profile.h
+    \brief Time spent by the tracer in each phase of a ptrace stop, compiled in with PROFILE only
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * The phases of a stop are timed in trace.c: the wait for the stop, the read of the syscall, the lookups of the tracee and of the
+	 * dispatch entry, the custom chains, the write of the registers and the resume. Each phase has a latency_histogram (stats.h).
+	 *
+	 * The histograms are printed when the \b tracee ends, or when the Sandbox receives SIGUSR1.
+	 *
+	 * Like dprintf() in messages.h, the macros compile to nothing unless PROFILE is defined, i.e. with
+	 * \code
+	make all GCC_DEFINES=-DPROFILE
+	\endcode
+	 * make profile does the same build, and checks that the phases are printed for testLibPID.
+	 *
+	\see profile.c trace.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_PROFILE	//Lock to prevent recursive inclusions
+#define INC_PROFILE
+
+/** Phases of a ptrace stop */
+#define PROFILE_WAIT		0	//!< Blocked in waitid(), until a tracee stops
+#define PROFILE_READ		1	//!< PTRACE_GET_SYSCALL_INFO, or PTRACE_GETREGS
+#define PROFILE_LOOKUP		2	//!< Finding the tracee in the table, and the dispatch entry of the syscall
+#define PROFILE_CHAIN		3	//!< BEFORE or AFTER chain of the custom syscalls
+#define PROFILE_WRITE		4	//!< PTRACE_POKEUSER of the registers
+#define PROFILE_RESUME		5	//!< PTRACE_CONT, or PTRACE_SYSCALL
+#define PROFILE_PHASES		6	//!< Amount of phases
+
+/** If defined, the phases are timed. */
+//#define PROFILE
+#ifdef PROFILE
+	#define PROFILE_START(t)		unsigned long long t = stats_now()
+	#define PROFILE_END(phase,t)	profile_add(phase, stats_now() - (t))
+	#define PROFILE_INIT()			profile_init()
+	#define PROFILE_CHECK_DUMP()	profile_check_dump()
+	#define PROFILE_DUMP()			print_profile()
+#else
+	#define PROFILE_START(t)
+	#define PROFILE_END(phase,t)
+	#define PROFILE_INIT()
+	#define PROFILE_CHECK_DUMP()
+	#define PROFILE_DUMP()
+#endif
+
+/*! Adds the time of a phase
+ * \param phase One of PROFILE_WAIT ... PROFILE_RESUME
+ * \param ns Time spent in the phase
+*/
+void profile_add(int phase, unsigned long long ns);
+
+/*! Installs the SIGUSR1 handler asking for a dump */
+void profile_init(void);
+
+/*! Prints the histograms if SIGUSR1 was received since the last call. Called by the tracer threads between stops */
+void profile_check_dump(void);
+
+/*! Prints the histograms of all the phases to STDOUT */
+void print_profile(void);
+
+#endif
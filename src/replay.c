@@ -0,0 +1,495 @@
+/*! \file replay.c
+    \brief Record and replay of the I/O syscalls of the tracee (options -R and -P)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see replay.h
+
+	\internal
+
+	* Each replayable syscall has a replay_spec: whether it works on a replayed socket, creates or closes one, and where its output buffers are.
+	* The size of an output buffer is the return value (read, recvfrom), a fixed struct size (fstat, gettimeofday),
+	* or the socklen_t the kernel wrote at another argument (accept, getsockname).
+	* The replayed sockets are kept in a bitmap of descriptors per process, a replay_fd_set.
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#define _GNU_SOURCE				// For process_vm_readv()
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+
+#include "messages.h"
+#include "dynlib.h"				// For MAX_SYSCALL_NUMBER
+#include "replay.h"
+#include "syscalls.h"
+
+#define SPEC_NEEDS_FD	1		//!< Replayed only if the first argument is a replayed socket
+#define SPEC_CREATES_FD	2		//!< The return value is a new replayed socket
+#define SPEC_CLOSES_FD	4		//!< The first argument stops being a replayed socket
+
+#define SIZE_NONE		0		//!< No output buffer
+#define SIZE_RETURN		1		//!< As many bytes as the return value
+#define SIZE_FIXED		2		//!< A fixed amount of bytes
+#define SIZE_SOCKLEN	3		//!< The socklen_t pointed to by another argument, after the call
+
+#define ERESTARTSYS				512		//!< Kernel internal errno, the syscall is restarted after the signal handler
+#define ERESTART_RESTARTBLOCK	516		//!< Last of the kernel internal restart errnos
+
+/*! \brief Output buffer of a replayable syscall */
+typedef struct {
+	char arg;					//!< Argument with the address of the buffer
+	char size_kind;				//!< SIZE_ constant
+	char size_arg;				//!< Argument pointing to the socklen_t, for SIZE_SOCKLEN
+	unsigned short size;		//!< Size for SIZE_FIXED
+	}
+replay_output;
+
+/*! \brief How a syscall is recorded and replayed */
+typedef struct {
+	int nr;										//!< Syscall number
+	int flags;									//!< SPEC_ flags
+	replay_output outputs[REPLAY_MAX_OUTPUTS];	//!< Output buffers, SIZE_NONE after the last one
+	}
+replay_spec;
+
+/** Output buffer of the address and length arguments of accept(), getsockname(), getpeername() */
+#define ADDRESS_OUTPUTS(addr, len)	{ {addr, SIZE_SOCKLEN, len, 0}, {len, SIZE_FIXED, 0, sizeof(socklen_t)} }
+
+replay_spec replay_specs[] = {
+	{ SYS_socket,		SPEC_CREATES_FD,					{ } },
+#ifdef SYS_accept
+	{ SYS_accept,		SPEC_NEEDS_FD | SPEC_CREATES_FD,	ADDRESS_OUTPUTS(1, 2) },
+#endif
+	{ SYS_accept4,		SPEC_NEEDS_FD | SPEC_CREATES_FD,	ADDRESS_OUTPUTS(1, 2) },
+	{ SYS_close,		SPEC_NEEDS_FD | SPEC_CLOSES_FD,		{ } },
+	{ SYS_bind,			SPEC_NEEDS_FD,						{ } },
+	{ SYS_listen,		SPEC_NEEDS_FD,						{ } },
+	{ SYS_connect,		SPEC_NEEDS_FD,						{ } },
+	{ SYS_shutdown,		SPEC_NEEDS_FD,						{ } },
+	{ SYS_setsockopt,	SPEC_NEEDS_FD,						{ } },
+	{ SYS_getsockopt,	SPEC_NEEDS_FD,						ADDRESS_OUTPUTS(3, 4) },
+	{ SYS_getsockname,	SPEC_NEEDS_FD,						ADDRESS_OUTPUTS(1, 2) },
+	{ SYS_getpeername,	SPEC_NEEDS_FD,						ADDRESS_OUTPUTS(1, 2) },
+	{ SYS_read,			SPEC_NEEDS_FD,						{ {1, SIZE_RETURN, 0, 0} } },
+	{ SYS_pread64,		SPEC_NEEDS_FD,						{ {1, SIZE_RETURN, 0, 0} } },
+	{ SYS_write,		SPEC_NEEDS_FD,						{ } },
+	{ SYS_pwrite64,		SPEC_NEEDS_FD,						{ } },
+#ifdef SYS_recvfrom
+	{ SYS_recvfrom,		SPEC_NEEDS_FD,						{ {1, SIZE_RETURN, 0, 0}, {4, SIZE_SOCKLEN, 5, 0}, {5, SIZE_FIXED, 0, sizeof(socklen_t)} } },
+	{ SYS_sendto,		SPEC_NEEDS_FD,						{ } },
+#endif
+	{ SYS_fstat,		SPEC_NEEDS_FD,						{ {1, SIZE_FIXED, 0, sizeof(struct stat)} } },
+	{ SYS_gettimeofday,	0,									{ {0, SIZE_FIXED, 0, sizeof(struct timeval)}, {1, SIZE_FIXED, 0, sizeof(struct timezone)} } },
+	{ SYS_clock_gettime,0,									{ {1, SIZE_FIXED, 0, sizeof(struct timespec)} } },
+#ifdef SYS_time
+	{ SYS_time,			0,									{ {0, SIZE_FIXED, 0, sizeof(time_t)} } },
+#endif
+};
+
+replay_spec* replay_spec_of[MAX_SYSCALL_NUMBER];		//!< Spec of each syscall number, NULL if not replayable
+
+FILE* record_file = NULL;						//!< File being written with -R
+char* replay_data = NULL;						//!< Whole file read with -P
+list* replay_streams = NULL;					//!< replay_stream of each tracee in the file, with -P
+char replay_aborted = FALSE;
+
+/*! \brief Records of one tracee, with -P */
+typedef struct {
+	uint64_t id;				//!< Number of the tracee
+	list* records;				//!< Pointers to its replay_record, in order
+	}
+replay_stream;
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+/*! Tells whether a descriptor is a replayed socket
+ * \param fds Set of the process
+ * \param fd descriptor
+ * \return TRUE or FALSE
+*/
+int is_replayed_fd(replay_fd_set* fds, long int fd)
+{
+	if ((fd < 0) || (fd >= REPLAY_MAX_FDS))
+		return FALSE;
+	return (fds->bits[fd/8] >> (fd%8)) & 1;
+}
+
+/*! Marks or unmarks a descriptor as replayed socket
+ * \param fds Set of the process
+ * \param fd descriptor
+ * \param replayed TRUE or FALSE
+*/
+void set_replayed_fd(replay_fd_set* fds, long int fd, int replayed)
+{
+	if ((fd < 0) || (fd >= REPLAY_MAX_FDS))
+		return;
+	if (replayed)
+		fds->bits[fd/8] |= (1 << (fd%8));
+	else
+		fds->bits[fd/8] &= ~(1 << (fd%8));
+}
+
+/*! Copies memory of the tracee
+ * \param pid TID of the tracee
+ * \param addr in the tracee
+ * \param buf in the Sandbox
+ * \param n bytes
+ * \param write TRUE to copy buf into the tracee, FALSE to copy the tracee into buf
+ * \return RETURN_OK if the n bytes were copied
+*/
+int copy_tracee_memory(pid_t pid, long int addr, void* buf, size_t n, int write)
+{
+	struct iovec local, remote;
+	ssize_t done;
+
+	local.iov_base = buf;
+	local.iov_len = n;
+	remote.iov_base = (void*)addr;
+	remote.iov_len = n;
+	done = (write ? process_vm_writev(pid, &local, 1, &remote, 1, 0) : process_vm_readv(pid, &local, 1, &remote, 1, 0));
+	return ((done == (ssize_t)n) ? RETURN_OK : 9);
+}
+
+/*! Finds the records of a tracee in the loaded file
+ * \param id Number of the tracee
+ * \return its list of records, NULL if it has none
+*/
+list* find_stream(uint64_t id)
+{
+	replay_stream* stream;
+
+	seek(replay_streams, 0);
+	while (has_next(replay_streams))
+	{
+		stream = (replay_stream*)get_next(replay_streams);
+		if (stream->id == id)
+			return stream->records;
+	}
+	return NULL;
+}
+
+/*! Reads the whole record file of option -P and splits it per tracee
+ * \return RETURN_OK if the file was loaded
+*/
+int load_replay_file(void)
+{
+	FILE* f;
+	long size;
+	char* p;
+	char* end;
+	replay_record* record;
+	replay_buffer* buffer;
+	replay_stream* stream;
+	list* records;
+	uint32_t i;
+	int count = 0;
+
+	f = fopen(replayFile, "rbe");
+	if ((f == NULL) || (fseek(f, 0, SEEK_END) != 0) || ((size = ftell(f)) < (long)sizeof(replay_file_header)))
+	{
+		if (f != NULL) fclose(f);
+		return 9;
+	}
+	rewind(f);
+	replay_data = (char*)malloc(size);
+	if ((replay_data == NULL) || (fread(replay_data, 1, size, f) != (size_t)size))
+	{
+		fclose(f);
+		return 19;
+	}
+	fclose(f);
+	if ((memcmp(((replay_file_header*)replay_data)->magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0) || (((replay_file_header*)replay_data)->version != REPLAY_VERSION))
+		return 29;
+
+	replay_streams = new_list();
+	p = replay_data + sizeof(replay_file_header);
+	end = replay_data + size;
+	while (p + sizeof(replay_record) <= end)
+	{
+		record = (replay_record*)p;
+		p += sizeof(replay_record);
+		for(i=0;i<record->buffers;i++)
+		{
+			buffer = (replay_buffer*)p;
+			if ((p + sizeof(replay_buffer) > end) || (p + sizeof(replay_buffer) + buffer->length > end))
+				return 39;		// Truncated, the recording was interrupted in the middle of a record
+			p += sizeof(replay_buffer) + buffer->length;
+		}
+		records = find_stream(record->tracee);
+		if (records == NULL)
+		{
+			stream = (replay_stream*)malloc(sizeof(replay_stream));
+			stream->id = record->tracee;
+			stream->records = records = new_list();
+			append_item(replay_streams, stream);
+		}
+		append_item(records, record);
+		count++;
+	}
+	vprintf(REPLAY_LOADED_S_D_D, replayFile, count, replay_streams->counter);
+	return RETURN_OK;
+}
+
+int open_replay(void)
+{
+	replay_file_header header;
+	int i;
+
+	syscall_dispatch_entry* entry;
+
+	for(i=0;i<(int)(sizeof(replay_specs)/sizeof(replay_spec));i++)
+		if (replay_specs[i].nr < MAX_SYSCALL_NUMBER)
+			replay_spec_of[replay_specs[i].nr] = &(replay_specs[i]);
+
+	// The chains run instead of the recording, and their results would not be the recorded ones
+	for(i=0;i<(int)(sizeof(replay_specs)/sizeof(replay_spec));i++)
+	{
+		entry = get_dispatch_entry(replay_specs[i].nr);
+		if (entry != NULL)
+		{
+			eprintf(ERROR_REPLAY_HOOKED_S_S, syscall_name(replay_specs[i].nr), entry->before_chain[0].library->name);
+			return 29;
+		}
+	}
+
+	if (replayFile != NULL)
+	{
+		if (load_replay_file() != RETURN_OK)
+		{
+			eprintf(ERROR_REPLAY_FILE_S, replayFile);
+			return 9;
+		}
+		return RETURN_OK;
+	}
+
+	record_file = fopen(recordFile, "wbe");		// Close on exec, the descriptors of the tracee must be numbered as without Sandbox
+	if (record_file == NULL)
+	{
+		eprintf(ERROR_REPLAY_FILE_S, recordFile);
+		return 19;
+	}
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+	header.version = REPLAY_VERSION;
+	fwrite(&header, sizeof(header), 1, record_file);
+	vprintf(REPLAY_RECORDING_S, recordFile);
+	return RETURN_OK;
+}
+
+void close_replay(void)
+{
+	if (record_file != NULL)
+		fclose(record_file);
+	record_file = NULL;
+}
+
+int replay_traced_syscall(int nr)
+{
+	if ((recordFile == NULL) && (replayFile == NULL))
+		return FALSE;
+	return ((nr >= 0) && (nr < MAX_SYSCALL_NUMBER) && (replay_spec_of[nr] != NULL));
+}
+
+replay_tracee* replay_new_tracee(void)
+{
+	replay_tracee* r = (replay_tracee*)calloc(1, sizeof(replay_tracee));
+
+	if (r == NULL)
+		return NULL;
+	r->fds = (replay_fd_set*)calloc(1, sizeof(replay_fd_set));
+	if (r->fds == NULL)
+	{
+		free(r);
+		return NULL;
+	}
+	r->fds->users = 1;
+	r->id = REPLAY_MAIN_ID;
+	r->reserved_fd = -1;
+	return r;
+}
+
+void replay_free_tracee(replay_tracee* r)
+{
+	if (--(r->fds->users) == 0)
+		free(r->fds);
+	free(r);
+}
+
+void replay_new_child(replay_tracee* parent, replay_tracee* child, int thread)
+{
+	parent->children++;
+	child->id = parent->id * REPLAY_FANOUT + parent->children;
+	if (thread)
+	{
+		free(child->fds);
+		child->fds = parent->fds;
+		child->fds->users++;
+	}
+	else
+		memcpy(child->fds->bits, parent->fds->bits, sizeof(child->fds->bits));
+}
+
+int replay_syscall_entry(replay_tracee* r, pid_t pid, int nr, long int* args, long int* result)
+{
+	replay_spec* spec;
+	replay_record* record;
+	replay_buffer* buffer;
+	char* data;
+	uint32_t i;
+
+	if ((r->diverged) || (! replay_traced_syscall(nr)))
+		return REPLAY_PASS;
+	spec = replay_spec_of[nr];
+	if ((spec->flags & SPEC_NEEDS_FD) && (! is_replayed_fd(r->fds, args[0])))
+		return REPLAY_PASS;
+
+	if (record_file != NULL)
+	{
+		r->pending = TRUE;
+		return REPLAY_RECORD;
+	}
+
+	if (r->records == NULL)
+		r->records = find_stream(r->id);
+	if ((r->records == NULL) || (! has_next(r->records)))
+	{
+		vprintf(REPLAY_END_D, pid);
+		r->parked = TRUE;
+		return REPLAY_END;
+	}
+	record = (replay_record*)get_next(r->records);
+	if (record->nr != nr)
+	{
+		eprintf(ERROR_REPLAY_DIVERGED_D_S_S, pid, syscall_name(nr), syscall_name(record->nr));
+		r->diverged = TRUE;
+		return REPLAY_PASS;
+	}
+
+	// The recorded outputs are written where this run has its buffers
+	data = (char*)(record + 1);
+	for(i=0;i<record->buffers;i++)
+	{
+		buffer = (replay_buffer*)data;
+		if ((args[buffer->arg] != 0) && (copy_tracee_memory(pid, args[buffer->arg], buffer + 1, buffer->length, TRUE) != RETURN_OK))
+			dprintf("Unable to write %u bytes of the replay in pid %d\n", buffer->length, pid);
+		data += sizeof(replay_buffer) + buffer->length;
+	}
+	*result = record->result;
+
+	if (spec->flags & SPEC_CLOSES_FD)
+	{
+		set_replayed_fd(r->fds, args[0], FALSE);
+		return REPLAY_PASS;				// Closes the placeholder socket
+	}
+	if ((spec->flags & SPEC_CREATES_FD) && (record->result >= 0))
+	{
+		set_replayed_fd(r->fds, record->result, TRUE);
+		r->reserved_fd = record->result;
+		return REPLAY_RESERVE_FD;
+	}
+	return REPLAY_EMULATED;
+}
+
+void record_syscall_exit(replay_tracee* r, pid_t pid, int nr, long int* args, long int result)
+{
+	replay_spec* spec = replay_spec_of[nr];
+	replay_record record;
+	replay_buffer buffers[REPLAY_MAX_OUTPUTS];
+	void* data[REPLAY_MAX_OUTPUTS];
+	socklen_t socklen;
+	long int size;
+	int i;
+
+	r->pending = FALSE;
+	if ((result <= -ERESTARTSYS) && (result >= -ERESTART_RESTARTBLOCK))
+		return;			// Interrupted by a signal, the kernel enters the syscall again
+	record.tracee = r->id;
+	record.nr = nr;
+	record.buffers = 0;
+	record.result = result;
+
+	for(i=0;(i<REPLAY_MAX_OUTPUTS) && (result >= 0);i++)
+	{
+		size = 0;
+		switch (spec->outputs[i].size_kind)
+		{
+		case SIZE_RETURN:
+			size = result;
+			break;
+		case SIZE_FIXED:
+			size = spec->outputs[i].size;
+			break;
+		case SIZE_SOCKLEN:
+			if ((args[(int)spec->outputs[i].size_arg] != 0) && (copy_tracee_memory(pid, args[(int)spec->outputs[i].size_arg], &socklen, sizeof(socklen), FALSE) == RETURN_OK))
+				size = socklen;
+			break;
+		}
+		if ((size <= 0) || (args[(int)spec->outputs[i].arg] == 0))
+			continue;
+		if (size > REPLAY_MAX_BUFFER)
+			size = REPLAY_MAX_BUFFER;
+
+		data[record.buffers] = malloc(size);
+		if ((data[record.buffers] == NULL) || (copy_tracee_memory(pid, args[(int)spec->outputs[i].arg], data[record.buffers], size, FALSE) != RETURN_OK))
+		{
+			free(data[record.buffers]);
+			continue;
+		}
+		buffers[record.buffers].arg = spec->outputs[i].arg;
+		buffers[record.buffers].length = size;
+		record.buffers++;
+	}
+
+	fwrite(&record, sizeof(record), 1, record_file);
+	for(i=0;i<(int)record.buffers;i++)
+	{
+		fwrite(&(buffers[i]), sizeof(replay_buffer), 1, record_file);
+		fwrite(data[i], 1, buffers[i].length, record_file);
+		free(data[i]);
+	}
+	fflush(record_file);		// The Sandbox may be interrupted, the tracee is then killed
+
+	if ((spec->flags & SPEC_CREATES_FD) && (result >= 0))
+		set_replayed_fd(r->fds, result, TRUE);
+	if ((spec->flags & SPEC_CLOSES_FD) && (result == 0))
+		set_replayed_fd(r->fds, args[0], FALSE);
+}
+
+int replay_reserved_fd_exit(replay_tracee* r, pid_t pid, long int result)
+{
+	long int expected = r->reserved_fd;
+
+	r->reserved_fd = -1;
+	if (result == expected)
+		return RETURN_OK;
+	// The replayed syscalls are matched by descriptor, the next ones of the tracee would use another file
+	eprintf(ERROR_REPLAY_FD_D_LD_LD, pid, result, expected);
+	replay_aborted = TRUE;
+	return 9;
+}
@@ -0,0 +1,188 @@
+/*! \file replay.h
+    \brief Record and replay of the I/O syscalls of the tracee, for deterministic reruns without the kernel (options -R and -P)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * With option -R the tracer stops at the exit of the replayable syscalls: sockets, the reads and writes on those sockets, fstat and the time syscalls.
+	 * For each one the kernel return value is written to the record file, with the bytes the kernel wrote in the output buffers of the \b tracee.
+	 *
+	 * With option -P the same syscalls are answered from the record file at their entry, the kernel skips them as with FLAG_DONT_CALL_KERNEL.
+	 * The output buffers are written in the \b tracee, so it runs the recorded session at full CPU speed, without network, disk or waits.
+	 * The syscalls creating a socket (socket, accept) are turned into socket(AF_UNIX, SOCK_DGRAM, 0), so that the descriptor number exists in the \b tracee
+	 * and the descriptors it opens later are numbered as in the recording. Closing them runs in the kernel.
+	 *
+	 * Only the sockets created while tracing are replayed: reads and writes on other descriptors (files, stdin, stdout) always run in the kernel.
+ * The replayed sockets are tracked per process: threads share the set of their process, a forked child gets a copy.
+	 * Syscalls implemented by a custom library are neither recorded nor replayed, the libraries run as usual.
+	 *
+	 * Each tracee has its own sequence of records. The main \b tracee is number 1, the n-th child or thread of tracee k is k*REPLAY_FANOUT+n,
+	 * so the numbering does not depend on the scheduling as long as each tracee creates its children in the same order.
+	 * A record that does not match the syscall being replayed stops the replay of that tracee, its syscalls run in the kernel from then on.
+	 * When the records of a tracee are exhausted, it is parked: left stopped at that syscall, as it was when the recording ended.
+ * The parked tracees are killed once no other tracee runs, the recorded session is then over.
+ * Results asking the kernel to restart the syscall after a signal (-ERESTARTSYS...) are not recorded, the restarted syscall is.
+	 *
+	 * File format: a replay_file_header, then for each syscall a replay_record followed by its buffers, each a replay_buffer and its bytes.
+	 *
+	\see replay.c trace.c filter.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_REPLAY	//Lock to prevent recursive inclusions
+#define INC_REPLAY
+
+#include <stdint.h>
+#include <sys/types.h>
+#include "list.h"
+
+/** First bytes of a record file */
+#define REPLAY_MAGIC		"SBXRPL1"
+/** Version of the format */
+#define REPLAY_VERSION		1
+/** Number of the main tracee */
+#define REPLAY_MAIN_ID		1
+/** Children per tracee in the numbering of the tracees */
+#define REPLAY_FANOUT		1000
+/** Output buffers of a syscall */
+#define REPLAY_MAX_OUTPUTS	3
+/** Largest output buffer recorded */
+#define REPLAY_MAX_BUFFER	(1<<20)
+/** Descriptors that can be tracked as replayed sockets */
+#define REPLAY_MAX_FDS		4096
+
+/** replay_syscall_entry() result: the syscall runs in the kernel, its exit is not needed */
+#define REPLAY_PASS			0
+/** replay_syscall_entry() result: recording, the exit stop is needed for record_syscall_exit() */
+#define REPLAY_RECORD		1
+/** replay_syscall_entry() result: the syscall is skipped, the result is delivered to the tracee */
+#define REPLAY_EMULATED		2
+/** replay_syscall_entry() result: the syscall is turned into socket(AF_UNIX, SOCK_DGRAM, 0), to reserve the descriptor */
+#define REPLAY_RESERVE_FD	3
+/** replay_syscall_entry() result: the records of the tracee are exhausted, it is parked */
+#define REPLAY_END			4
+
+/*! \brief Start of the record file */
+typedef struct {
+	char magic[8];				//!< REPLAY_MAGIC
+	uint32_t version;			//!< REPLAY_VERSION
+	uint32_t reserved;			//!< Padding
+	}
+replay_file_header;
+
+/*! \brief One syscall in the record file, followed by its buffers */
+typedef struct {
+	uint64_t tracee;			//!< Number of the tracee, see REPLAY_FANOUT
+	int32_t nr;					//!< Syscall number
+	uint32_t buffers;			//!< Amount of replay_buffer following
+	int64_t result;				//!< Kernel return value
+	}
+replay_record;
+
+/*! \brief Output buffer of a syscall, followed by its bytes */
+typedef struct {
+	uint32_t arg;				//!< Argument holding the address of the buffer
+	uint32_t length;			//!< Amount of bytes
+	}
+replay_buffer;
+
+/*! \brief Set of the replayed sockets of a process */
+typedef struct {
+	int users;								//!< Tracees using the set, the threads of the process
+	unsigned char bits[REPLAY_MAX_FDS/8];	//!< Bit fd is set if the descriptor is a replayed socket
+	}
+replay_fd_set;
+
+/*! \brief Record and replay state of a tracee, in its tracee_flow_descriptor */
+typedef struct {
+	uint64_t id;				//!< Number of the tracee in the record file
+	int children;				//!< Children and threads created so far
+	char pending;				//!< Recording, the exit stop of the syscall is expected
+	char diverged;				//!< Replay stopped for this tracee
+	char parked;				//!< Records exhausted, the tracee is not resumed anymore
+	long int reserved_fd;		//!< Descriptor of the recording that the placeholder socket must get, -1 if none is being created
+	replay_fd_set* fds;			//!< Replayed sockets of its process
+	list* records;				//!< Records left to replay, NULL until its first replayed syscall
+	}
+replay_tracee;
+
+/** Set when the replay of option -P cannot go on, the Sandbox then ends with an error */
+extern char replay_aborted;
+
+/*! Opens the record file of option -R, or loads the one of option -P.
+ * The syscalls hooked by a custom library are neither recorded nor replayed, -R and -P are refused if one of them is replayable
+ * \return RETURN_OK if the file is ready, <>RETURN_OK otherwise
+*/
+int open_replay(void);
+
+/*! Flushes and closes the record file */
+void close_replay(void);
+
+/*! Tells whether the filter must stop the tracee at a syscall, for recording or replaying it
+ * \param nr Syscall number
+ * \return TRUE if the syscall is replayable and -R or -P was given
+*/
+int replay_traced_syscall(int nr);
+
+/*! Allocates the state of a new tracee, numbered as the main one
+ * \return the state, NULL if memory could not be allocated
+*/
+replay_tracee* replay_new_tracee(void);
+
+/*! Frees the state of a tracee that ended
+ * \param r State of the tracee
+*/
+void replay_free_tracee(replay_tracee* r);
+
+/*! Numbers a new child or thread, in the order its parent creates them, and gives it the replayed sockets of the parent
+ * \param parent The tracee that forked or cloned
+ * \param child The new one
+ * \param thread TRUE if the child shares the descriptors of the parent (PTRACE_EVENT_CLONE), FALSE if it has a copy
+*/
+void replay_new_child(replay_tracee* parent, replay_tracee* child, int thread);
+
+/*! Decides what happens to a syscall at its entry stop. With -P, the output buffers are written in the tracee already
+ * \param r State of the tracee
+ * \param pid TID of the tracee
+ * \param nr Syscall number
+ * \param args Its arguments
+ * \param result Return value to deliver, for REPLAY_EMULATED
+ * \return REPLAY_PASS, REPLAY_RECORD, REPLAY_EMULATED, REPLAY_RESERVE_FD, or REPLAY_END with r->parked set
+*/
+int replay_syscall_entry(replay_tracee* r, pid_t pid, int nr, long int* args, long int* result);
+
+/*! Writes the record of a syscall, at its exit stop
+ * \param r State of the tracee, r->pending is cleared
+ * \param pid TID of the tracee
+ * \param nr Syscall number
+ * \param args Its arguments, as read at the entry
+ * \param result Kernel return value
+*/
+void record_syscall_exit(replay_tracee* r, pid_t pid, int nr, long int* args, long int result);
+
+/*! Checks, at the exit of a placeholder socket of REPLAY_RESERVE_FD, that the kernel gave the descriptor of the recording
+ * \param r Replay state of the tracee
+ * \param pid of the tracee
+ * \param result Descriptor returned by the kernel
+ * \return RETURN_OK if it is the recorded one. Otherwise replay_aborted is set, the tracees must be killed
+*/
+int replay_reserved_fd_exit(replay_tracee* r, pid_t pid, long int result);
+
+#endif
@@ -10,6 +10,8 @@
        All libraries have to be loaded before execution (opts.c).
        All the custom libraries are inspected for Custom Syscalls (dynlib.c), if any error is found the execution is aborted.
 
+   2) A seccomp filter is built from the loaded custom libraries (filter.c). The \b tracee installs it just before execv(), so only the custom syscalls stop it.
+
    3) After a message and confirmation by the user ([ENTER]), it will start the \b tracee as a child process, and will monitor its system calls.
     In EXPLICIT/DUBUG mode, for each captured systemcall, the syscall will be printed in STDERR.   (  \link trace.c  \endlink )
 
@@ -45,10 +47,21 @@ SOFTWARE.
 #include <unistd.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <signal.h>		// For raise()
+#include <sys/ptrace.h>	// For PTRACE_TRACEME
 #include "trace.h"		// Functions for tracing syscalls
 #include "opts.h"		// Functions for treating command options
 #include "dynlib.h"		// Functions for loading the dyamic libraries
 #include "messages.h"	// Functions for error messages printing
+#include "filter.h"		// Functions for the seccomp pre-filter
+#include "notify.h"		// Supervisor on seccomp user notifications
+#include "dispatch.h"	// In-process runtime on Syscall User Dispatch
+#include "stats.h"		// Statistics of option -c
+#include "profile.h"	// Phases of the stops, with PROFILE
+#include "eventlog.h"	// Binary log of option -o
+#include "replay.h"		// Record and replay of options -R and -P
+#include "memmap.h"		// Memory maps of the tracees
+#include "observe.h"	// Worker of the observe-only functions
 
 
 /*! Main
@@ -76,6 +89,15 @@ int main (int argc, char **argv)
 	//printf(LF_CR);
 	printf(LIBRARIES_LOADED_D,custom_libs_list->counter );
 	//printf(LF_CR);
+	if (dispatchFlag)
+		warn_signal_unsafe_libraries();
+
+	//The execution plan of each syscall is computed once, all libraries are loaded
+	if (build_dispatch_table() != RETURN_OK)
+	{
+		unload_libraries();
+		exit(59);
+	}
 
 	//Pressing ENTER is required after loading the libraries
 	//PRINTF_CONTINUE();
@@ -86,11 +108,51 @@ int main (int argc, char **argv)
 			exit(0);
 		}
 
+	// Before the filter, which traces the replayable syscalls
+	if (((recordFile) || (replayFile)) && (open_replay() != RETURN_OK))
+	{
+		unload_libraries();
+		exit(59);
+	}
+	// The maps of the tracees, queried by the memory helpers
+	if (init_memory_maps() != RETURN_OK)
+	{
+		unload_libraries();
+		exit(59);
+	}
+	if (build_syscall_filter() != RETURN_OK)
+	{
+		unload_libraries();
+		exit(59);
+	}
+	if ((eventLogFile) && (open_event_log(eventLogFile) != RETURN_OK))
+	{
+		unload_libraries();
+		exit(59);
+	}
+
 	printf(LINE);
 
 	switch (pid=fork())
 	{
 	case 0:  //Child
+		if (dispatchFlag)
+		{
+			// Not traced, the runtime preloaded by execv() runs the custom syscalls
+			if (prepare_dispatch_environment() != RETURN_OK)
+				exit(59);
+		}
+		else
+		{
+			// The Tracee stops itself so that the tracer sets the options before any syscall is filtered
+			ptrace(PTRACE_TRACEME, 0, 0, 0);
+			raise(SIGSTOP);
+			if (install_syscall_filter() != RETURN_OK)
+			{
+				eprintf(ERROR_FILTER_INSTALL);
+				exit(59);
+			}
+		}
 		execv (argv[optind], argv+optind);
 		execvp (argv[optind], argv+optind);
 		eprintf(ERROR_EXEC_S,argv[optind]);		//Print Error
@@ -102,15 +164,31 @@ int main (int argc, char **argv)
 		exit(49);
 	break;
 	default:
-		c = trace_PID(pid);
+		if (dispatchFlag)
+			c = wait_dispatched_PID(pid);
+		else
+		{
+			// Without the worker, the observe-only functions run in the chains
+			if (libraries_observe)
+				observe_start(observeQueueSlots);
+			c = (userNotifFlag ? supervise_PID(pid) : trace_PID(pid));
+		}
 		//check_child_processes();
 		printf(LINE);
 		printf(TRACEE_END_D,c);
+		observe_stop();
+		if (statsFlag)
+			print_stats();
+		PROFILE_DUMP();
+		close_event_log();
+		close_replay();
 		// Once the tracePID return, is because the Child PID died
 		unload_libraries();
 	break;
 	}//End of Switch
 
 	printf("\n");
+	if (replay_aborted)
+		return 69;		// The tracees were killed, the replay did not reach its end
 	return 0;
 } //End of Function
@@ -23,6 +23,25 @@
 	\code
 	custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR;
 	tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR;
+	\endcode
+
+	\note Instead of the array indexed by syscall number, a library may list only the syscalls it hooks, in a custom_library_v2_descriptor.
+	* Any syscall number below MAX_SYSCALL_NUMBER can be hooked this way, also the ones newer than the tables of the Sandbox.
+	\code
+	custom_syscall_entry my_syscalls[] = {
+		{ SYSCALL_NR_time, {NULL, mytime, "time", 0} },
+		{ 437, {myopenat2, NULL, "openat2", 0} }
+	};
+	custom_library_v2_descriptor CUSTOM_LIBRARY_V2_DESCRIPTOR = { CUSTOM_LIBRARY_VERSION, NULL, NULL, my_syscalls, 2, "libmine" };
+	\endcode
+	*
+	* A custom syscall of this format may also declare which arguments point to buffers of the tracee, and how long they are (see buffer_descriptor).
+	* The Sandbox then copies them once per stop into its memory, the functions receive local pointers instead of tracee addresses,
+	* and only the bytes they changed are written back to the tracee.
+	* The array format has no room for them: its custom_syscall_descriptor keeps the size of the first version, so that built libraries keep loading.
+	\code
+	{ SYSCALL_NR_nanosleep, {mynanosleep, NULL, "nanosleep", 0}, { BUFFER_FIXED(0, BUFFER_INOUT, sizeof(struct timespec)) } },
+	{ SYSCALL_NR_read,      {NULL, myread, "read", 0},           { BUFFER_RETURN(1, BUFFER_INOUT, 4096) } },
 	\endcode
 
 	 \note	Please compile the library with the following command:
@@ -58,16 +77,21 @@ SOFTWARE.
 #ifndef INC_SANDBOX_CUSTOMSYSCALL_DESC	//Lock to prevent recursive inclusions
 #define INC_SANDBOX_CUSTOMSYSCALL_DESC
 
-#ifdef __x86_64__
-	#define MAX_SYSCALL_INDEX 316
-#endif
-#ifdef __i386__
-	#define MAX_SYSCALL_INDEX 358
-#endif
+/** Syscall numbers that a library may hook are below this limit, well above the highest syscall of the current kernels */
+#define MAX_SYSCALL_NUMBER	1024
+
+/** Version of custom_library_v2_descriptor understood by the Sandbox */
+#define CUSTOM_LIBRARY_VERSION	2
 
 /** Kernel original syscall is not executed */
 #define	FLAG_DONT_CALL_KERNEL			2
 
+/** Observe only.
+ * The functions of this custom syscall only look at it: their return value is ignored, and they do not change the tracee nor its memory.
+ * They are called as with FLAG_CONTEXT_HANDLER, but with a NULL state: the Sandbox copies the context and the declared memory arguments,
+ * resumes the tracee, and a worker thread runs them later, one at a time and in order. */
+#define	FLAG_OBSERVE_ONLY				4
+
 /** Skip this return value.
  * In the chain of custom syscalls, the return value of this function is not considered.
  * The last return result, either from the Kernel or another custom syscall function, is kept and passed along */
@@ -79,10 +103,66 @@ SOFTWARE.
  * Then the kernel syscall is directly called or the syscall processing is returned to the tracee.*/
 #define FLAG_QUIT_IF_RETURN_NEGATIVE			16
 
+/** Constant result, no side effects.
+ * The functions of this custom syscall ignore their arguments, do not touch the tracee nor the library state, and always return the same value.
+ * If the whole chain of a syscall is made of such functions, does not call the kernel and ends in 0 or -errno,
+ * the Sandbox moves it into the seccomp filter of the tracee (SECCOMP_RET_ERRNO) and the tracer is never woken up for it, with option -p.
+ * Without -p the children, which inherit the filter, are not monitored: the chain runs in the tracer as any other.
+ * The functions are executed once, when the libraries are loaded, to learn the value. */
+#define FLAG_CONSTANT_RESULT			32
+
+/** Context handler.
+ * The functions of this custom syscall receive a single syscall_context pointer, instead of the 6 arguments of the syscall.
+ * They do not need CUSTOM_TRACEE_DESCRIPTOR, so a chain made only of them runs without the lock shared by all the tracees.
+ * The return value is used as with the other functions. */
+#define FLAG_CONTEXT_HANDLER			64
+
 
 /**Max Characters for the name of the syscall and the library */
 #define		NAME_LENGTH	24
 
+/** Maximum amount of memory arguments declared by a custom syscall */
+#define MAX_BUFFER_ARGUMENTS	3
+
+/** The buffer is read by the functions. Changes are not written back to the tracee */
+#define BUFFER_IN		1
+/** The buffer is written by the functions, the bytes they change are written back to the tracee */
+#define BUFFER_OUT		2
+/** The buffer is read and written by the functions */
+#define BUFFER_INOUT	(BUFFER_IN | BUFFER_OUT)
+
+/** The length of the buffer is a constant */
+#define LENGTH_FIXED	1
+/** The length of the buffer is given by another argument of the syscall, i.e. count of read() */
+#define LENGTH_ARG		2
+/** The length of the buffer is the result of the kernel, only available to AFTER functions */
+#define LENGTH_RETURN	3
+
+/** Length limit of LENGTH_ARG and LENGTH_RETURN buffers that do not declare one */
+#define BUFFER_DEFAULT_MAX_LENGTH	65536
+
+/*! \brief Memory argument of a custom syscall, copied by the Sandbox from and to the tracee around the functions.
+ *
+ * The functions receive, in that argument, a pointer to a local copy of the buffer instead of the tracee address.
+ * The pointer is NULL if the address was NULL or could not be read. Nothing is copied in the option -d, the functions already run inside the tracee.
+ * Functions of other libraries that do not declare the buffer see the tracee address and the tracee memory up to date.
+ */
+typedef struct {
+	char arg;			//!< Argument holding the address of the buffer, from 0 to 5
+	char direction;		//!< BUFFER_IN, BUFFER_OUT or BUFFER_INOUT. 0 if the slot is not used
+	char length_kind;	//!< LENGTH_FIXED, LENGTH_ARG or LENGTH_RETURN
+	char length_arg;	//!< With LENGTH_ARG, the argument holding the length
+	int length;			//!< With LENGTH_FIXED the length, otherwise the maximum length copied. 0 is BUFFER_DEFAULT_MAX_LENGTH
+	}
+buffer_descriptor;
+
+/** Buffer of a constant amount of bytes, i.e. a structure */
+#define BUFFER_FIXED(arg, direction, length)				{arg, direction, LENGTH_FIXED, 0, length}
+/** Buffer whose length is another argument, copying at most max bytes */
+#define BUFFER_ARG(arg, direction, length_arg, max)		{arg, direction, LENGTH_ARG, length_arg, max}
+/** Buffer whose length is the result of the kernel, copying at most max bytes */
+#define BUFFER_RETURN(arg, direction, max)					{arg, direction, LENGTH_RETURN, 0, max}
+
 /*! \brief Structure that describes a custom Syscall */
 typedef struct {
 
@@ -106,6 +186,25 @@ typedef struct {
 	}
 custom_library_descriptor;
 
+/*! \brief A custom syscall of a custom_library_v2_descriptor, together with its syscall number */
+typedef struct {
+	int syscall_number;					//!< Number of the hooked syscall, from 0 to MAX_SYSCALL_NUMBER-1
+	custom_syscall_descriptor handler;	//!< Functions, name and flags of the custom syscall
+	buffer_descriptor buffers[MAX_BUFFER_ARGUMENTS];	//!< Memory arguments copied by the Sandbox for the functions. Unused slots are left to 0
+	}
+custom_syscall_entry;
+
+/** \brief  Structure that describes a custom Library listing only the hooked syscalls, instead of an array indexed by syscall number */
+typedef struct {
+	int version;			//!< Must be CUSTOM_LIBRARY_VERSION
+	void (*initialize)();	  //!< Pointer to the function to be executed when the library is loaded. Null if nothing to do
+	void (*terminate)();  //!< Pointer to the function to be executed when closing the sandbox. Null if nothing to do
+	custom_syscall_entry* syscalls;	//!< Pointer to the custom syscalls of the library, in any order. A syscall number appears at most once
+	int syscalls_len;		//!< Amount of elements in syscalls
+	char name[NAME_LENGTH];	//!< Name of the custom library
+	}
+custom_library_v2_descriptor;
+
 /*! \brief Structure to access some values from the TRACEE process */
 typedef struct {
 
@@ -116,31 +215,70 @@ typedef struct {
 	int trace_PID;		//!< PID of the tracee process
 
 	char kernel_executed;		//!< TRUE(1) if the kernel syscall has been executed for this syscall
+
+	int (*memory_access)(pid_t tracee, void* addr, long int n);	//!< Access allowed in a range of the tracee memory, from the cached maps. NULL if the maps are not known (option -d). \see query_memory()
 	}
 tracee_descriptor;
 
+/*! \brief The syscall being processed, as seen by a function with FLAG_CONTEXT_HANDLER. Each call receives its own copy */
+typedef struct {
+	pid_t tid;					//!< Thread that made the syscall
+	pid_t tgid;					//!< Process of the thread
+	int syscall_number;			//!< Number of the syscall
+	long int* args;				//!< The 6 arguments of the syscall. The declared memory arguments are pointers in the Sandbox, as with the other functions
+	long int kernel_return_value;	//!< Return value of the kernel, DEFAULT_RETURN_VALUE if it was not executed
+	char kernel_executed;		//!< TRUE(1) if the kernel syscall has been executed for this syscall
+	long int return_value;		//!< Return value of the chain so far
+	void** state;				//!< Slot of the library for this thread, NULL the first time. The library owns what it points to. Forgotten when the thread ends
+	}
+syscall_context;
+
+/** The range can be read */
+#define MEMORY_READ		1
+/** The range can be written */
+#define MEMORY_WRITE	2
+/** The range can be executed */
+#define MEMORY_EXEC		4
+/** The range is mapped, whatever its access */
+#define MEMORY_MAPPED	8
+
 
 /** Structure for an empty Custom Syscall*/
 #define EMPTY_SYSCALL_STRUCT	{NULL,NULL,"",0}
 /** Structure for an empty Custom Library*/
 #define EMPTY_LIBRARY_STRUCT	{NULL,0,NULL,NULL,""}
 /** Structure for an empty Tracee*/
-#define EMPTY_TRACEE_STRUCT	{0,0,0,0}
+#define EMPTY_TRACEE_STRUCT	{0,0,0,0,NULL}
 
 /*! Structure defining the library being implemented. Must be implemented in the library file. \see dynlib.c */
 extern custom_library_descriptor CUSTOM_LIBRARY_DESCRIPTOR;
 
+/*! Structure defining the library being implemented, in the sparse format. Implemented instead of CUSTOM_LIBRARY_DESCRIPTOR. \see dynlib.c */
+extern custom_library_v2_descriptor CUSTOM_LIBRARY_V2_DESCRIPTOR;
+
 /*! Structure containting the tracee information. Must remain a pointer in the library file. \see dynlib.c */
 extern const tracee_descriptor* CUSTOM_TRACEE_DESCRIPTOR;
 
+/*! Optional, set to 1 by a library whose functions are async-signal-safe: no stdio, malloc, locks or other non-reentrant libc.
+ * With option -d the functions run in the SIGSYS handler of the \b tracee, the Sandbox warns about the libraries not declaring it. \see dispatch.c */
+extern const int CUSTOM_LIBRARY_SIGNAL_SAFE;
+
  /** Symbols of the elements to look for in the custom library. \see dynlib.c */
 #define CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL 	"custom_library"
 #define CUSTOM_LIBRARY_DESCRIPTOR 	custom_library
 
+ /** Symbols of the sparse library descriptor, looked for before CUSTOM_LIBRARY_DESCRIPTOR_SYMBOL. \see dynlib.c */
+#define CUSTOM_LIBRARY_V2_DESCRIPTOR_SYMBOL 	"custom_library_v2"
+#define CUSTOM_LIBRARY_V2_DESCRIPTOR 	custom_library_v2
+
  /** Symbols of the elements to look for in the tracee descriptor. \see dynlib.c */
 #define CUSTOM_TRACEE_DESCRIPTOR_SYMBOL 	"custom_tracee"
 #define CUSTOM_TRACEE_DESCRIPTOR 	custom_tracee
 
+ /** Symbols of the optional declaration of async-signal-safety. \see dynlib.c */
+#define CUSTOM_LIBRARY_SIGNAL_SAFE_SYMBOL 	"custom_library_signal_safe"
+#define CUSTOM_LIBRARY_SIGNAL_SAFE 	custom_library_signal_safe
+
 #define RETURN_ERR -1
 
 /** Reads from the PID's memory into a given buffer location.
@@ -165,5 +303,64 @@ int read_memory_byte(pid_t tracee, void * addr, void* dst, int n);
  * */
 int write_memory_byte(pid_t tracee, void * addr, void* src, int n);
 
+/*! \brief A region of the tracee memory and its buffer in the library, for read_memory_regions() and write_memory_regions() */
+typedef struct {
+	void* addr;		//!< Address in the tracee. The region is skipped if NULL
+	void* buf;		//!< Buffer in the library. The region is skipped if NULL
+	int n;			//!< Amount of bytes. The region is skipped if 0
+	}
+memory_region;
+
+/** Reads several regions of the PID's memory into their buffers, in a single syscall when possible.
+ * Implemented in libSandboxHelper.c.
+ * \param tracee is the PID of the tracee process. Use TRACEE_DESCRIPTOR->trace_PID.
+ * \param regions is the array of regions.
+ * \param count is the amount of regions.
+ * \return the amount of bytes read, the sum of all regions, RETURN_ERR if any region could not be read.
+ * \see libSandboxHelper.c
+ * */
+int read_memory_regions(pid_t tracee, memory_region* regions, int count);
+
+/** Writes several buffers into regions of the PID's memory, in a single syscall when possible.
+ * Implemented in libSandboxHelper.c.
+ * \param tracee is the PID of the tracee process. Use TRACEE_DESCRIPTOR->trace_PID.
+ * \param regions is the array of regions.
+ * \param count is the amount of regions.
+ * \return the amount of bytes written, the sum of all regions, RETURN_ERR if any region could not be written.
+ * \see libSandboxHelper.c
+ * */
+int write_memory_regions(pid_t tracee, memory_region* regions, int count);
+
+/** Writes several buffers into regions of the PID's memory as the kernel writes the output of a syscall: only where the tracee can write.
+ * Implemented in libSandboxHelper.c. Unlike write_memory_regions(), read-only pages are left untouched, never forced through /proc/pid/mem.
+ * \param tracee is the PID of the tracee process. Use TRACEE_DESCRIPTOR->trace_PID.
+ * \param regions is the array of regions.
+ * \param count is the amount of regions.
+ * \return the amount of bytes written, without the regions skipped from the first page not writable, RETURN_ERR if nothing could be written.
+ * \see libSandboxHelper.c
+ * */
+int write_writable_regions(pid_t tracee, memory_region* regions, int count);
+
+/** Reads a NUL-terminated string from the PID's memory, i.e. a path, with a few syscalls per page instead of one per word.
+ * Implemented in libSandboxHelper.c. Reads whole pages up to the terminator, never past max bytes nor into pages not mapped.
+ * \param tracee is the PID of the tracee process. Use TRACEE_DESCRIPTOR->trace_PID.
+ * \param addr is the address of the string.
+ * \param dst is the destination buffer, of max bytes. Always NUL-terminated unless RETURN_ERR.
+ * \param max is the size of dst, i.e. PATH_MAX.
+ * \return the length of the string, at most max-1, max if there is no terminator in its first max bytes and it was truncated to max-1 bytes, RETURN_ERR if it could not be read.
+ * \see libSandboxHelper.c
+ * */
+int read_string(pid_t tracee, void* addr, char* dst, int max);
+
+/** Tells if a range of the PID's memory is mapped, and its access, without touching it.
+ * Implemented in libSandboxHelper.c, answered from the maps cached by the Sandbox.
+ * \param tracee is the PID of the tracee process. Use TRACEE_DESCRIPTOR->trace_PID.
+ * \param addr is the start of the range.
+ * \param n is the amount of bytes.
+ * \return MEMORY_MAPPED and the MEMORY_READ, MEMORY_WRITE, MEMORY_EXEC flags of all the range, 0 if any byte is not mapped, RETURN_ERR if the maps are not known.
+ * \see libSandboxHelper.c memmap.c
+ * */
+int query_memory(pid_t tracee, void* addr, int n);
+
 
 #endif
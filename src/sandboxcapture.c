@@ -0,0 +1,329 @@
+/*! \file sandboxcapture.c
+    \brief Offline reader of the segment files written by libcapture.so
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\code
+	sandboxcapture [-t tid] [-f fd] [-s <dir>] <segment> [<segment> ...]
+	\endcode
+
+	* Without -s, the index of the segments is printed, one line per syscall, with the path of the files opened.
+	* With -s, the stream of every descriptor is rebuilt in the directory, in files pid<P>.fd<N>.<G>.<kind>:
+	*	- P is the process and N the fd. G counts the descriptors numbered N in the process: it changes when N is created or closed,
+	*	  so that a reused fd number starts new files
+	*	- kind is in for the bytes read by the tracee and out for the ones written, appended in the order of the syscalls.
+	*	  pread and pwrite are the payloads of pread64() and pwrite64(), each written at its offset: an image of the parts of the file read or written
+	* The segments are taken in the order of their numbers, whatever the order of the arguments.
+	* -t and -f keep only the syscalls of a TID or of an fd. The descriptors created and closed are followed anyway.
+
+	\see capture.h libcapture.c
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>			// For PATH_MAX
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "capture.h"
+#include "syscalls.h"
+#include "hash.h"
+
+/** Highest fd whose stream can be rebuilt */
+#define MAX_STREAM_FD	4096
+/** Files of a stream: in, out, pread and pwrite */
+#define STREAM_FILES	4
+/** Initial slots of the table of processes */
+#define STREAM_PROCESSES	64
+
+/*! \brief A segment given in the command line, mapped */
+typedef struct {
+	char* path;					//!< Path of the file
+	capture_header* header;		//!< The mapping
+	size_t size;				//!< Size of the mapping
+	}
+capture_segment;
+
+/*! \brief The streams of a process */
+typedef struct {
+	int generation[MAX_STREAM_FD];				//!< Descriptors created or closed so far with each number
+	int files[MAX_STREAM_FD][STREAM_FILES];		//!< Open files of the current stream of each fd. 0 if not open yet, -1 if it could not be created
+	}
+process_streams;
+
+hash_table* stream_processes = NULL;		//!< The process_streams of each process, by TGID
+const char* stream_kinds[STREAM_FILES] = { "in", "out", "pread", "pwrite" };	//!< Suffix of each file of a stream
+
+/*! Maps a segment and checks it
+ \param segment to fill, with its path
+ \return 0 if the segment is usable, 1 otherwise
+*/
+int map_segment(capture_segment* segment)
+{
+	struct stat st;
+	capture_header* h;
+	int fd;
+
+	fd = open(segment->path, O_RDONLY);
+	if ((fd < 0) || (fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(capture_header)))
+	{
+		fprintf(stderr, "Unable to read the segment %s\n", segment->path);
+		if (fd >= 0)
+			close(fd);
+		return 1;
+	}
+	h = (capture_header*)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (h == MAP_FAILED)
+	{
+		fprintf(stderr, "Unable to read the segment %s\n", segment->path);
+		return 1;
+	}
+	if ((memcmp(h->magic, CAPTURE_MAGIC, sizeof(h->magic)) != 0) || (h->version != CAPTURE_VERSION) || (h->index_size != sizeof(capture_index)) ||
+		((size_t)st.st_size < sizeof(capture_header) + (size_t)h->index_capacity * sizeof(capture_index) + h->payload_capacity) ||
+		(h->index_used > h->index_capacity) || (h->payload_used > h->payload_capacity))
+	{
+		fprintf(stderr, "%s is not a capture segment of this version of the Sandbox\n", segment->path);
+		munmap(h, st.st_size);
+		return 1;
+	}
+	segment->header = h;
+	segment->size = st.st_size;
+	return 0;
+}
+
+/*! Finds the streams of a process, created at its first syscall
+ \param tgid The process
+ \return its process_streams, NULL if out of memory
+*/
+process_streams* find_process(int tgid)
+{
+	process_streams* process;
+
+	process = (process_streams*)hash_find(stream_processes, tgid);
+	if (process != NULL)
+		return process;
+	process = (process_streams*)calloc(1, sizeof(process_streams));
+	if ((process != NULL) && (hash_insert(stream_processes, tgid, process) != 0))
+	{
+		free(process);
+		return NULL;
+	}
+	return process;
+}
+
+/*! Closes the files of the current stream of an fd
+ \param process Its process
+ \param fd The descriptor
+*/
+void close_stream(process_streams* process, int fd)
+{
+	int k;
+
+	for(k=0;k<STREAM_FILES;k++)
+	{
+		if (process->files[fd][k] > 0)
+			close(process->files[fd][k]);
+		process->files[fd][k] = 0;
+	}
+}
+
+/*! Ends the current stream of the fds created or closed by a syscall, the next payloads go to new files
+ \param slot Index slot of a CAPTURE_OPEN or CAPTURE_CLOSE
+*/
+void end_streams(capture_index* slot)
+{
+	process_streams* process;
+	long int fd, last;
+
+	process = find_process(slot->tgid);
+	if (process == NULL)
+		return;
+	last = ((slot->direction == CAPTURE_CLOSE) && (slot->file_offset > slot->fd)) ? slot->file_offset : slot->fd;
+	if (last >= MAX_STREAM_FD)
+		last = MAX_STREAM_FD - 1;
+	for(fd=slot->fd;(fd>=0) && (fd<=last);fd++)
+	{
+		close_stream(process, fd);
+		process->generation[fd]++;
+	}
+}
+
+/*! Writes a payload to the stream files of its process, fd and direction, created at the first one
+ \param dir Directory of the streams
+ \param slot Index slot of the payload
+ \param payload Its bytes
+ \return 0 if written, 1 otherwise
+*/
+int append_stream(char* dir, capture_index* slot, char* payload)
+{
+	char path[PATH_MAX];
+	process_streams* process;
+	int kind;
+	int* fd;
+
+	if ((slot->fd < 0) || (slot->fd >= MAX_STREAM_FD) || (slot->direction < CAPTURE_IN) || (slot->direction > CAPTURE_OUT))
+		return 1;
+	process = find_process(slot->tgid);
+	if (process == NULL)
+		return 1;
+	// The positional payloads do not follow the others, they go to an image of the file
+	kind = (slot->direction - CAPTURE_IN) + ((slot->file_offset >= 0) ? 2 : 0);
+	fd = &(process->files[slot->fd][kind]);
+	if (*fd == 0)
+	{
+		snprintf(path, sizeof(path), "%s/pid%d.fd%d.%d.%s", dir, slot->tgid, slot->fd, process->generation[slot->fd], stream_kinds[kind]);
+		*fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if (*fd < 0)
+		{
+			fprintf(stderr, "Unable to create %s\n", path);
+			return 1;
+		}
+	}
+	if (*fd < 0)
+		return 1;
+	if (slot->file_offset >= 0)
+		return (pwrite(*fd, payload, slot->length, slot->file_offset) == (ssize_t)slot->length) ? 0 : 1;
+	return (write(*fd, payload, slot->length) == (ssize_t)slot->length) ? 0 : 1;
+}
+
+/*! Prints an index slot
+ \param segment Number of its segment
+ \param number Position of the slot in the segment
+ \param slot The index slot
+ \param payload Its bytes
+*/
+void print_slot(uint32_t segment, uint64_t number, capture_index* slot, char* payload)
+{
+	const char* directions[] = { "?    ", "in   ", "out  ", "open ", "close" };
+
+	printf("%4u %8lu %19lu %7d %7d %4d %-10s %s %10u", segment, (unsigned long)number, (unsigned long)slot->timestamp_ns,
+		slot->tgid, slot->tid, slot->fd, syscall_name(slot->nr), directions[(slot->direction <= CAPTURE_CLOSE) ? slot->direction : 0], slot->length);
+	if ((slot->direction == CAPTURE_OPEN) && (slot->length > 0))
+		printf(" %.*s", (int)slot->length, payload);
+	else if ((slot->direction == CAPTURE_CLOSE) && (slot->file_offset >= 0))
+		printf(" to %ld", (long)slot->file_offset);
+	else if (slot->file_offset >= 0)
+		printf(" at %ld", (long)slot->file_offset);
+	if (slot->flags & CAPTURE_TRUNCATED)
+		printf(" truncated");
+	if (slot->flags & CAPTURE_UNREADABLE)
+		printf(" unreadable");
+	printf("\n");
+}
+
+/*! Orders the segments by their number */
+int compare_segments(const void* a, const void* b)
+{
+	return (int)((capture_segment*)a)->header->segment - (int)((capture_segment*)b)->header->segment;
+}
+
+int main(int argc, char* argv[])
+{
+	capture_segment* segments;
+	capture_index* slots;
+	capture_index* slot;
+	char* payload;
+	char* stream_dir = NULL;
+	unsigned long listed = 0, bytes = 0;
+	int tid = -1, fd = -1;
+	int count = 0, errors = 0;
+	int c, i;
+	uint64_t j;
+
+	while ((c = getopt(argc, argv, "t:f:s:")) != -1)
+	{
+		if (c == 't')
+			tid = atoi(optarg);
+		else if (c == 'f')
+			fd = atoi(optarg);
+		else if (c == 's')
+			stream_dir = optarg;
+		else
+		{
+			fprintf(stderr, "Usage: %s [-t tid] [-f fd] [-s <dir>] <segment> [<segment> ...]\n", argv[0]);
+			return 1;
+		}
+	}
+	if (optind >= argc)
+	{
+		fprintf(stderr, "Usage: %s [-t tid] [-f fd] [-s <dir>] <segment> [<segment> ...]\n", argv[0]);
+		return 1;
+	}
+
+	segments = (capture_segment*)calloc(argc - optind, sizeof(capture_segment));
+	stream_processes = new_hash_table(STREAM_PROCESSES);
+	if ((segments == NULL) || (stream_processes == NULL))
+		return 2;
+	for(i=optind;i<argc;i++)
+	{
+		segments[count].path = argv[i];
+		if (map_segment(&(segments[count])) == 0)
+			count++;
+		else
+			errors++;
+	}
+	qsort(segments, count, sizeof(capture_segment), compare_segments);
+
+	for(i=0;i<count;i++)
+	{
+		slots = (capture_index*)(segments[i].header + 1);
+		payload = (char*)(slots + segments[i].header->index_capacity);
+		for(j=0;j<segments[i].header->index_used;j++)
+		{
+			slot = &(slots[j]);
+			if (slot->offset + slot->length > segments[i].header->payload_used)
+				continue;		// Being written when the Sandbox ended
+			if ((stream_dir != NULL) && ((slot->direction == CAPTURE_OPEN) || (slot->direction == CAPTURE_CLOSE)))
+				end_streams(slot);
+			if (((tid >= 0) && (slot->tid != tid)) || ((fd >= 0) && (slot->fd != fd)))
+				continue;
+			listed++;
+			if ((slot->direction == CAPTURE_IN) || (slot->direction == CAPTURE_OUT))
+				bytes += slot->length;
+			if (stream_dir != NULL)
+			{
+				if ((slot->direction == CAPTURE_IN) || (slot->direction == CAPTURE_OUT))
+					errors += append_stream(stream_dir, slot, payload + slot->offset);
+				continue;
+			}
+			print_slot(segments[i].header->segment, j, slot, payload + slot->offset);
+		}
+		munmap(segments[i].header, segments[i].size);
+	}
+
+	for(i=0;i<stream_processes->capacity;i++)
+	{
+		process_streams* process = (process_streams*)get_slot(stream_processes, i);
+		if (process == NULL)
+			continue;
+		for(c=0;c<MAX_STREAM_FD;c++)
+			close_stream(process, c);
+		free(process);
+	}
+	printf("%lu syscalls, %lu bytes in %d segments\n", listed, bytes, count);
+	free(segments);
+	return (errors > 0) ? 3 : 0;
+}
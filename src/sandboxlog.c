@@ -0,0 +1,196 @@
+/*! \file sandboxlog.c
+    \brief Offline decoder of the event log written by the Sandbox with option -o
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\code
+	sandboxlog [-f text|csv|json] <logfile>
+	\endcode
+
+	* The records are printed oldest first. Once the ring wrapped, only the last capacity records are left.
+	* A slot whose sequence does not match its position was being written when the Sandbox ended, it is skipped.
+
+	\see eventlog.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "eventlog.h"
+#include "syscalls.h"
+
+#define FORMAT_TEXT		0	//!< One aligned line per record
+#define FORMAT_CSV		1	//!< A header line, then one line per record
+#define FORMAT_JSON		2	//!< An array of objects
+
+/*! Writes the names of the libraries marked in a record, separated by '+'
+ * \param header of the log, with the names
+ * \param libraries bits of the record
+ * \param buffer to write into, large enough for all the names
+*/
+void library_names(eventlog_header* header, unsigned int libraries, char* buffer)
+{
+	unsigned int i;
+
+	buffer[0] = '\0';
+	for(i=0;i<header->libraries_len;i++)
+	{
+		if (! (libraries & (1U << i)))
+			continue;
+		if (buffer[0] != '\0')
+			strcat(buffer, "+");
+		strncat(buffer, header->libraries[i], EVENTLOG_NAME_LENGTH);
+	}
+}
+
+/*! Prints one record in the chosen format
+ * \param format FORMAT_TEXT, FORMAT_CSV or FORMAT_JSON
+ * \param r the record
+ * \param names of the libraries of the record
+ * \param first TRUE for the first record printed, for the JSON separators
+*/
+void print_record(int format, event_record* r, char* names, int first)
+{
+	const syscall_info* info;
+	int i, nargs;
+
+	switch (format)
+	{
+	case FORMAT_CSV:
+		printf("%lu,%lu,%d,%d", (unsigned long)r->sequence, (unsigned long)r->timestamp_ns, r->tid, r->nr);
+		for(i=0;i<6;i++)
+			printf(",%ld", (long)r->args[i]);
+		printf(",%d,%ld,%ld,%d,%s\n", (r->flags & EVENT_KERNEL_EXECUTED) ? 1 : 0,
+			(long)r->kernel_return, (long)r->final_return, (r->flags & EVENT_NO_RETURN) ? 0 : 1, names);
+		break;
+	case FORMAT_JSON:
+		printf("%s\n {\"seq\":%lu,\"ts_ns\":%lu,\"tid\":%d,\"nr\":%d,\"args\":[", (first ? "" : ","),
+			(unsigned long)r->sequence, (unsigned long)r->timestamp_ns, r->tid, r->nr);
+		for(i=0;i<6;i++)
+			printf("%s%ld", (i ? "," : ""), (long)r->args[i]);
+		printf("],\"custom\":%s,\"kernel\":%s", (r->flags & EVENT_CUSTOM) ? "true" : "false", (r->flags & EVENT_KERNEL_EXECUTED) ? "true" : "false");
+		if (r->flags & EVENT_NO_RETURN)
+			printf(",\"kernel_return\":null,\"return\":null");
+		else
+			printf(",\"kernel_return\":%ld,\"return\":%ld", (long)r->kernel_return, (long)r->final_return);
+		printf(",\"libraries\":\"%s\"}", names);
+		break;
+	default:
+		// Like strace, only the arguments the syscall takes
+		info = get_syscall_info(r->nr);
+		nargs = (info != NULL) ? info->nargs : 6;
+		printf("%10lu %16lu %7d %4d %s(", (unsigned long)r->sequence, (unsigned long)r->timestamp_ns, r->tid, r->nr, syscall_name(r->nr));
+		for(i=0;i<nargs;i++)
+			printf("%s%#lx", (i ? ", " : ""), (long)r->args[i]);
+		printf(")");
+		if (r->flags & EVENT_NO_RETURN)
+			printf(" = ?");
+		else if (r->flags & EVENT_KERNEL_EXECUTED)
+			printf(" = %ld (kernel %ld)", (long)r->final_return, (long)r->kernel_return);
+		else
+			printf(" = %ld (emulated)", (long)r->final_return);
+		printf("%s%s\n", (names[0] ? " by " : ""), names);
+		break;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	eventlog_header* header;
+	event_record* slots;
+	event_record* r;
+	struct stat st;
+	char names[EVENTLOG_MAX_LIBRARIES*(EVENTLOG_NAME_LENGTH+1)+1];
+	int format = FORMAT_TEXT;
+	int printed = 0;
+	int c, fd;
+	uint64_t seq, first_seq;
+
+	while ((c = getopt(argc, argv, "f:")) != -1)
+	{
+		if ((c == 'f') && (strcmp(optarg, "text") == 0))
+			format = FORMAT_TEXT;
+		else if ((c == 'f') && (strcmp(optarg, "csv") == 0))
+			format = FORMAT_CSV;
+		else if ((c == 'f') && (strcmp(optarg, "json") == 0))
+			format = FORMAT_JSON;
+		else
+		{
+			fprintf(stderr, "Usage: %s [-f text|csv|json] <logfile>\n", argv[0]);
+			return 1;
+		}
+	}
+	if (optind >= argc)
+	{
+		fprintf(stderr, "Usage: %s [-f text|csv|json] <logfile>\n", argv[0]);
+		return 1;
+	}
+
+	fd = open(argv[optind], O_RDONLY);
+	if ((fd < 0) || (fstat(fd, &st) != 0) || ((size_t)st.st_size < sizeof(eventlog_header)))
+	{
+		fprintf(stderr, "Unable to read the log %s\n", argv[optind]);
+		return 2;
+	}
+	header = (eventlog_header*)mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (header == MAP_FAILED)
+	{
+		fprintf(stderr, "Unable to read the log %s\n", argv[optind]);
+		return 2;
+	}
+	if ((memcmp(header->magic, EVENTLOG_MAGIC, sizeof(header->magic)) != 0) || (header->version != EVENTLOG_VERSION) ||
+		(header->record_size != sizeof(event_record)) || ((size_t)st.st_size < sizeof(eventlog_header) + header->capacity * sizeof(event_record)))
+	{
+		fprintf(stderr, "%s is not a log of this version of the Sandbox\n", argv[optind]);
+		return 3;
+	}
+	slots = (event_record*)(header + 1);
+
+	if (format == FORMAT_CSV)
+		printf("seq,ts_ns,tid,nr,arg0,arg1,arg2,arg3,arg4,arg5,kernel,kernel_return,return,has_return,libraries\n");
+	if (format == FORMAT_JSON)
+		printf("[");
+
+	first_seq = (header->written > header->capacity) ? header->written - header->capacity : 0;
+	for(seq=first_seq;seq<header->written;seq++)
+	{
+		r = &(slots[seq % header->capacity]);
+		if (r->sequence != seq)
+			continue;
+		library_names(header, r->libraries, names);
+		print_record(format, r, names, (printed == 0));
+		printed++;
+	}
+
+	if (format == FORMAT_JSON)
+		printf("\n]\n");
+	if (format == FORMAT_TEXT)
+		printf("%d records, %lu written since the start\n", printed, (unsigned long)header->written);
+	munmap(header, st.st_size);
+	return 0;
+}
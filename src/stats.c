@@ -0,0 +1,199 @@
+/*! \file stats.c
+    \brief Per-syscall and per-TID statistics of the tracee, printed at its exit (option -c)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see stats.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "list.h"
+#include "messages.h"
+#include "dynlib.h"
+#include "stats.h"
+#include "syscalls.h"
+
+syscall_stats stats_table[MAX_SYSCALL_NUMBER];	//!< Counters of every syscall number, also the ones newer than the syscall table
+list* stats_tids = NULL;					//!< The tid_stats of all the TIDs seen
+pthread_mutex_t stats_tids_lock = PTHREAD_MUTEX_INITIALIZER;	//!< Protects stats_tids, TIDs are added by any tracer thread
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+unsigned long long stats_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (unsigned long long)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+void histogram_add(latency_histogram* h, unsigned long long ns)
+{
+	int bucket = 0;
+
+	while ((ns >> (bucket+1)) && (bucket < STATS_BUCKETS-1))
+		bucket++;
+	__atomic_fetch_add(&(h->count), 1, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&(h->total_ns), ns, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&(h->buckets[bucket]), 1, __ATOMIC_RELAXED);
+}
+
+unsigned long long histogram_percentile(latency_histogram* h, int permille)
+{
+	unsigned long target, seen = 0;
+	int bucket;
+
+	if (h->count == 0)
+		return 0;
+	target = (h->count * permille + 999) / 1000;		// Rounded up, p999 of 10 samples is the 10th
+	for(bucket=0;bucket<STATS_BUCKETS;bucket++)
+	{
+		seen += h->buckets[bucket];
+		if (seen >= target)
+			break;
+	}
+	return 1ULL << (bucket+1);
+}
+
+tid_stats* stats_new_tid(pid_t tid)
+{
+	tid_stats* stats;
+
+	stats = (tid_stats*)calloc(1, sizeof(tid_stats));
+	if (stats == NULL)
+		return NULL;
+	stats->tid = tid;
+
+	pthread_mutex_lock(&stats_tids_lock);
+	if (stats_tids == NULL)
+		stats_tids = new_list();
+	append_item(stats_tids, stats);
+	pthread_mutex_unlock(&stats_tids_lock);
+	return stats;
+}
+
+void stats_syscall_entry(tid_stats* tid, int nr)
+{
+	if ((nr < 0) || (nr >= MAX_SYSCALL_NUMBER))
+		return;
+	__atomic_fetch_add(&(stats_table[nr].calls), 1, __ATOMIC_RELAXED);
+	if (tid != NULL)
+		tid->calls++;		// A TID is handled by one tracer thread at a time
+}
+
+void stats_syscall_result(tid_stats* tid, int nr, long int result)
+{
+	if ((nr < 0) || (nr >= MAX_SYSCALL_NUMBER))
+		return;
+	if ((result >= -MAX_ERRNO_VALUE) && (result < 0))
+	{
+		__atomic_fetch_add(&(stats_table[nr].errors), 1, __ATOMIC_RELAXED);
+		if (tid != NULL)
+			tid->errors++;
+	}
+}
+
+void stats_kernel_time(tid_stats* tid, int nr, unsigned long long ns)
+{
+	if ((nr < 0) || (nr >= MAX_SYSCALL_NUMBER))
+		return;
+	histogram_add(&(stats_table[nr].kernel), ns);
+	if (tid != NULL)
+		tid->kernel_ns += ns;
+}
+
+void stats_before_time(int nr, unsigned long long ns)
+{
+	if ((nr >= 0) && (nr < MAX_SYSCALL_NUMBER))
+		histogram_add(&(stats_table[nr].before), ns);
+}
+
+void stats_after_time(int nr, unsigned long long ns)
+{
+	if ((nr >= 0) && (nr < MAX_SYSCALL_NUMBER))
+		histogram_add(&(stats_table[nr].after), ns);
+}
+
+/*! Orders syscall numbers by decreasing kernel time, as strace -c does */
+int compare_kernel_time(const void* a, const void* b)
+{
+	unsigned long long ta = stats_table[*(const int*)a].kernel.total_ns;
+	unsigned long long tb = stats_table[*(const int*)b].kernel.total_ns;
+
+	if (ta == tb)
+		return *(const int*)a - *(const int*)b;
+	return (ta < tb) ? 1 : -1;
+}
+
+void print_percentiles(latency_histogram* h)
+{
+	if (h->count == 0)
+		printf(STATS_NO_PERCENTILES);
+	else
+		printf(STATS_PERCENTILES_F_F_F, histogram_percentile(h,500)/1000.0, histogram_percentile(h,990)/1000.0, histogram_percentile(h,999)/1000.0);
+}
+
+void print_stats(void)
+{
+	int order[MAX_SYSCALL_NUMBER];
+	int i, len = 0;
+	unsigned long calls = 0, errors = 0;
+	unsigned long long kernel_ns = 0;
+	syscall_stats* s;
+	syscall_dispatch_entry* entry;
+	tid_stats* t;
+
+	for(i=0;i<MAX_SYSCALL_NUMBER;i++)
+		if (stats_table[i].calls > 0)
+			order[len++] = i;
+	qsort(order, len, sizeof(int), compare_kernel_time);
+
+	printf(STATS_SYSCALL_HEADER);
+	for(i=0;i<len;i++)
+	{
+		s = &(stats_table[order[i]]);
+		entry = get_dispatch_entry(order[i]);
+		printf(STATS_SYSCALL_D_S_LU_LU_F, order[i], syscall_name(order[i]), s->calls, s->errors, s->kernel.total_ns/1000.0);
+		print_percentiles(&(s->kernel));
+		print_percentiles(&(s->before));
+		print_percentiles(&(s->after));
+		printf(STATS_NAME_S, (entry != NULL) ? entry->before_chain[0].syscall->name : "");
+		calls += s->calls;
+		errors += s->errors;
+		kernel_ns += s->kernel.total_ns;
+	}
+	printf(STATS_TOTAL_LU_LU_F, calls, errors, kernel_ns/1000.0);
+
+	if (stats_tids == NULL)
+		return;
+	printf(STATS_TID_HEADER);
+	seek(stats_tids, 0);
+	while (has_next(stats_tids))
+	{
+		t = (tid_stats*)get_next(stats_tids);
+		printf(STATS_TID_D_LU_LU_F, t->tid, t->calls, t->errors, t->kernel_ns/1000.0);
+	}
+}
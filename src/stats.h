@@ -0,0 +1,135 @@
+/*! \file stats.h
+    \brief Per-syscall and per-TID statistics of the tracee, printed at its exit (option -c)
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * With option -c every syscall of the monitored tracees stops the tracer, at its entry and at its exit, and syscall_flow() feeds these counters:
+	 * calls, errors and kernel time per syscall number and per TID. The kernel time is the delta between the entry stop, once handled, and the exit stop.
+	 * For the custom syscalls, the time spent in the BEFORE and AFTER chains is measured too.
+	 *
+	 * Times are kept in latency_histogram structures, with log2 buckets of nanoseconds, from which p50, p99 and p999 are read.
+	 * All the counters are fixed-size: one syscall_stats per syscall number, one tid_stats per TID allocated when the TID is first seen.
+	 * They are updated with atomic operations, as several tracer threads (option -j) may count the same syscall.
+	 *
+	\see stats.c trace.c
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_STATS	//Lock to prevent recursive inclusions
+#define INC_STATS
+
+#include <sys/types.h>
+
+/** Amount of buckets of a latency_histogram. Bucket b counts the times in [2^b, 2^(b+1)) ns, the last one counts everything above */
+#define STATS_BUCKETS	40
+
+/*! \brief Latency histogram with log2 buckets */
+typedef struct {
+	unsigned long count;					//!< Amount of samples
+	unsigned long long total_ns;			//!< Sum of the samples
+	unsigned long buckets[STATS_BUCKETS];	//!< Samples per bucket
+	}
+latency_histogram;
+
+/*! \brief Counters of one syscall number */
+typedef struct {
+	unsigned long calls;			//!< Times the syscall was entered
+	unsigned long errors;			//!< Times the tracee received -errno
+	latency_histogram kernel;		//!< Time between the entry stop and the exit stop
+	latency_histogram before;		//!< Time in the BEFORE chain, custom syscalls only
+	latency_histogram after;		//!< Time in the AFTER chain, custom syscalls only
+	}
+syscall_stats;
+
+/*! \brief Counters of one TID */
+typedef struct {
+	pid_t tid;						//!< TID of the tracee
+	unsigned long calls;			//!< Syscalls entered
+	unsigned long errors;			//!< Syscalls that returned -errno
+	unsigned long long kernel_ns;	//!< Time between the entry stops and the exit stops
+	}
+tid_stats;
+
+/*! Current time for the statistics, from CLOCK_MONOTONIC
+ * \return the time in nanoseconds
+*/
+unsigned long long stats_now(void);
+
+/*! Allocates the counters of a new TID, kept until the report
+ * \param tid The TID
+ * \return the counters, or NULL if memory could not be allocated
+*/
+tid_stats* stats_new_tid(pid_t tid);
+
+/*! Counts the entry of a syscall
+ * \param tid Counters of the TID, may be NULL
+ * \param nr Syscall number
+*/
+void stats_syscall_entry(tid_stats* tid, int nr);
+
+/*! Counts the result received by the tracee, an error if it is -errno
+ * \param tid Counters of the TID, may be NULL
+ * \param nr Syscall number
+ * \param result Value returned to the tracee
+*/
+void stats_syscall_result(tid_stats* tid, int nr, long int result);
+
+/*! Adds the kernel time of a syscall
+ * \param tid Counters of the TID, may be NULL
+ * \param nr Syscall number
+ * \param ns Time from the entry stop to the exit stop
+*/
+void stats_kernel_time(tid_stats* tid, int nr, unsigned long long ns);
+
+/*! Adds the time of the BEFORE chain of a custom syscall
+ * \param nr Syscall number
+ * \param ns Time in the chain
+*/
+void stats_before_time(int nr, unsigned long long ns);
+
+/*! Adds the time of the AFTER chain of a custom syscall
+ * \param nr Syscall number
+ * \param ns Time in the chain
+*/
+void stats_after_time(int nr, unsigned long long ns);
+
+/*! Adds a sample to a histogram
+ * \param h The histogram
+ * \param ns The sample
+*/
+void histogram_add(latency_histogram* h, unsigned long long ns);
+
+/*! Prints p50, p99 and p999 of a histogram to STDOUT, in microseconds
+ * \param h The histogram
+*/
+void print_percentiles(latency_histogram* h);
+
+/*! Reads a percentile from a histogram, as the upper edge of the bucket reaching it
+ * \param h The histogram
+ * \param permille The percentile, in 1/1000 (500 is p50, 999 is p99.9)
+ * \return the time in nanoseconds, 0 if there are no samples
+*/
+unsigned long long histogram_percentile(latency_histogram* h, int permille);
+
+/*! Prints the report of the syscalls that were called, and of the TIDs, to STDOUT */
+void print_stats(void);
+
+#endif
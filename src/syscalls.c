@@ -0,0 +1,51 @@
+/*! \file syscalls.c
+    \brief Names, argument counts and classes of the syscalls of the architecture
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	\see syscalls.h
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#include <stdlib.h>
+
+#include "syscalls.h"
+
+/** Every syscall of the architecture, indexed by number. Generated into syscall_names.h */
+const syscall_info syscall_table[SYSCALL_TABLE_LEN] = {
+	SYSCALL_TABLE_INIT
+};
+
+//-------------------------------------------------------------------------------------------------------------------------------------
+
+const syscall_info* get_syscall_info(int syscall_number)
+{
+	if ((syscall_number < 0) || (syscall_number >= SYSCALL_TABLE_LEN) || (syscall_table[syscall_number].name == NULL))
+		return NULL;
+	return &(syscall_table[syscall_number]);
+}
+
+const char* syscall_name(int syscall_number)
+{
+	const syscall_info* info = get_syscall_info(syscall_number);
+
+	return (info != NULL) ? info->name : SYSCALL_UNKNOWN_NAME;
+}
@@ -0,0 +1,79 @@
+/*! \file syscalls.h
+    \brief Names, argument counts and classes of the syscalls of the architecture
+	\authors Ignacio TAMAYO and Vassanthaphrya VIJAYAN
+	\date October 2026
+	\version 1.5
+
+	 * The table is generated at build time from syscall_table_X86_64.txt and syscall_table_i386.txt, by gensyscalls.awk, into syscall_names.h.
+	 * Nothing is parsed at runtime: a lookup is an array index.
+	 *
+	 * The custom libraries include syscall_names.h to name their syscalls instead of numbering them, on both architectures:
+	 \code
+	 #include "syscall_names.h"
+	 custom_syscall_descriptor custom_syscalls[] = {
+		[SYSCALL_NR_nanosleep] = { ... },
+	 };
+	 \endcode
+	 *
+	\see syscalls.c gensyscalls.awk
+
+*/
+
+ /*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ * */
+
+#ifndef INC_SYSCALLS	//Lock to prevent recursive inclusions
+#define INC_SYSCALLS
+
+#include "syscall_names.h"
+
+/** Classes of the syscalls, as in the tables of strace */
+#define SYSCALL_TD		0x001		//!< Takes a file descriptor
+#define SYSCALL_TF		0x002		//!< Takes a file name
+#define SYSCALL_TI		0x004		//!< Inter-process communication
+#define SYSCALL_TN		0x008		//!< Network
+#define SYSCALL_TP		0x010		//!< Process management
+#define SYSCALL_TS		0x020		//!< Signals
+#define SYSCALL_TM		0x040		//!< Memory mapping
+#define SYSCALL_NF		0x080		//!< Never fails
+#define SYSCALL_SI		0x100		//!< Changes the memory maps
+#define SYSCALL_SE		0x200		//!< Ends or replaces the process image, i.e. exit() and execve()
+
+/** Name given to the numbers missing in the table */
+#define SYSCALL_UNKNOWN_NAME	"?"
+
+/*! \brief A syscall of the architecture */
+typedef struct {
+	int nargs;				//!< Amount of arguments
+	int flags;				//!< Combination of the SYSCALL_T* classes
+	const char* name;		//!< Name, NULL if the number is not in the table
+	}
+syscall_info;
+
+/*! Gives the description of a syscall.
+ * \param syscall_number is the number of the syscall
+ * \return the entry of the table, NULL if the number is out of the table or has no name
+*/
+const syscall_info* get_syscall_info(int syscall_number);
+
+/*! Gives the name of a syscall, for the messages.
+ * \param syscall_number is the number of the syscall
+ * \return the name, SYSCALL_UNKNOWN_NAME if the number is not in the table
+*/
+const char* syscall_name(int syscall_number);
+
+#endif
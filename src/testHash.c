@@ -0,0 +1,92 @@
+/*! \file testHash.c
+    \brief Unit testing for the hash.c file
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ *
+ * */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/types.h>
+#include "hash.h"
+#include "trace.h"
+
+#define TEST_ITEMS	5000
+
+int main()
+{
+	hash_table* H = new_hash_table(4);
+
+	tracee_flow_descriptor * tracee_descs;
+	tracee_flow_descriptor * t;
+	int i, errors = 0;
+
+	tracee_descs = (tracee_flow_descriptor*)malloc( TEST_ITEMS * sizeof(tracee_flow_descriptor));
+	for(i=0;i<TEST_ITEMS;i++)
+		tracee_descs[i].pid = 1000 + i;
+
+	printf("Testing of Hash table\n");
+
+	printf("Table has %d elements in %d slots \n", H->counter, H->capacity);
+
+	for(i=0;i<TEST_ITEMS;i++)
+		hash_insert(H, tracee_descs[i].pid, &tracee_descs[i]);
+
+	printf("Inserted %d, table has %d elements in %d slots \n", TEST_ITEMS, H->counter, H->capacity);
+
+	for(i=0;i<TEST_ITEMS;i++)
+	{
+		t = hash_find(H, 1000 + i);
+		if ((t == NULL) || (t->pid != 1000 + i))
+			errors++;
+	}
+	if (hash_find(H, 999) != NULL) errors++;
+	printf("Lookups done, %d errors \n", errors);
+
+	// Deleting every odd PID, the even ones must still be found after the backward shifts
+	for(i=1;i<TEST_ITEMS;i+=2)
+		if (hash_delete(H, 1000 + i) != 0)
+			errors++;
+	if (hash_delete(H, 1001) != -1) errors++;
+
+	printf("Deleted odd PIDs, table has %d elements \n", H->counter);
+
+	for(i=0;i<TEST_ITEMS;i++)
+	{
+		t = hash_find(H, 1000 + i);
+		if ( (i%2 == 0) && ((t == NULL) || (t->pid != 1000 + i)) )
+			errors++;
+		if ( (i%2 == 1) && (t != NULL) )
+			errors++;
+	}
+
+	t = NULL;
+	for(i=0;i<H->capacity;i++)
+		if (get_slot(H,i) != NULL)
+			t = get_slot(H,i);
+	printf("Last PID in table %d \n", t ? t->pid : -1);
+
+	printf("Lookups after deletion done, %d errors \n", errors);
+	return errors;
+}
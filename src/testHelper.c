@@ -0,0 +1,181 @@
+/*! \file testHelper.c
+    \brief Unit testing for the libSandboxHelper.c file, on the memory of its own process
+  	\authors Ignacio TAMAYO
+	\date October 2026
+	\version 1.0
+
+*/
+
+/*
+ Licence
+--------------
+Copyright (c) 2016 Ignacio TAMAYO and Vassanthaphriya VIJAYAN
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ *
+ * */
+
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include "sandbox_customsyscall_descriptor.h"
+
+/** Sizes of the destination of read_string(), within a page and across pages */
+#define TEST_MAX_SHORT	16
+#define TEST_MAX_LONG	5000
+
+/** Regions of the scatter-gather copies, more than one chunk of iovecs */
+#define TEST_REGIONS		70
+/** Bytes of each region */
+#define TEST_REGION_LENGTH	24
+
+/*! Reads strings of max-2, max-1 and max characters
+ \param max is the size of the destination
+ \return the amount of errors
+*/
+int test_read_string(int max)
+{
+	char* src = (char*)malloc(max + 1);
+	char* dst = (char*)malloc(max);
+	int lengths[3] = { max-2, max-1, max };
+	int expected[3] = { max-2, max-1, max };
+	int i, got, errors = 0;
+
+	for(i=0;i<3;i++)
+	{
+		memset(src, 'x', lengths[i]);
+		src[lengths[i]] = 0;
+		memset(dst, '?', max);
+		got = read_string(getpid(), src, dst, max);
+		if ((got != expected[i]) || (dst[max-1] != 0) || ((int)strlen(dst) != ((lengths[i] < max) ? lengths[i] : max-1)))
+			errors++;
+		printf("read_string of %d characters into %d bytes returns %d \n", lengths[i], max, got);
+	}
+	free(src);
+	free(dst);
+	return errors;
+}
+
+/*! Copies TEST_REGIONS regions from and to the process in one call, then checks every byte
+ \return the amount of errors
+*/
+int test_scatter_gather(void)
+{
+	char* memory = (char*)malloc(TEST_REGIONS * TEST_REGION_LENGTH * 2);
+	char* copy = (char*)malloc(TEST_REGIONS * TEST_REGION_LENGTH);
+	memory_region regions[TEST_REGIONS];
+	int i, got, errors = 0;
+
+	// Every other slot of memory, so that the regions are not contiguous
+	for(i=0;i<TEST_REGIONS * TEST_REGION_LENGTH * 2;i++)
+		memory[i] = (char)i;
+	for(i=0;i<TEST_REGIONS;i++)
+	{
+		regions[i].addr = memory + (2 * i * TEST_REGION_LENGTH);
+		regions[i].buf = copy + (i * TEST_REGION_LENGTH);
+		regions[i].n = TEST_REGION_LENGTH;
+	}
+	memset(copy, 0, TEST_REGIONS * TEST_REGION_LENGTH);
+	got = read_memory_regions(getpid(), regions, TEST_REGIONS);
+	for(i=0;i<TEST_REGIONS;i++)
+		if (memcmp(regions[i].addr, regions[i].buf, TEST_REGION_LENGTH) != 0)
+			errors++;
+	printf("read_memory_regions of %d regions returns %d \n", TEST_REGIONS, got);
+	if (got != TEST_REGIONS * TEST_REGION_LENGTH)
+		errors++;
+
+	memset(copy, 'w', TEST_REGIONS * TEST_REGION_LENGTH);
+	got = write_memory_regions(getpid(), regions, TEST_REGIONS);
+	for(i=0;i<TEST_REGIONS;i++)
+	{
+		if (memcmp(regions[i].addr, regions[i].buf, TEST_REGION_LENGTH) != 0)
+			errors++;
+		if (memory[(2 * i + 1) * TEST_REGION_LENGTH] != (char)((2 * i + 1) * TEST_REGION_LENGTH))		// The gaps are untouched
+			errors++;
+	}
+	printf("write_memory_regions of %d regions returns %d \n", TEST_REGIONS, got);
+	if (got != TEST_REGIONS * TEST_REGION_LENGTH)
+		errors++;
+
+	free(memory);
+	free(copy);
+	return errors;
+}
+
+/*! Writes into a read-only page between two writable regions.
+ * process_vm_writev() stops at it: write_memory_regions() goes on with /proc/self/mem, write_writable_regions() skips it
+ \return the amount of errors
+*/
+int test_read_only(void)
+{
+	long page = sysconf(_SC_PAGESIZE);
+	char before[TEST_REGION_LENGTH], after[TEST_REGION_LENGTH], buf[3][TEST_REGION_LENGTH];
+	memory_region regions[3];
+	char* protected;
+	int i, got, errors = 0;
+
+	protected = (char*)mmap(NULL, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (protected == MAP_FAILED)
+		return 1;
+	memset(protected, 'r', page);
+	mprotect(protected, page, PROT_READ);
+
+	regions[0].addr = before;
+	regions[1].addr = protected;
+	regions[2].addr = after;
+	for(i=0;i<3;i++)
+	{
+		regions[i].buf = buf[i];
+		regions[i].n = TEST_REGION_LENGTH;
+	}
+
+	memset(before, 0, TEST_REGION_LENGTH);
+	memset(after, 0, TEST_REGION_LENGTH);
+	memset(buf, 's', sizeof(buf));
+	got = write_writable_regions(getpid(), regions, 3);
+	printf("write_writable_regions over a read-only page returns %d \n", got);
+	if ((got != 2 * TEST_REGION_LENGTH) || (protected[0] != 'r') || (before[0] != 's') || (after[TEST_REGION_LENGTH-1] != 's'))
+		errors++;
+
+	memset(before, 0, TEST_REGION_LENGTH);
+	memset(after, 0, TEST_REGION_LENGTH);
+	memset(buf, 'f', sizeof(buf));
+	got = write_memory_regions(getpid(), regions, 3);
+	printf("write_memory_regions over a read-only page returns %d \n", got);
+	if ((got != 3 * TEST_REGION_LENGTH) || (protected[0] != 'f') || (protected[TEST_REGION_LENGTH] != 'r') || (before[0] != 'f') || (after[TEST_REGION_LENGTH-1] != 'f'))
+		errors++;
+
+	munmap(protected, page);
+	return errors;
+}
+
+int main()
+{
+	int errors = 0;
+
+	printf("Testing of the memory helpers\n");
+
+	errors += test_read_string(TEST_MAX_SHORT);
+	errors += test_read_string(TEST_MAX_LONG);
+	printf("read_string boundaries done, %d errors \n", errors);
+
+	errors += test_scatter_gather();
+	errors += test_read_only();
+	printf("memory regions done, %d errors \n", errors);
+
+	return errors;
+}
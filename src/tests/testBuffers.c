@@ -0,0 +1,42 @@
+/*! \file testBuffers.c
+    \brief Test program for the memory arguments of the custom syscalls, with libtime.so
+  	\authors Ignacio Tamayo
+	\date October 2026
+	\version 1.0
+
+	nanosleep() is called on a timespec of the stack and on a constant timespec, in a read-only page.
+	libtime changes the timespec of nanosleep(), declared BUFFER_INOUT: the Sandbox writes back the changed bytes of the stack,
+	and leaves the constant as it is, as the kernel does not write read-only pages either.
+
+	The syscall is called directly: glibc implements nanosleep() with clock_nanosleep()
+
+    \code
+	./sandbox -l time testBuffers
+    \endcode
+
+ 	\see libtime.c arena.c
+
+*/
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>  //for syscall()
+
+/** Wait of a read-only page */
+static const struct timespec constant_wait = {0, 1000};
+
+/** Prints the timespecs after sleeping on them
+ * */
+int main()
+{
+	struct timespec stack_wait = {0, 1000};
+	long int result;
+
+	result = syscall(SYS_nanosleep, &stack_wait, NULL);
+	printf("Stack timespec after nanosleep: %ld s %ld ns, returned %ld\n", (long)stack_wait.tv_sec, (long)stack_wait.tv_nsec, result);
+
+	result = syscall(SYS_nanosleep, &constant_wait, NULL);
+	printf("Read-only timespec after nanosleep: %ld s %ld ns, returned %ld\n", (long)constant_wait.tv_sec, (long)constant_wait.tv_nsec, result);
+	return 0;
+}
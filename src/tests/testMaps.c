@@ -0,0 +1,77 @@
+/*! \file testMaps.c
+    \brief Test program that writes from pages mapped, moved and unmapped while it runs
+ 	\authors Ignacio Tamayo
+	\date October 2026
+	\version 1.0
+
+	The Sandbox reads /proc/pid/maps once, at the first copy, and again when an address is not found.
+	Each write() is from a page that was not mapped when the previous one was copied: a page moved with mremap(),
+	then a new page after munmap(). With libcapture, the stream of the file holds the three lines, none is marked unreadable.
+
+    \code
+	SANDBOX_CAPTURE=/tmp/capture ./sandbox -l capture testMaps /tmp/mapsfile.txt
+    \endcode
+
+	\see libcapture.c memmap.c
+
+*/
+#define _GNU_SOURCE			// For mremap()
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+/** Lines written, one from each page */
+#define LINE_MAPPED		"Line from the first page\n"
+#define LINE_MOVED		"Line from the page moved by mremap\n"
+#define LINE_REMAPPED	"Line from a page mapped after munmap\n"
+
+int main(int argc, char * argv[])
+{
+	long page = sysconf(_SC_PAGESIZE);
+	char *first, *moved, *target, *remapped;
+	int fd;
+
+	if(argc != 2)
+	{
+		printf("Wrong command\n");
+		printf("testMaps <file to write>\n");
+		return 9;
+	}
+
+	// An address free when the maps are read, for mremap()
+	first = (char*)mmap(NULL, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	target = (char*)mmap(NULL, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if ((first == MAP_FAILED) || (target == MAP_FAILED))
+		return 1;
+	munmap(target, page);
+
+	fd = open(argv[1], O_CREAT | O_TRUNC | O_WRONLY, S_IRUSR | S_IWUSR);
+	if (fd < 0)
+	{
+		perror("");
+		return 2;
+	}
+
+	strcpy(first, LINE_MAPPED);
+	write(fd, first, strlen(first));
+
+	moved = (char*)mremap(first, page, page, MREMAP_MAYMOVE | MREMAP_FIXED, target);
+	if (moved == MAP_FAILED)
+		return 3;
+	strcpy(moved, LINE_MOVED);
+	write(fd, moved, strlen(moved));
+
+	munmap(moved, page);
+	remapped = (char*)mmap(NULL, page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (remapped == MAP_FAILED)
+		return 4;
+	strcpy(remapped, LINE_REMAPPED);
+	write(fd, remapped, strlen(remapped));
+
+	close(fd);
+	munmap(remapped, page);
+	printf("Wrote from 3 pages to %s\n", argv[1]);
+	return 0;
+}
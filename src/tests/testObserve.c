@@ -0,0 +1,51 @@
+/*! \file testObserve.c
+    \brief Test program for the observe-only functions of libio.so, with many writes of a known line
+ 	\authors Ignacio Tamayo
+	\date October 2026
+	\version 1.0
+
+	Makes more writes than the smallest observe queue holds, so some may be dropped, and more records than the append buffer of libio holds.
+	Each write() queued gives one record in /tmp/Sandbox.write, once the tracee ended.
+
+    \code
+	./sandbox -c -q 1 -l io testObserve /dev/null
+    \endcode
+
+	\see libio.c observe.c
+
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/** Amount of writes */
+#define WRITES		3000
+/** The line of each write, 32 bytes */
+#define LINE		"Observed line of a known length\n"
+
+int main(int argc, char * argv[])
+{
+	int fd, i, done = 0;
+
+	if(argc != 2)
+	{
+		printf("Wrong command\n");
+		printf("testObserve <file to write>\n");
+		return 9;
+	}
+
+	fd = open(argv[1], O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+	if (fd < 0)
+	{
+		perror("");
+		return 2;
+	}
+	for(i=0;i<WRITES;i++)
+		if (write(fd, LINE, strlen(LINE)) == (ssize_t)strlen(LINE))
+			done++;
+	close(fd);
+	printf("Wrote %d lines of %d bytes\n", done, (int)strlen(LINE));
+	return 0;
+}
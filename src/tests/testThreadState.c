@@ -0,0 +1,75 @@
+/*! \file testThreadState.c
+    \brief Test program for the per-thread state of the custom syscalls, with libtime.so
+  	\authors Ignacio Tamayo
+	\date October 2026
+	\version 1.0
+
+	libtime moves the time() of each thread one year ahead, then one year behind, and so on.
+	Two threads call time() in turns: 1, 2, 1, 2. Each thread has its own state, so both see ahead then behind.
+	With one state for all the threads, the second one would see behind then ahead.
+
+	The syscall is called directly: glibc implements time() in the vDSO, without syscall
+
+    \code
+	./sandbox -p -l time testThreadState
+    \endcode
+
+ 	\see libtime.c sandbox_customsyscall_descriptor.h
+
+*/
+
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/syscall.h>  //for syscall()
+
+/** Half of the year of libtime, the real time is never that far */
+#define HALF_YEAR	(60*60*24*30*6)
+
+/** Amount of threads calling time() in turns */
+#define THREADS		2
+
+pthread_barrier_t turns;	//!< Each time() is in its own turn
+
+void * thread_function(void * arg);
+
+/** Prints what each thread saw of time()
+ * */
+int main(void)
+{
+	pthread_t threads[THREADS];
+	long int i;
+
+	pthread_barrier_init(&turns, NULL, THREADS);
+	for(i=0;i<THREADS;i++)
+		pthread_create(&threads[i], NULL, &thread_function, (void*)i);
+	for(i=0;i<THREADS;i++)
+		pthread_join(threads[i], NULL);
+	pthread_barrier_destroy(&turns);
+	return 0;
+}
+
+/** Calls time() twice, in the turns of the thread, and compares it with the real time
+ * */
+void * thread_function(void * arg)
+{
+	long int me = (long int)arg;
+	struct timespec now;
+	long int seen[2];
+	int turn;
+
+	for(turn=0;turn<2*THREADS;turn++)
+	{
+		if (turn % THREADS == me)
+			seen[turn / THREADS] = syscall(SYS_time, NULL);
+		pthread_barrier_wait(&turns);
+	}
+	clock_gettime(CLOCK_REALTIME, &now);
+
+	if ((seen[0] > now.tv_sec + HALF_YEAR) && (seen[1] < now.tv_sec - HALF_YEAR))
+		printf("Thread %ld: ahead then behind\n", me + 1);
+	else
+		printf("Thread %ld: %ld then %ld, the time is %ld\n", me + 1, seen[0], seen[1], (long)now.tv_sec);
+	return NULL;
+}
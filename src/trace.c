@@ -6,11 +6,18 @@
 
     Traces a PID constantly, looking for syscalls. It can also trace the Forked/Cloned process.
     *
-    The Trace is interrupted always twice, BEFORE the SYSCALL Kernel and AFTER the Syscall Kernel.
+    The \b tracee runs a seccomp filter that stops it only for the syscalls implemented by the custom libraries (filter.c).
+    *
+    The Trace is interrupted by the PTRACE_EVENT_SECCOMP stop BEFORE the SYSCALL Kernel, and by a syscall-exit-stop AFTER the Syscall Kernel.
+    The syscall-exit-stop is only requested if the syscall has AFTER functions, otherwise the \b tracee goes on after the BEFORE functions.
+    If a library does not call the kernel, the syscall number is set to -1 at the seccomp stop: the kernel skips it and returns the value written in REG_AX, so the whole custom syscall takes a single stop.
+    *
+    The syscall number, arguments and kernel result are read with PTRACE_GET_SYSCALL_INFO, and only the registers that change are written back with PTRACE_POKEUSER.
     *
     There is a mechanism to properly catch both individually for each PID, so concurrent order of processes and calls is not a problem.
     *
-    * To offer information to the libraries, this module fills up every time the fields in the structure tracee_descriptor tracee.
+    * To offer information to the libraries, this module fills a syscall_context at every stop. dynlib.c copies it into the structure tracee_descriptor tracee
+    * for the functions reading it, under library_lock. Chains made only of context handlers run without the lock.
     *
     *
     *
@@ -19,7 +26,11 @@
 
 	\internal
 
-	* To support child \b tracee (a \b tracee that uses fork() to create child processes), a list of structures tracee_flow_descriptor is kept.
+	* To support child \b tracee (a \b tracee that uses fork() to create child processes), a hash table of structures tracee_flow_descriptor is kept, indexed by PID/TID.
+    * With option -j, several tracer threads share the work. ptrace requires the tracer thread to service its own tracees, so each tracer thread has its own table and waits only for its tracees (__WNOTHREAD).
+    * New children and threads are handed off round robin: detached with SIGSTOP at their initial stop, and attached again with PTRACE_SEIZE by the other tracer thread.
+    * The custom libraries are run under a lock, so they always see a consistent tracee_descriptor.
+    * Finding the state of the stopped PID is O(1), even with thousands of threads.
     * For every child there is an entry that contains the Sandbox Custom Syscall Processing state.
     * This structure is loaded and saved every time it processes an interruption for a PID, let it be parent of child, incoming or outgoing.
     * This is necessary to provide the libraries with information about the precise PID that is actually requesting the syscall among the several possible, and in which state is the syscall execution.
@@ -61,11 +72,21 @@ SOFTWARE.
 #include <string.h>			// Neede for strcpy
 #include <errno.h>			// Needed for errors in PTRACE calls
 #include <pthread.h>		// To support threading
+#include <signal.h>			// To wake up the tracer threads
+#include <setjmp.h>			// To leave waitpid() when woken up
+#include <sys/syscall.h>		// For SYS_socket
+#include <sys/socket.h>		// For the placeholder sockets of the replay
 
 #include "trace.h"
 #include "messages.h"
 #include "dynlib.h"
-#include "list.h"
+#include "hash.h"
+#include "stats.h"
+#include "profile.h"
+#include "eventlog.h"
+#include "memmap.h"
+#include "syscalls.h"
+#include "filter.h"
 
 #ifdef __x86_64__							// Architecture of the running PC is 64 bits
 		#define REG_AX_ORIG	regs.orig_rax
@@ -79,8 +100,16 @@ SOFTWARE.
 		#define REG_DX	regs.rdx
 		//!< Processor register
 		#define SYSCALLS_ARGS_REGS  regs.rdi, regs.rsi, regs.rdx, regs.r10, regs.r8, regs.r9
-		#define DUMMY_SYSCALL	39
-		//!< Syscall that is actually called in kernet when a library function was performed in place of the real Syscall
+		#define REG_AX_ORIG_OFFSET	(sizeof(long int)*ORIG_RAX)
+		//!< Offset in the USER area for PTRACE_POKEUSER of the syscall number register
+		#define REG_AX_OFFSET	(sizeof(long int)*RAX)
+		//!< Offset in the USER area for PTRACE_POKEUSER of the result register
+		#define REG_ARG0_OFFSET	(sizeof(long int)*RDI)
+		//!< Offset in the USER area for PTRACE_POKEUSER of the first argument
+		#define REG_ARG1_OFFSET	(sizeof(long int)*RSI)
+		//!< Offset in the USER area for PTRACE_POKEUSER of the second argument
+		#define REG_ARG2_OFFSET	(sizeof(long int)*RDX)
+		//!< Offset in the USER area for PTRACE_POKEUSER of the third argument
 
 		typedef unsigned long long int cpu_reg;
 
@@ -92,21 +121,30 @@ SOFTWARE.
 		#define REG_CX	regs.ecx			// Processor register
 		#define REG_DX	regs.edx			// Processor register
 		#define SYSCALLS_ARGS_REGS  regs.ebx, regs.ecx, regs.edx, 	regs.esi, 	regs.edi, regs.ebp
-		#define DUMMY_SYSCALL	20
-		// Syscall that is actually called in kernet when a library function was performed in place of the real Syscall
+		#define REG_AX_ORIG_OFFSET	(sizeof(long int)*ORIG_EAX)	// Offset in the USER area of the syscall number register
+		#define REG_AX_OFFSET	(sizeof(long int)*EAX)			// Offset in the USER area of the result register
+		#define REG_ARG0_OFFSET	(sizeof(long int)*EBX)			// Offset in the USER area of the first argument
+		#define REG_ARG1_OFFSET	(sizeof(long int)*ECX)			// Offset in the USER area of the second argument
+		#define REG_ARG2_OFFSET	(sizeof(long int)*EDX)			// Offset in the USER area of the third argument
 
 		typedef long int cpu_reg;
 
 #endif
 
-#ifdef __x86_64__
-	#define MAX_SYSCALLS 		316
-	/** Maximum ammount of syscalls supported in the architecture*/
-#endif
-#ifdef __i386__
-	#define MAX_SYSCALLS 		358
-	/** Maximum ammount of syscalls supported in the architecture*/
-#endif
+/** Initial amount of slots in the table of Tracees, it grows with the threads and children */
+#define TRACEES_TABLE_INITIAL_SIZE	64
+
+/** Syscall number written at the seccomp stop to make the kernel skip the syscall, keeping the value of REG_AX as result */
+#define SKIP_SYSCALL	-1
+
+/** Value of REG_AX at the seccomp stop, before the syscall is executed */
+#define ENTRY_REG_AX	(-ENOSYS)
+
+/** Options of all the tracees. Forks and clones are always followed, as they inherit the seccomp filter */
+#define TRACEE_PTRACE_OPTIONS	(PTRACE_O_TRACESYSGOOD  | PTRACE_O_EXITKILL | PTRACE_O_TRACESECCOMP | PTRACE_O_TRACEFORK | PTRACE_O_TRACEVFORK | PTRACE_O_TRACECLONE | PTRACE_O_TRACEEXEC)
+
+/** Signal sent to a tracer thread blocked in waitpid() when a tracee is handed off to it */
+#define TRACER_WAKEUP_SIGNAL	SIGUSR2
 
 //-------------------------------------------------------------------------------------------------------------------------------------
 
@@ -127,30 +165,40 @@ void dump_regs(struct user_regs_struct *regs)
 #endif
 }
 
-list * child_tracees_list;	//!< List of Tracees to be monitored
+__thread hash_table * child_tracees_table;	//!< Tracees of this tracer thread, indexed by PID/TID
+
+__thread struct user_regs_struct regs;				//!< Structure to operate the CPU registers, only used if PTRACE_GET_SYSCALL_INFO is not supported
+
+__thread syscall_stop_info stop_info;				//!< Syscall number, arguments and kernel result of the stop being processed
+
+__thread tracer_thread* current_tracer;			//!< Tracer thread running the code
+
+__thread sigjmp_buf tracer_jump;					//!< Where the tracer thread jumps to when woken up in waitpid()
+
+__thread volatile sig_atomic_t tracer_can_jump = FALSE;	//!< TRUE while the tracer thread is blocked in waitpid() and can be woken up
+
+tracer_thread* tracer_threads;				//!< All the tracer threads, the first one traces the main tracee
+
+int tracer_threads_len = 1;					//!< Amount of tracer threads
 
-struct user_regs_struct regs;				//!< Structure to operate the CPU registers
+unsigned int next_tracer_thread = 0;		//!< Round robin counter to give the new tracees to the tracer threads
+
+pid_t main_tracee_pid;						//!< PID of the main tracee, its exit ends the tracing
+
+pthread_mutex_t library_lock = PTHREAD_MUTEX_INITIALIZER;	//!< Serializes the chains with shared_state: the tracee_descriptor and the arena, also with the supervisor thread
+
+char syscall_info_supported = TRUE;			//!< FALSE once the kernel rejected PTRACE_GET_SYSCALL_INFO, then PTRACE_GETREGS is used
 
 
 //-------------------------------------------------------------------------------------------------------------------------------------
 
 tracee_flow_descriptor* find_child_tracee(pid_t pid)
 {
-	tracee_flow_descriptor* tracee_desc;
-
-	seek(child_tracees_list,0);
-	while(has_next(child_tracees_list))
-	{
-		tracee_desc = (tracee_flow_descriptor*)get_next(child_tracees_list);
-		dprintf("Looking for PID %d , checking %d\n");
-		if (tracee_desc->pid == pid)
-			return tracee_desc;
-	}
-	return NULL;
+	return (tracee_flow_descriptor*)hash_find(child_tracees_table,pid);
 }
 
 
-void add_child_tracee(pid_t pid)
+tracee_flow_descriptor* add_child_tracee(pid_t pid)
 {
 	tracee_flow_descriptor * tracee_desc;
 
@@ -159,84 +207,292 @@ void add_child_tracee(pid_t pid)
 	tracee_desc->return_value = DEFAULT_RETURN_VALUE ;
 	tracee_desc->kernel_return_value = DEFAULT_RETURN_VALUE;
 	tracee_desc->expecting_syscall_return=FALSE;
-	tracee_desc->expecting_dummy = FALSE;
 	tracee_desc->is_custom_syscall=FALSE;
 	tracee_desc->kernel_executed=FALSE;
+	tracee_desc->monitored = childProcessFlag;
+	tracee_desc->start_state = TRACEE_STARTED;
+	tracee_desc->stats = (statsFlag ? stats_new_tid(pid) : NULL);
+	tracee_desc->replay = (((recordFile != NULL) || (replayFile != NULL)) ? replay_new_tracee() : NULL);
 
-	append_item(child_tracees_list,(void*)tracee_desc);
+	hash_insert(child_tracees_table,pid,(void*)tracee_desc);
 
-	dprintf("Added PID %d to list \n",pid);
+	dprintf("Added PID %d to table \n",pid);
+	return tracee_desc;
 }
 
 
 void print_child_tracee()
 {
-	int i = 0;
-	seek(child_tracees_list,0);
-	//printf("List Head %ld Cursor %ld \n ",child_tracees_list->head, child_tracees_list->cursor  );
-	while(has_next(child_tracees_list))
+	int i, j = 0;
+	tracee_flow_descriptor * tracee_desc;
+
+	for(i=0;i<child_tracees_table->capacity;i++)
 	{
-		i++;
-		dprintf(" Item %d : PID %d ,",i,get_next(child_tracees_list)->pid);
+		tracee_desc = get_slot(child_tracees_table,i);
+		if (tracee_desc != NULL)
+		{
+			j++;
+			dprintf(" Item %d : PID %d ,",j,tracee_desc->pid);
+		}
 	}
 	dprintf("\n");
 
 }
 
+/*! Kills all the tracees, to end the replay of option -P
+*/
+void kill_replayed_tracees(void)
+{
+	tracee_flow_descriptor* tracee_desc;
+	int i;
+
+	for(i=0;i<child_tracees_table->capacity;i++)
+	{
+		tracee_desc = get_slot(child_tracees_table,i);
+		if (tracee_desc != NULL)
+			kill(tracee_desc->pid, SIGKILL);
+	}
+}
+
+/*! Ends the replay of option -P once all the tracees left are parked, their records exhausted: they are killed
+*/
+void release_parked_tracees(void)
+{
+	tracee_flow_descriptor* tracee_desc;
+	int i;
+
+	for(i=0;i<child_tracees_table->capacity;i++)
+	{
+		tracee_desc = get_slot(child_tracees_table,i);
+		if ((tracee_desc != NULL) && (tracee_desc->replay != NULL) && (! tracee_desc->replay->parked))
+			return;
+	}
+	kill_replayed_tracees();
+}
+
 void delete_child_tracee(pid_t pid)
 {
 	tracee_flow_descriptor * tracee_desc;
 
-	seek(child_tracees_list,0);
-	while(has_next(child_tracees_list))
+	tracee_desc = find_child_tracee(pid);
+	if (tracee_desc != NULL)
 	{
-		tracee_desc = get_next(child_tracees_list);
-		if (tracee_desc->pid == pid)
-		{
+		hash_delete(child_tracees_table,pid);
+		memmap_detach(pid);
+		release_library_states(pid);
+		if (tracee_desc->replay != NULL)
+			replay_free_tracee(tracee_desc->replay);
+		free(tracee_desc);
+		dprintf("Deleted PID %d from table \n",pid);
+		if (replayFile != NULL)
+			release_parked_tracees();
+	}
+}
 
-			delete_item(child_tracees_list,(void *)tracee_desc);
-			free(tracee_desc);
-			dprintf("Deleted PID %d from list \n",pid);
+/*! Reads the syscall of a stopped \b tracee into stop_info.
+ * At a seccomp stop the syscall number and arguments are read, at a syscall-exit-stop the kernel result.
+ * PTRACE_GET_SYSCALL_INFO copies just these values, the full register set is only read on kernels without it.
+ * \param pid of the stopped \b tracee
+ * \return RETURN_OK if the values were read, RETURN_ERR otherwise
+*/
+int read_syscall_stop(pid_t pid)
+{
+	struct __ptrace_syscall_info info;
+	int i;
+
+	if (syscall_info_supported)
+	{
+		if (ptrace(PTRACE_GET_SYSCALL_INFO, pid, sizeof(info), &info) > 0)
+		{
+			if (info.op == PTRACE_SYSCALL_INFO_SECCOMP)
+			{
+				stop_info.nr = info.seccomp.nr;
+				for(i=0;i<6;i++)
+					stop_info.args[i] = info.seccomp.args[i];
+				return RETURN_OK;
+			}
+			if (info.op == PTRACE_SYSCALL_INFO_EXIT)
+			{
+				stop_info.rval = info.exit.rval;
+				return RETURN_OK;
+			}
+			return RETURN_ERR;		//Not stopped in a syscall
 		}
+		if (errno != EIO)
+			return RETURN_ERR;
+		dprintf("PTRACE_GET_SYSCALL_INFO not supported, reading all the registers \n");
+		syscall_info_supported = FALSE;		//Kernels older than 5.3
 	}
 
+	if (ptrace(PTRACE_GETREGS, pid, 0, &regs))
+		return RETURN_ERR;
+	{
+		long int args[6] = { SYSCALLS_ARGS_REGS };
+		for(i=0;i<6;i++)
+			stop_info.args[i] = args[i];
+	}
+	stop_info.nr = REG_AX_ORIG;
+	stop_info.rval = REG_AX;
+	return RETURN_OK;
+}
+
+/*! Restarts a stopped \b tracee.
+ * Only if a custom syscall is waiting for the kernel return the syscall-exit-stop is requested, otherwise the \b tracee runs until its next filtered syscall.
+ * \param pid of the stopped \b tracee
+ * \param tracee_desc is its Syscall Flow state, NULL if it is not monitored
+ * \param signal to deliver, 0 if none
+*/
+void resume_tracee(pid_t pid, tracee_flow_descriptor* tracee_desc, int signal)
+{
+	int request = PTRACE_CONT;
+	PROFILE_START(phase_start);
+
+	if ((tracee_desc != NULL) && (tracee_desc->expecting_syscall_return))
+		request = PTRACE_SYSCALL;
+	if ((tracee_desc != NULL) && (tracee_desc->replay != NULL) && (tracee_desc->replay->parked))
+		return;		// End of its records with option -P, killed by release_parked_tracees()
 
+	if (ptrace (request, pid, 0, signal))
+		dprintf("Error continuing pid %d with signal %d\n", pid, signal);
+	PROFILE_END(PROFILE_RESUME, phase_start);
 }
 
-int trace_PID(pid_t pid)
+/*! Signal handler of TRACER_WAKEUP_SIGNAL. If the tracer thread is blocked in waitpid(), it jumps back to take its new tracees.
+ * \param signal received
+*/
+void tracer_wakeup_handler(int signal)
 {
+	if (tracer_can_jump)
+	{
+		tracer_can_jump = FALSE;
+		siglongjmp(tracer_jump, 1);
+	}
+}
 
-	int status;
-	int ret = DEFAULT_RETURN_VALUE;
-	pid_t a_pid, b_pid, main_pid;
-	tracee_flow_descriptor* tracee_desc; // To operate the list of Tracee Processes
+/*! Attaches the tracees handed off to this tracer thread, adding them to its table.
+ * They were detached with SIGSTOP by another tracer thread, so they are stopped or about to stop.
+ * \param self is the tracer thread
+*/
+void adopt_handoff_tracees(tracer_thread* self)
+{
+	tracee_flow_descriptor* tracee_desc;
 
-	int signal = 0;
+	pthread_mutex_lock(&(self->handoff_lock));
+	while (! is_empty(self->handoff_list))
+	{
+		goto_first(self->handoff_list);
+		tracee_desc = get_next(self->handoff_list);
+		delete_item(self->handoff_list, tracee_desc);
+		__sync_fetch_and_sub(&(self->handoff_pending), 1);
 
-	//Preparing the list of at least 1 process to trace
-	main_pid = pid;
-	child_tracees_list = new_list();
-	add_child_tracee(pid);
+		if (ptrace(PTRACE_SEIZE, tracee_desc->pid, 0, TRACEE_PTRACE_OPTIONS))
+		{
+			dprintf("Unable to seize PID %d in tracer %d\n", tracee_desc->pid, self->index);
+			free(tracee_desc);
+			continue;
+		}
+		hash_insert(child_tracees_table, tracee_desc->pid, (void*)tracee_desc);
+		vprintf(TRACER_ADOPTED_D_D, tracee_desc->pid, self->index);
+	}
+	pthread_mutex_unlock(&(self->handoff_lock));
+}
 
-	ptrace (PTRACE_ATTACH, pid, 0, 0);
-	waitpid (pid, 0, 0 ); 			//WCONTINUED | WEXITED | WSTOPPED does not work
+/*! Restarts a new child or thread of the \b tracee, once both its PTRACE_EVENT_FORK/CLONE and its initial SIGSTOP were received.
+ * With several tracer threads, the new \b tracee is given to the next tracer thread, round robin.
+ * The handoff detaches it with SIGSTOP, so that it remains stopped until the other tracer thread does PTRACE_SEIZE.
+ * \param tracee_desc is the state of the new \b tracee, stopped in its initial SIGSTOP
+*/
+void start_new_tracee(tracee_flow_descriptor* tracee_desc)
+{
+	tracer_thread* target;
+	pid_t pid = tracee_desc->pid;
 
-	ptrace (PTRACE_SETOPTIONS, pid, 0, PTRACE_O_TRACESYSGOOD  | PTRACE_O_EXITKILL  );
+	tracee_desc->start_state = TRACEE_STARTED;
+	if (tracer_threads_len <= 1)
+	{
+		resume_tracee(pid, tracee_desc, 0);
+		return;
+	}
 
-	if (childProcessFlag == TRUE)
-		ptrace (PTRACE_SETOPTIONS, pid, 0, PTRACE_O_TRACESYSGOOD  | PTRACE_O_EXITKILL | PTRACE_O_TRACEFORK | PTRACE_O_TRACECLONE);
+	target = &(tracer_threads[__sync_fetch_and_add(&next_tracer_thread, 1) % tracer_threads_len]);
+	if (target == current_tracer)
+	{
+		resume_tracee(pid, tracee_desc, 0);
+		return;
+	}
 
-	vprintf(STARTING_TRACE_D,pid);
-	ptrace (PTRACE_SYSCALL, pid, 0, 0);
+	hash_delete(child_tracees_table, pid);
+	if (ptrace(PTRACE_DETACH, pid, 0, SIGSTOP))
+	{
+		dprintf("Error detaching PID %d for handoff\n", pid);
+		free(tracee_desc);
+		return;
+	}
+	pthread_mutex_lock(&(target->handoff_lock));
+	append_item(target->handoff_list, tracee_desc);
+	__sync_fetch_and_add(&(target->handoff_pending), 1);
+	pthread_cond_signal(&(target->handoff_cond));
+	pthread_mutex_unlock(&(target->handoff_lock));
+	pthread_kill(target->thread, TRACER_WAKEUP_SIGNAL);
+}
+
+/*! Event loop of a tracer thread: waits for its own tracees and processes their stops.
+ * \param self is the tracer thread running the loop
+ * \return the exit value of the main \b tracee, if this thread traces it. Other tracer threads never return
+*/
+int tracer_loop(tracer_thread* self)
+{
+	int status;
+	int ret = DEFAULT_RETURN_VALUE;
+	pid_t a_pid, b_pid;
+	tracee_flow_descriptor* tracee_desc; // To operate the table of Tracee Processes
+	tracee_flow_descriptor* b_desc;		// State of a new child or thread
+	siginfo_t event;					// Event waited for, before taking it
+	int read_result;
+
+	int signal = 0;
 
 	while(1)
 	{
+		if (self->handoff_pending)
+			adopt_handoff_tracees(self);
+		PROFILE_CHECK_DUMP();
+
 		// Wait for the Child process to be stopped by PTRACE or by someone else
 		// __WALL to be interrupted by Threaded and Forked childs. WDCONTINUED is not recomened
+		// __WNOTHREAD to get only the tracees of this tracer thread
 		// The Tracer expects events from the tracee via waitpid(). It also returns when the children processes die or send events.
 
-  		if ( ( a_pid=waitpid (-1, &status,  __WALL)) == -1)
+		// The wait is done with WNOWAIT, so an event is never lost if the wakeup jumps out after it was received. It is then taken by waitpid()
+
+		if (sigsetjmp(tracer_jump, 1) != 0)
+			continue;		//Woken up by another tracer thread, with new tracees
+		tracer_can_jump = TRUE;
+		if (self->handoff_pending)
 		{
+			tracer_can_jump = FALSE;
+			continue;
+		}
+		PROFILE_START(wait_start);
+		a_pid = waitid (P_ALL, 0, &event, WEXITED | WSTOPPED | WNOWAIT | __WALL | __WNOTHREAD);
+		tracer_can_jump = FALSE;
+		if (a_pid == 0)
+			a_pid = waitpid (event.si_pid, &status,  __WALL | __WNOTHREAD);
+		PROFILE_END(PROFILE_WAIT, wait_start);
+
+  		if ( a_pid == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			if ((errno == ECHILD) && (self->index != 0))
+			{
+				// No tracees left for this tracer thread, sleeping until one is handed off
+				pthread_mutex_lock(&(self->handoff_lock));
+				while (self->handoff_pending == 0)
+					pthread_cond_wait(&(self->handoff_cond), &(self->handoff_lock));
+				pthread_mutex_unlock(&(self->handoff_lock));
+				continue;
+			}
 			eprintf(TRACEE_ERROR_D,a_pid);
 			break;
 			//Get out if error at waiting for PID.
@@ -246,11 +502,10 @@ int trace_PID(pid_t pid)
 		{
 			vprintf(TRACEE_EXIT_BY_SIGNAL_D,WTERMSIG(status));
 
-			if (a_pid != main_pid)
+			if (a_pid != main_tracee_pid)
 			{
 				dprintf("A Child/Thread did exit, detaching \n");
-				if ((childProcessFlag == TRUE) )
-					delete_child_tracee(a_pid);
+				delete_child_tracee(a_pid);
 				if (ptrace(PTRACE_DETACH, a_pid, 0, 0))
 					dprintf("Error detaching\n");
 			}
@@ -266,9 +521,11 @@ int trace_PID(pid_t pid)
 		{
 			// This is a notification to the Parent, just acknowledge the signal and let the child die in peace.
 
-			if (a_pid != main_pid)
+			if (a_pid != main_tracee_pid)
+			{
 				dprintf("Child %d exits normally\n",a_pid);
-
+				delete_child_tracee(a_pid);
+			}
 			else
 			{
 				vprintf(TRACEE_EXIT); ret = WEXITSTATUS(status); break;
@@ -277,47 +534,86 @@ int trace_PID(pid_t pid)
 		if  (WIFSTOPPED(status)) 	// PTRACE has several types of STOP situations, Signal-Delivery-Stops, Syscall-Stops, Group-stops, etc
 		{
 			signal = 0;  // As there is a signal that was captured, a signac can be delivered after for the tracee to continue. 0 means that the signal is just ignored
+			PROFILE_START(lookup_start);
+			tracee_desc = find_child_tracee(a_pid);
+			PROFILE_END(PROFILE_LOOKUP, lookup_start);
 
-			if (( status>>8 == (SIGTRAP | (PTRACE_EVENT_FORK<<8))) || (( status>>8 == (SIGTRAP | (PTRACE_EVENT_CLONE<<8))) ))
+			if (( status>>8 == (SIGTRAP | (PTRACE_EVENT_FORK<<8))) || ( status>>8 == (SIGTRAP | (PTRACE_EVENT_VFORK<<8))) || (( status>>8 == (SIGTRAP | (PTRACE_EVENT_CLONE<<8))) ))
 			// Textual from man ptrace, means that the Process has forked (requires PTRACE_O_TRACEFORK option)
 			// Textual from man ptrace, means that the Process has been cloned (requires PTRACE_O_TRACECLONE option)
 			{
-				if (childProcessFlag == TRUE)
+				if (ptrace(PTRACE_GETEVENTMSG, a_pid, 0, &b_pid) == 0)
 				{
-					if (ptrace(PTRACE_GETEVENTMSG, a_pid, 0, &b_pid) == 0)
-					{
+					// Forks and clones are always followed: they inherit the seccomp filter, and a filtered syscall without tracer fails with ENOSYS.
+					// If childProcessFlag is not set, they are not monitored and run their syscalls without custom libraries.
+					// The new tracee is restarted when both this event and its initial SIGSTOP are received, in any order
 
-						//Register this new child
-
-						add_child_tracee(b_pid);
-						ptrace (PTRACE_SYSCALL, b_pid, 0, 0);
+					if ( (status>>8) == (SIGTRAP | (PTRACE_EVENT_CLONE<<8))) {
+						if (childProcessFlag == TRUE) vprintf(TRACKING_CLONED_D,b_pid);
+					}
+					else {
+						if (childProcessFlag == TRUE) vprintf(TRACKING_FORKED_D,b_pid);
+					}
 
-						if ( (status>>8) == (SIGTRAP | (PTRACE_EVENT_FORK<<8))) {
-							vprintf(TRACKING_FORKED_D,b_pid);
-						}
-						else {
-							vprintf(TRACKING_CLONED_D,b_pid);
-						}
+					b_desc = find_child_tracee(b_pid);
+					if (b_desc == NULL)
+					{
+						b_desc = add_child_tracee(b_pid);
+						b_desc->start_state = TRACEE_WAITING_STOP;
 					}
-					else
-						dprintf("Unable to read the Registers from PID %d \n", a_pid);
-					//catch_exit_after_clone = 1;
-					// When Cloned/Forked, there will be a EXECV call that would cause the Parent to Receive a WIFEXITED call that does not mean an actual exit.
+					if ((b_desc->replay != NULL) && (tracee_desc != NULL))		// Numbered before it runs any syscall
+						replay_new_child(tracee_desc->replay, b_desc->replay, ((status>>8) == (SIGTRAP | (PTRACE_EVENT_CLONE<<8))));
+					memmap_new_child(a_pid, b_pid, ((status>>8) != (SIGTRAP | (PTRACE_EVENT_FORK<<8))));	// Threads and vfork() children share the memory
+					if (b_desc->start_state == TRACEE_WAITING_EVENT)
+						start_new_tracee(b_desc);
 				}
+				else
+					dprintf("Unable to read the Registers from PID %d \n", a_pid);
 			}
 
-			else if (WSTOPSIG(status) == (SIGTRAP | 0x80) )	//Tracee stopped by syscall
+			else if ( status>>8 == (SIGTRAP | (PTRACE_EVENT_EXEC<<8)) )	//A new program, instead of the SIGTRAP sent after execve() without PTRACE_O_TRACEEXEC
+			{
+				dprintf("Exec stop for pid %d\n",a_pid);
+				memmap_detach(a_pid);		// A new address space, its map is read at the next query
+			}
+			else if ( status>>8 == (SIGTRAP | (PTRACE_EVENT_SECCOMP<<8)) )	//Tracee stopped by the seccomp filter, at the entry of a custom syscall
+			{
+				dprintf("Seccomp stop for pid %d\n",a_pid);
+
+				if ((tracee_desc != NULL) && (tracee_desc->monitored))
+				{
+					dprintf("Found PID in the Tracee table \n");
+					PROFILE_START(read_start);
+					read_result = read_syscall_stop(tracee_desc->pid);
+					PROFILE_END(PROFILE_READ, read_start);
+					if (read_result == RETURN_OK)  //If there was no trouble getting the syscall
+						syscall_flow(stop_info.nr,tracee_desc);
+				}
+			}
+			else if (WSTOPSIG(status) == (SIGTRAP | 0x80) )	//Tracee stopped by syscall, only the exit is requested by resume_tracee()
 			{
 				dprintf("Syscall for pid %d\n",a_pid);
 				//print_child_tracee();
 
-				if ( (tracee_desc = find_child_tracee(a_pid)) != NULL)
+				if ((tracee_desc != NULL) && (tracee_desc->expecting_syscall_return))
 				{
-					dprintf("Found PID in the Tracee list \n");
-					if (ptrace(PTRACE_GETREGS, tracee_desc->pid, 0, &regs) == 0)  //If there was no trouble getting the Registers
-						syscall_flow(REG_AX_ORIG,tracee_desc);
+					dprintf("Found PID in the Tracee table \n");
+					PROFILE_START(read_start);
+					read_result = read_syscall_stop(tracee_desc->pid);
+					PROFILE_END(PROFILE_READ, read_start);
+					if (read_result == RETURN_OK)  //The exit does not tell the syscall number, it is the one of the entry
+						syscall_flow(tracee_desc->expected_syscall,tracee_desc);
 				}
 			}
+			else if ((WSTOPSIG(status) == SIGSTOP) && ((tracee_desc == NULL) || (tracee_desc->start_state != TRACEE_STARTED)))
+			{
+				// Initial SIGSTOP of a new child or thread, it is not resumed here
+				if (tracee_desc == NULL)
+					add_child_tracee(a_pid)->start_state = TRACEE_WAITING_EVENT;	//The PTRACE_EVENT of the parent comes later
+				else
+					start_new_tracee(tracee_desc);
+				continue;
+			}
 			else   			// Another reason has occurred for the Tracee to be stopped
 			{
 				dprintf(STOP_CAPTURED_H_D, WSTOPSIG(status), a_pid );
@@ -330,6 +626,8 @@ int trace_PID(pid_t pid)
 					dprintf("Group stop\n");
 				else if ( WSTOPSIG(status) == SIGTRAP )
 					dprintf("TRAP stop\n");
+				else if ((tracee_desc == NULL) || (! tracee_desc->monitored))
+					signal = WSTOPSIG(status);		// Followed only for the filter, it gets its signals as if it was not traced
 				else
 				{
 					dprintf("Other stop\n");
@@ -338,9 +636,8 @@ int trace_PID(pid_t pid)
 				}
 			}
 
-			//In any case, as the Process is stopped, it is restarted by a SYSCALL continue, passing the Signal
-			if (ptrace (PTRACE_SYSCALL, a_pid, 0, signal))
-				dprintf("Error continuing pid %d with signal %d\n", a_pid, signal);
+			//In any case, as the Process is stopped, it is restarted passing the Signal
+			resume_tracee(a_pid, tracee_desc, signal);
 
 		} //End If WIFSTOPPED
 
@@ -358,32 +655,115 @@ int trace_PID(pid_t pid)
 
 	} //End of While
 	return ret;
+}
+
+/*! Start routine of the additional tracer threads.
+ * \param arg is the tracer_thread structure of the thread
+ * \return never returns, the thread ends with the Sandbox
+*/
+void* tracer_thread_start(void* arg)
+{
+	current_tracer = (tracer_thread*)arg;
+	child_tracees_table = new_hash_table(TRACEES_TABLE_INITIAL_SIZE);
+	tracer_loop(current_tracer);
+	return NULL;
+}
+
+int trace_PID(pid_t pid)
+{
+	// The Tracee did PTRACE_TRACEME and stopped itself, before installing its seccomp filter
+	waitpid (pid, 0, 0 ); 			//WCONTINUED | WEXITED | WSTOPPED does not work
+
+	return trace_stopped_PID(pid);
+}
+
+int trace_stopped_PID(pid_t pid)
+{
+	int ret;
+	int i;
+	struct sigaction wakeup_action;
+
+	//Preparing the table of at least 1 process to trace
+	main_tracee_pid = pid;
+	child_tracees_table = new_hash_table(TRACEES_TABLE_INITIAL_SIZE);
+	add_child_tracee(pid)->monitored = TRUE;
+
+	ptrace (PTRACE_SETOPTIONS, pid, 0, TRACEE_PTRACE_OPTIONS);
+	PROFILE_INIT();
+
+	// The calling thread is the tracer thread 0, the one tracing the main tracee
+	tracer_threads_len = tracerThreadsCount;
+	tracer_threads = (tracer_thread*)calloc(tracer_threads_len, sizeof(tracer_thread));
+	for(i=0;i<tracer_threads_len;i++)
+	{
+		tracer_threads[i].index = i;
+		tracer_threads[i].handoff_list = new_list();
+		pthread_mutex_init(&(tracer_threads[i].handoff_lock), NULL);
+		pthread_cond_init(&(tracer_threads[i].handoff_cond), NULL);
+	}
+	tracer_threads[0].thread = pthread_self();
+	current_tracer = &(tracer_threads[0]);
+
+	if (tracer_threads_len > 1)
+	{
+		// No SA_RESTART, so that the signal interrupts waitpid()
+		memset(&wakeup_action, 0, sizeof(wakeup_action));
+		wakeup_action.sa_handler = tracer_wakeup_handler;
+		sigaction(TRACER_WAKEUP_SIGNAL, &wakeup_action, NULL);
+
+		for(i=1;i<tracer_threads_len;i++)
+			pthread_create(&(tracer_threads[i].thread), NULL, tracer_thread_start, &(tracer_threads[i]));
+		vprintf(TRACER_THREADS_D, tracer_threads_len);
+	}
+
+	vprintf(STARTING_TRACE_D,pid);
+	ptrace (PTRACE_CONT, pid, 0, 0);
+
+	ret = tracer_loop(current_tracer);
+
+	// The other tracer threads may still run custom syscalls for the children, they are kept out of the libraries from now on
+	if ((tracer_threads_len > 1) || (userNotifFlag))
+		pthread_mutex_lock(&library_lock);
+	return ret;
 } //End of tracePID
 
+/*! Starts the kernel time of option -c, once the entry stop is handled. A syscall skipped by the custom libraries has no exit stop and no kernel time
+ \param tracee_desc The tracee at the entry of a syscall
+*/
+void stats_entry_handled(tracee_flow_descriptor* tracee_desc)
+{
+	if (tracee_desc->expecting_syscall_return)
+		tracee_desc->entry_ns = stats_now();
+}
 
 void syscall_flow( int syscall_number, tracee_flow_descriptor* tracee_desc)
 {
-	if ((syscall_number < 0) || (syscall_number > MAX_SYSCALLS))
+	if ((syscall_number < 0) || (syscall_number >= MAX_SYSCALL_NUMBER))
 		return ;
 		//Invalid Syscall number, not doing anything
 
+	if ((! (tracee_desc->expecting_syscall_return)) && (get_dispatch_entry(syscall_number) == NULL) && (! statsFlag) && (tracee_desc->replay == NULL))
+		return ;
+		//No library implements this syscall, there is no need to wait for its return. With -c its kernel time is measured, with -R/-P it is recorded or replayed
+
 	if (! (tracee_desc->expecting_syscall_return))
 	{
 		//New Syscall
 		tracee_desc->expecting_syscall_return=TRUE;
 		tracee_desc->expected_syscall = syscall_number;
-		tracee_desc->expecting_dummy=FALSE;
 
 		dprintf("In Syscall for syscall %d for pid %d\n",syscall_number,tracee_desc->pid);
 
 		processInSyscall(tracee_desc);
+		if (statsFlag)
+			stats_entry_handled(tracee_desc);
 
 
 	} //End if New Syscall
 	else
 	{
 		// Return from previous syscall
-		if ((tracee_desc->expected_syscall == syscall_number) || (tracee_desc->expecting_dummy))
+		if (tracee_desc->expected_syscall == syscall_number)
 		{
 			//If it is the syscall we were waiting
 			tracee_desc->expecting_syscall_return=FALSE;
@@ -397,153 +777,211 @@ void syscall_flow( int syscall_number, tracee_flow_descriptor* tracee_desc)
 			//We were not expecting this, treat as a a new syscall
 			tracee_desc->expecting_syscall_return=TRUE;
 			tracee_desc->expected_syscall = syscall_number;
-			tracee_desc->expecting_dummy=FALSE;
-
+	
 			dprintf("In Syscall for syscall %d for pid %d\n",syscall_number,tracee_desc->pid);
 
 			processInSyscall(tracee_desc);
+			if (statsFlag)
+				stats_entry_handled(tracee_desc);
 		}
 	}
 }
 
-void processInSyscall(tracee_flow_descriptor* tracee_desc)
+/*! Fills the context passed to the chains from the Syscall Flow state of a PID, at the entry of its syscall
+ * \param context is the context to fill
+ * \param tracee_desc contains the information about the Syscall Flow state for this PID
+*/
+void init_syscall_context(syscall_context* context, tracee_flow_descriptor* tracee_desc)
 {
+	context->tid = tracee_desc->pid;
+	context->tgid = 0;		// Read by dynlib.c when a context handler needs it
+	context->syscall_number = tracee_desc->expected_syscall;
+	context->args = tracee_desc->args;
+	context->return_value = tracee_desc->return_value;
+	context->kernel_return_value = tracee_desc->kernel_return_value;
+	context->kernel_executed = FALSE;
+	context->state = NULL;
+}
 
-	cpu_reg custom_result;
-	int no_kernel =FALSE;
-	custom_library_descriptor* custom_library;
-	custom_syscall_descriptor* custom_syscall;
-	custom_result = DEFAULT_RETURN_VALUE;
-
-	//dprintf("ENTERING\n");
-
-	//Fill the structure that the Library can read/write
-	tracee.trace_PID = tracee_desc->pid;
-	tracee.return_value = tracee_desc->return_value;
-	tracee.kernel_return_value = tracee_desc->kernel_return_value;
-
-	// Browse all the custom libraries
-
-	goto_first(custom_libs_list);
-	while(has_next(custom_libs_list))
-
+/*! Runs the AFTER chain of a custom syscall and writes the final return value in the registers of the \b tracee.
+ * The register is only written if the value differs from what the \b tracee would receive anyway.
+ * \pre library_lock is held if the chain has shared_state
+ * \param tracee_desc contains the information about the Syscall Flow state for this PID
+ * \param entry is the dispatch entry of the syscall
+ * \param context is the syscall, its kernel_return_value/kernel_executed tell whether the kernel was executed
+ * \param current_ax is the value REG_AX has in the \b tracee now
+*/
+void complete_custom_syscall(tracee_flow_descriptor* tracee_desc, syscall_dispatch_entry* entry, syscall_context* context, long int current_ax)
+{
+	unsigned long long chain_start;
+
+	PROFILE_START(phase_start);
+	chain_start = (statsFlag ? stats_now() : 0);
+	chain_fired_libraries = tracee_desc->libraries;		// Another tracee may have run a BEFORE chain since this one
+	execute_after_chain(entry, context);
+	PROFILE_END(PROFILE_CHAIN, phase_start);
+	if ((statsFlag) && (entry->after_chain_len > 0))
+		stats_after_time(tracee_desc->expected_syscall, stats_now() - chain_start);
+	if (statsFlag)
+		stats_syscall_result(tracee_desc->stats, tracee_desc->expected_syscall, context->return_value);
+	if (eventLogFile)
+		record_event(tracee_desc->pid, tracee_desc->expected_syscall, tracee_desc->args, context->kernel_return_value, context->return_value,
+			chain_fired_libraries, EVENT_CUSTOM | (context->kernel_executed ? EVENT_KERNEL_EXECUTED : 0));
+
+	vprintf(CUSTOM_SYSCALL_S_RET_D,entry->before_chain[0].syscall->name, (int) context->return_value  );
+
+	// At the exit, REG_AX is the result. At the entry, the kernel skipping the syscall leaves REG_AX as result
+	if (context->return_value != current_ax)
 	{
+		PROFILE_START(write_start);
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_AX_OFFSET, context->return_value);	//Write the result value for the tracee to receive
+		PROFILE_END(PROFILE_WRITE, write_start);
+	}
+	tracee_desc->is_custom_syscall = FALSE;
+	tracee_desc->expecting_syscall_return = FALSE;
 
-		custom_library = get_next(custom_libs_list);
-
-		custom_syscall = get_valid_custom_syscall(custom_library,tracee_desc->expected_syscall);
-
-		if (custom_syscall != NULL)
-		{
-			//If custom syscall
-			tracee_desc->is_custom_syscall=TRUE;
-			vprintf(CUSTOM_SYSCALL_CATCHED_S_FROM_S,custom_syscall->name,custom_library->name );
-
-			if ((custom_syscall->custom_syscall_before) != NULL)
-			{
-				vprintf(CUSTOM_SYSCALL_CALLED_BEFORE );
-				custom_result = (custom_syscall->custom_syscall_before)(SYSCALLS_ARGS_REGS);
-
-				// Executing the Custom Syscall and keeping the result value
-
-				if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && (custom_result <0) )
-					break; //Quit of error option
-
-				if (! ((custom_syscall->flags) & FLAG_KEEP_PREVIOUS_RETURN) )
-					tracee.return_value = custom_result; // If not said the opossite, drag the return code along
-
-			} // End If execute before
-
-			if (((custom_syscall->flags) & FLAG_DONT_CALL_KERNEL))
-			{
-				//If kernel syscall is not to be called
-				vprintf(CUSTOM_SYSCALL_NOKERNEL );
-				no_kernel = TRUE;
-			}
-			vprintf(LF_CR);
-
-		}
-	} //end For each lib in custom_libs
-	if (no_kernel){
-		REG_AX_ORIG = (cpu_reg) DUMMY_SYSCALL; 			//REG_AX is not used, as determined from experimentation
-		ptrace (PTRACE_SETREGS, tracee_desc->pid, 0, &regs);	//Write the new syscall number for the kernel
-		tracee_desc->expecting_dummy = TRUE;					//Tell that the kernel will reply for the dummy syscall
-		}
 	//Storing changes
-	tracee_desc->return_value = tracee.return_value;
+	tracee_desc->return_value = context->return_value;
+	tracee_desc->kernel_return_value = context->kernel_return_value;
+	tracee_desc->kernel_executed = context->kernel_executed;
 }
 
-void processOutSyscall(tracee_flow_descriptor* tracee_desc)
+/*! Records or replays a syscall without custom library, at its entry (options -R and -P).
+ * A replayed syscall is skipped by the kernel like with FLAG_DONT_CALL_KERNEL, one creating a socket is turned into a placeholder socket
+ * \param tracee_desc contains the information about the Syscall Flow state for this PID
+*/
+void replay_flow(tracee_flow_descriptor* tracee_desc)
 {
+	long int result = 0;
 
-	custom_library_descriptor* custom_library;
-	custom_syscall_descriptor* custom_syscall;
-	cpu_reg custom_result;
-	char * valid_syscall_name;
-
-	//Needed to store the valid name to print as, perhaps, we roll all the libraries and lost track of the only descriptor that had the name.
-
-	if (tracee_desc->is_custom_syscall)
+	switch (replay_syscall_entry(tracee_desc->replay, tracee_desc->pid, tracee_desc->expected_syscall, tracee_desc->args, &result))
 	{
-		//If custom syscall, fill the structure that the Library can read/write
-		tracee.trace_PID = tracee_desc->pid;
-		tracee.return_value = tracee_desc->return_value;
-		tracee.kernel_return_value = tracee_desc->kernel_return_value;
-
-		if (tracee_desc->expecting_dummy)
-		{
-			tracee.kernel_return_value = DEFAULT_RETURN_VALUE;
-			tracee.kernel_executed = FALSE;
-		}
-		else
-		{
-			tracee.kernel_return_value = REG_AX;
-			tracee.kernel_executed = TRUE;
-			tracee.return_value = REG_AX;
-		}
-
-		goto_last(custom_libs_list);
-		while(has_next(custom_libs_list))
-
-		{
-
-			custom_library = get_previous(custom_libs_list);
-			//dprintf("Lib number %d\n",i);
-			//custom_library = custom_libs[i];
-			custom_syscall = get_valid_custom_syscall(custom_library,tracee_desc->expected_syscall);
-
+	case REPLAY_RECORD:
+		tracee_desc->expecting_syscall_return = TRUE;
+		return;
+	case REPLAY_EMULATED:
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_AX_ORIG_OFFSET, (long int) SKIP_SYSCALL);
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_AX_OFFSET, result);
+		tracee_desc->expecting_syscall_return = FALSE;
+		return;
+	case REPLAY_RESERVE_FD:
+		// The kernel returns the lowest free descriptor, the one of the recording if the tracee opened the same ones. Checked at the exit
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_AX_ORIG_OFFSET, (long int) SYS_socket);
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_ARG0_OFFSET, (long int) AF_UNIX);
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_ARG1_OFFSET, (long int) SOCK_DGRAM);
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_ARG2_OFFSET, 0L);
+		tracee_desc->expecting_syscall_return = TRUE;
+		return;
+	case REPLAY_END:
+		release_parked_tracees();		// Left stopped, unless it was the last one running
+		break;
+	}
+	tracee_desc->expecting_syscall_return = statsFlag;
+}
 
-			if (  custom_syscall != NULL )
-			{
-				//If custom syscall found in this library
+void processInSyscall(tracee_flow_descriptor* tracee_desc)
+{
+	unsigned long long chain_start;
+	int no_kernel;
+	int i;
+	syscall_dispatch_entry* entry;
+	syscall_context context;
+
+	if (statsFlag)
+		stats_syscall_entry(tracee_desc->stats, tracee_desc->expected_syscall);
+
+	for(i=0;i<6;i++)
+		tracee_desc->args[i] = stop_info.args[i];		//Kept for the AFTER functions and the log, the exit stop does not report them
+	tracee_desc->libraries = 0;
+
+	PROFILE_START(lookup_start);
+	entry = get_dispatch_entry(tracee_desc->expected_syscall);
+	PROFILE_END(PROFILE_LOOKUP, lookup_start);
+	if (entry == NULL)
+	{
+		if (tracee_desc->replay != NULL)
+			replay_flow(tracee_desc);
+		return;
+	}
 
-				valid_syscall_name = custom_syscall->name;
-				if ((custom_syscall->custom_syscall_after) != NULL)
-				{
-					vprintf(CUSTOM_SYSCALL_CALLED_AFTER );
-								//dprintf("Calling Pointer %ld",(long) (custom_syscall->custom_syscall_after) );
-					custom_result = (custom_syscall->custom_syscall_after)(SYSCALLS_ARGS_REGS);
+	tracee_desc->is_custom_syscall=TRUE;
 
-					//Executing the Custom Syscall and keeping the result value
-					if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) && (custom_result <0) )
-						break;//Quit of error option
-					if (! ((custom_syscall->flags) & FLAG_KEEP_PREVIOUS_RETURN) )
-						tracee.return_value = custom_result;
+	//Fill the context that the Library can read
+	init_syscall_context(&context, tracee_desc);
+	if (entry->shared_state)
+		pthread_mutex_lock(&library_lock);
 
-				}
-			}
-		}
+	PROFILE_START(chain_phase_start);
+	chain_start = (statsFlag ? stats_now() : 0);
+	no_kernel = execute_before_chain(entry, &context);
+	tracee_desc->libraries = chain_fired_libraries;
+	PROFILE_END(PROFILE_CHAIN, chain_phase_start);
+	if (statsFlag)
+		stats_before_time(tracee_desc->expected_syscall, stats_now() - chain_start);
 
-		vprintf(CUSTOM_SYSCALL_S_RET_D,valid_syscall_name, (int) tracee.return_value  );
+	if (no_kernel)
+	{
+		// The syscall is fully emulated: the kernel skips it and the AFTER chain runs now, in this single stop
+		PROFILE_START(write_start);
+		ptrace(PTRACE_POKEUSER, tracee_desc->pid, REG_AX_ORIG_OFFSET, (long int) SKIP_SYSCALL);
+		PROFILE_END(PROFILE_WRITE, write_start);
+		context.kernel_return_value = DEFAULT_RETURN_VALUE;
+		context.kernel_executed = FALSE;
+		complete_custom_syscall(tracee_desc, entry, &context, ENTRY_REG_AX);
+		if (entry->shared_state)
+			pthread_mutex_unlock(&library_lock);
+		return;
+	}
+	//Storing changes
+	tracee_desc->return_value = context.return_value;
+	if (entry->shared_state)
+		pthread_mutex_unlock(&library_lock);
 
-		REG_AX = tracee.return_value;   // REG_AX_ORIG still contains the old Syscall number, so RAX is where the Result is. Confirmed by experimentation
-		ptrace(PTRACE_SETREGS, tracee.trace_PID, 0, &regs);	//Write the result value for the tracee to receive
+	if (! entry->needs_exit_stop)
+	{
+		// Nothing to do after the kernel, the tracee is resumed without syscall-exit-stop, unless -c measures the kernel time
+		tracee_desc->expecting_syscall_return = statsFlag;
 		tracee_desc->is_custom_syscall = FALSE;
+		if ((eventLogFile) && (! statsFlag))		// With -c, the exit stop records it
+			record_event(tracee_desc->pid, tracee_desc->expected_syscall, tracee_desc->args, DEFAULT_RETURN_VALUE, tracee_desc->return_value,
+				tracee_desc->libraries, EVENT_CUSTOM | EVENT_KERNEL_EXECUTED | EVENT_NO_RETURN);
+	}
+}
 
-		//Storing changes
-		tracee_desc->return_value = tracee.return_value;
-		tracee_desc->kernel_return_value = tracee.kernel_return_value;
-		tracee_desc->kernel_executed = tracee.kernel_executed;
+void processOutSyscall(tracee_flow_descriptor* tracee_desc)
+{
+	syscall_dispatch_entry* entry;
+	syscall_context context;
+
+	if ((tracee_desc->replay != NULL) && (tracee_desc->replay->pending))
+		record_syscall_exit(tracee_desc->replay, tracee_desc->pid, tracee_desc->expected_syscall, tracee_desc->args, stop_info.rval);
+	if ((tracee_desc->replay != NULL) && (tracee_desc->replay->reserved_fd >= 0)
+		&& (replay_reserved_fd_exit(tracee_desc->replay, tracee_desc->pid, stop_info.rval) != RETURN_OK))
+		kill_replayed_tracees();
+	if (statsFlag)
+	{
+		stats_kernel_time(tracee_desc->stats, tracee_desc->expected_syscall, stats_now() - tracee_desc->entry_ns);
+		if (! tracee_desc->is_custom_syscall)
+			stats_syscall_result(tracee_desc->stats, tracee_desc->expected_syscall, stop_info.rval);
+		// Syscalls stopped only to be counted, or custom ones without AFTER functions
+		if ((eventLogFile) && (! tracee_desc->is_custom_syscall))
+			record_event(tracee_desc->pid, tracee_desc->expected_syscall, tracee_desc->args, stop_info.rval, stop_info.rval, tracee_desc->libraries,
+				EVENT_KERNEL_EXECUTED | ((get_dispatch_entry(tracee_desc->expected_syscall) != NULL) ? EVENT_CUSTOM : 0));
+	}
+	if (tracee_desc->is_custom_syscall)
+	{
+		entry = get_dispatch_entry(tracee_desc->expected_syscall);
+		//If custom syscall, fill the context that the Library can read
+		init_syscall_context(&context, tracee_desc);
+		context.kernel_return_value = stop_info.rval;
+		context.kernel_executed = TRUE;
+		context.return_value = stop_info.rval;
+
+		if (entry->shared_state)
+			pthread_mutex_lock(&library_lock);
+		complete_custom_syscall(tracee_desc, entry, &context, stop_info.rval);
+		if (entry->shared_state)
+			pthread_mutex_unlock(&library_lock);
 	}
 
 
@@ -551,91 +989,84 @@ void processOutSyscall(tracee_flow_descriptor* tracee_desc)
 
 void print_execution_plan(void)
 {
-	custom_library_descriptor* custom_library;
+	syscall_dispatch_entry* entry;
 	custom_syscall_descriptor* custom_syscall;
-	int i,k;
+	int i,j,k,n;
 	char syscall_number = -1;
 	char no_kernel = FALSE;
 
-	for(i=0;i<MAX_SYSCALLS;i++)
+	for(i=0;i<dispatch_table_len;i++)
 	{
-		syscall_number = -1;
+		entry = get_dispatch_entry(i);
+		if (entry == NULL)
+			continue;
+
 		no_kernel = FALSE;
+		printf(CUSTOM_SYSCALL_CATCHED_S_D,syscall_name(i),i);
+		syscall_number = 1;
 
 		// Checking the Syscalls on the BEFORE execution
 
-		goto_first(custom_libs_list);
-		while(has_next(custom_libs_list))
-
+		for(j=0;j<entry->before_chain_len;j++)
 		{
-			custom_library = get_next(custom_libs_list);
-			//custom_library = custom_libs[j];
-			custom_syscall = get_valid_custom_syscall(custom_library,i);
-			if (custom_syscall != NULL)
-			{
-				if(syscall_number == -1)
-				{
-					printf(CUSTOM_SYSCALL_CATCHED_D,i);
-					syscall_number = 1;
-				}
+			custom_syscall = entry->before_chain[j].syscall;
 
-				for(k=0;k<syscall_number;k++)printf(SPACE); //Tabs needed to make the tree like a tree
-				syscall_number++;
+			for(k=0;k<syscall_number;k++)printf(SPACE); //Tabs needed to make the tree like a tree
+			syscall_number++;
 
-				printf(CUSTOM_LIB_CALLED_S_S,custom_syscall->name ,custom_library->name );
+			printf(CUSTOM_LIB_CALLED_S_S,custom_syscall->name ,entry->before_chain[j].library->name );
 
-				if ((custom_syscall->custom_syscall_before) != NULL)
-					{
-						printf(CUSTOM_SYSCALL_CALLING_BEFORE );
-						if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) )
-						printf(CUSTOM_SYSCALL_QUIT_ON_ERROR);
-						if ( ((custom_syscall->flags) & FLAG_KEEP_PREVIOUS_RETURN) )
-						printf(CUSTOM_SYSCALL_KEEP_RESULT);
-					}
-				if (((custom_syscall->flags) & FLAG_DONT_CALL_KERNEL))
+			if ((custom_syscall->custom_syscall_before) != NULL)
 				{
-					printf(CUSTOM_SYSCALL_NOKERNEL );
-					no_kernel = TRUE;
+					printf(CUSTOM_SYSCALL_CALLING_BEFORE );
+					if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) )
+					printf(CUSTOM_SYSCALL_QUIT_ON_ERROR);
+					if ( ((custom_syscall->flags) & FLAG_KEEP_PREVIOUS_RETURN) )
+					printf(CUSTOM_SYSCALL_KEEP_RESULT);
+					if ( ((custom_syscall->flags) & FLAG_OBSERVE_ONLY) )
+					printf(CUSTOM_SYSCALL_OBSERVE_ONLY);
 				}
-				printf(LF_CR);
+			if (((custom_syscall->flags) & FLAG_DONT_CALL_KERNEL))
+			{
+				printf(CUSTOM_SYSCALL_NOKERNEL );
+				no_kernel = TRUE;
 			}
-
+			printf(LF_CR);
 		}
 
 		// Checking the Syscalls on the AFTER execution of KERNEL
 
-		if((syscall_number != -1) )
+		for(k=0;k<syscall_number;k++)printf(SPACE); //Tabs
+		if (no_kernel)
+				printf(NO_KERNEL_SYSCALL);
+		else
+				printf(KERNEL_SYSCALL);
+		if (filter_answers(entry))
 		{
 			for(k=0;k<syscall_number;k++)printf(SPACE); //Tabs
-			if (no_kernel)
-					printf(NO_KERNEL_SYSCALL);
-			else
-					printf(KERNEL_SYSCALL);
+			printf(FILTER_SYSCALL_LD,entry->constant_value);
 		}
-		goto_last(custom_libs_list);
-		while(has_next(custom_libs_list))
 
-		{
-			custom_library = get_previous(custom_libs_list);
-			//custom_library = custom_libs[j];
-			custom_syscall = get_valid_custom_syscall(custom_library,i);
-			if (custom_syscall != NULL)
-			{
-
-				syscall_number--;
-				if ((custom_syscall->custom_syscall_after) != NULL)
-					{
-						for(k=0;k<syscall_number;k++)printf(SPACE); //Tabs
-						printf(CUSTOM_SYSCALL_CALLING_AFTER );
-						if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) )
-						printf(CUSTOM_SYSCALL_QUIT_ON_ERROR);
-						if ( ((custom_syscall->flags) & FLAG_KEEP_PREVIOUS_RETURN) )
-						printf(CUSTOM_SYSCALL_KEEP_RESULT);
-						printf(LF_CR);
-					}
-
-			}
+		// The AFTER chain only has the custom syscalls with an AFTER function, the depth comes from the BEFORE chain
 
+		k = 0;
+		for(j=entry->before_chain_len-1;j>=0;j--)
+		{
+			custom_syscall = entry->before_chain[j].syscall;
+			syscall_number--;
+			if ((k < entry->after_chain_len) && (entry->after_chain[k].syscall == custom_syscall))
+				{
+					k++;
+					for(n=0;n<syscall_number;n++)printf(SPACE); //Tabs
+					printf(CUSTOM_SYSCALL_CALLING_AFTER );
+					if (((custom_syscall->flags) & FLAG_QUIT_IF_RETURN_NEGATIVE) )
+					printf(CUSTOM_SYSCALL_QUIT_ON_ERROR);
+					if ( ((custom_syscall->flags) & FLAG_KEEP_PREVIOUS_RETURN) )
+					printf(CUSTOM_SYSCALL_KEEP_RESULT);
+					if ( ((custom_syscall->flags) & FLAG_OBSERVE_ONLY) )
+					printf(CUSTOM_SYSCALL_OBSERVE_ONLY);
+					printf(LF_CR);
+				}
 		}
 	}
 
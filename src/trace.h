@@ -32,23 +32,58 @@ SOFTWARE.
  * */
  
  
+#include <pthread.h>
+#include "list.h"
+#include "stats.h"
+#include "replay.h"
+
 /** When the custom libraries are called for a Syscall, this is the default Return value used through the chain of custom functions. This is related to the option  */ 
 #define DEFAULT_RETURN_VALUE	-1 
+
+/** Start states of a tracee. A new child or thread is restarted once both the PTRACE_EVENT of its parent and its initial SIGSTOP arrived */
+#define TRACEE_STARTED			0
+#define TRACEE_WAITING_STOP		1	//!< The PTRACE_EVENT was received, not yet the initial SIGSTOP
+#define TRACEE_WAITING_EVENT	2	//!< The initial SIGSTOP was received, not yet the PTRACE_EVENT
  
  
  /** Structure for the Sandbox Custom Syscall Processing state, for each monitored PID */
 typedef struct {
 	pid_t pid;						
+	long int args[6];				//!< Arguments of the syscall being processed, as read at its entry
 	long int return_value ;			//!< The return value to be delivered to the \b tracee. This is changed by the returns of the custom syscalls
 	long int kernel_return_value;	//!< The return value delivered by the kernel, it it was executed. DEFAULT_RETURN_VALUE if not 
 	int expected_syscall;			//!< Last Syscall number for this PID that was captured. This is used to look for libraries implementing the AFTER KERNEL of this syscall.
 	char expecting_syscall_return;  //!< True if the kernel return of the syscall is expected. Makes the difference between the BEFORE and AFTER kernel.
-	char expecting_dummy ;			//!< True is a dummy syscall was triggered to implement the FLAG_DONT_CALL_KERNEL option
 	char is_custom_syscall;			//!< True if there is a custom library that implements the syscall just interrupted
 	char kernel_executed;			//!< True if the Kernel was executed in the process of the Syscall tracing
+	char monitored;					//!< True if the custom libraries are run for this PID. Children are only monitored with option -p
+	char start_state;				//!< TRACEE_STARTED, or the step a new child or thread is waiting for
+	tid_stats* stats;				//!< Counters of this TID with option -c, NULL otherwise
+	replay_tracee* replay;			//!< Record and replay state with options -R and -P, NULL otherwise
+	unsigned int libraries;			//!< Libraries whose BEFORE functions ran for the syscall being processed, for option -o
+	unsigned long long entry_ns;	//!< Time the entry stop was handled, for the kernel time of option -c
 }
 tracee_flow_descriptor;
 
+/** Structure of a tracer thread. Each one waits for its own tracees, as ptrace requires */
+typedef struct {
+	pthread_t thread;				//!< Thread running tracer_loop()
+	int index;						//!< Position in the array of tracer threads, 0 traces the main tracee
+	list* handoff_list;				//!< tracee_flow_descriptor of the tracees detached by other tracer threads for this one
+	volatile int handoff_pending;	//!< Amount of elements in handoff_list, read without the lock
+	pthread_mutex_t handoff_lock;	//!< Protects handoff_list
+	pthread_cond_t handoff_cond;	//!< Signaled when a tracee is added to handoff_list
+}
+tracer_thread;
+
+/** Syscall values read from a stopped \b tracee. \see read_syscall_stop() */
+typedef struct {
+	int nr;							//!< Syscall number, read at the entry
+	long int args[6];				//!< Syscall arguments, read at the entry
+	long int rval;					//!< Kernel return value, read at the exit
+}
+syscall_stop_info;
+
 /*! Starts tracking the syscalls of the given PID. Returns when the PID dies.
  * 
  * This function performs the syscall tracing, polling the libraries when a syscall is captured for any PID being traced.
@@ -67,11 +102,22 @@ tracee_flow_descriptor;
  * 
  * If the main \b tracee creates children processes or threads, they are also monitored in the same way as the main process.
  * 
+ * With tracerThreadsCount > 1, the new children and threads are spread among that amount of tracer threads, each one with its own event loop.
+ * 
  * \param pid The PID of the child to be monitored
  * \return the exit value of the Tracee, or -1 if terminated by signals
 */ 
 int trace_PID(pid_t pid);
 
+/*! Same as trace_PID(), for a \b tracee that is already in a ptrace stop.
+ * \param pid The PID of the child to be monitored, stopped
+ * \return the exit value of the Tracee, or -1 if terminated by signals
+*/
+int trace_stopped_PID(pid_t pid);
+
+/** Serializes the execution of the custom libraries, among the tracer threads and the supervisor thread */
+extern pthread_mutex_t library_lock;
+
 
 /*! Performs an analysis of the loaded libraries and prints to STDOUT the execution TREE, what functions will be executed,
  * from which library and in which order.
@@ -93,19 +139,20 @@ int trace_PID(pid_t pid);
 void print_execution_plan(void);
 
 
-/** This function add a pid to the list of monitored pids.
- * \pre pid must be unique in the list.
+/** This function add a pid to the table of monitored pids, of the running tracer thread.
+ * \pre pid must be unique in the table.
  * \param pid to be added.
+ * \return the new tracee_flow_descriptor, monitored only if childProcessFlag is set
  * */
-void add_child_tracee(pid_t pid);
+tracee_flow_descriptor* add_child_tracee(pid_t pid);
 
 /** This function returns a pointer to the tracee_flow_descriptor given the pid of the process.
  * \param pid 
- * \return the pointer to the appropriate structure tracee_flow_descriptor, or NULL if the pid is not found in the list.
+ * \return the pointer to the appropriate structure tracee_flow_descriptor, or NULL if the pid is not found in the table.
  * */
 tracee_flow_descriptor* find_child_tracee(pid_t pid);
 
-/** Prints the list of Tracee processes being traced
+/** Prints the table of Tracee processes being traced
  * \remark Use for debugging
  * */
 void print_child_tracee();
@@ -123,15 +170,14 @@ void processOutSyscall(tracee_flow_descriptor* tracee_desc);
 void processInSyscall(tracee_flow_descriptor* tracee_desc);
 
 /** This function coordinates the Ptrace interrcuptions into the appropriate syscall calling flow.
- * This function calls either processInSyscall() or processInSyscall() acording to the state of the variables expecting_syscall_return, expected_syscall and expecting_dummy
+ * This function calls either processInSyscall() or processInSyscall() acording to the state of the variables expecting_syscall_return and expected_syscall
  * \param syscall_number is the received syscall at interruption.
  * \param tracee_desc contains the information about the Syscall Flow state for this PID 
  * */
 void syscall_flow( int syscall_number, tracee_flow_descriptor* tracee_desc);
 
-/** This function deletes a pid from the array of monitored pids.
+/** This function deletes a pid from the table of monitored pids, freeing its tracee_flow_descriptor.
  * 
- * \pre pid must be unique in the list. Otherwise, only the first match is deleted.
  * \param pid to be removed
  * */
 void delete_child_tracee(pid_t pid);